@@ -0,0 +1,107 @@
+/**
+ * @file AsyncScanner.hpp
+ * @brief Declaration of the core::AsyncScanner class that scans a directory on a background thread.
+ */
+
+#ifndef ASYNCSCANNER_HPP
+    #define ASYNCSCANNER_HPP
+
+    #include "core/DirectoryScanner.hpp"
+    #include "core/DirectoryWatcher.hpp"
+    #include "core/EntryType.hpp"
+    #include "core/EventNotifier.hpp"
+    #include "core/SpscQueue.hpp"
+
+    #include <atomic>
+    #include <cstddef>
+    #include <memory>
+    #include <string>
+    #include <string_view>
+    #include <thread>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @struct ScanBatch
+     * @brief A run of scanned entries: NUL-terminated names packed back to back, and what the
+     * scan alone tells about them. An inspected batch has no names: it carries the full details
+     * of the entries found at scan positions first, first + 1, and so on.
+     */
+    struct ScanBatch {
+        std::vector<char> names;
+        std::vector<EntryDetails> details;
+        bool inspected = false;
+        std::size_t first = 0;
+
+        template <typename Fn>
+        void forEach(Fn&& onEntry) const
+        {
+            const char* name = names.data();
+
+            for (const EntryDetails& entry : details) {
+                std::string_view view(name);
+                onEntry(view, entry);
+                name += view.size() + 1;
+            }
+        }
+    };
+
+    /**
+     * @class AsyncScanner
+     * @brief Runs a DirectoryScanner on its own thread and streams the result in batches.
+     *
+     * Entries stream out first with what d_type and the name tell. The thread then inspects every
+     * entry (one statx, two for a symlink) and streams that too, so metadata and display
+     * attributes are filled in without holding back the listing, and never on the caller's thread.
+     * The first batch is kept small so a screenful can be shown right away; later ones are
+     * larger to amortize the hand-off. Batches travel through a lock-free SPSC queue and are
+     * collected with poll(). Destroying the scanner cancels the scan and joins the thread.
+     *
+     * When given a watcher, the thread also places the inotify watch before it starts reading.
+     * Watching for child events (attrib, modify) makes the kernel walk every cached dentry of
+     * the directory, which takes tens of milliseconds on large ones, so those are only added
+     * once the listing has been read, and never on the caller's thread.
+     * The watch is handed over with takeWatch() and removed on destruction otherwise.
+     * An optional notifier is signalled for each published batch and when the scan ends.
+     */
+
+    class AsyncScanner {
+    public:
+        static constexpr std::size_t FIRST_BATCH = 256;
+        static constexpr std::size_t BATCH = 8192;
+
+        explicit AsyncScanner(int dirFd, DirectoryWatcher* watcher = nullptr, std::string watchPath = "",
+                              EventNotifier* notifier = nullptr);
+        ~AsyncScanner();
+
+        AsyncScanner(const AsyncScanner&) = delete;
+        AsyncScanner& operator=(const AsyncScanner&) = delete;
+
+        std::unique_ptr<ScanBatch> poll();
+        bool finished() const noexcept;
+        std::size_t scannedCount() const noexcept;
+        void cancel() noexcept;
+        int takeWatch() noexcept;
+
+    private:
+        int _fd;
+        DirectoryWatcher* _watcher;
+        std::string _watchPath;
+        int _wd;
+        EventNotifier* _notifier;
+        SpscQueue<std::unique_ptr<ScanBatch>> _queue;
+        std::atomic<bool> _cancelled;
+        std::atomic<bool> _done;
+        std::atomic<std::size_t> _scanned;
+        std::thread _thread;
+
+        void run();
+        void addChildEvents();
+        bool publish(std::unique_ptr<ScanBatch>& batch);
+        void inspectAll(const std::vector<char>& names, const std::vector<EntryType>& types);
+    };
+
+} // namespace core
+
+#endif // ASYNCSCANNER_HPP
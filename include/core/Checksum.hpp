@@ -0,0 +1,44 @@
+/**
+ * @file Checksum.hpp
+ * @brief Declaration of the core::Checksum class, a streaming XXH64 hash.
+ */
+
+#ifndef CHECKSUM_HPP
+    #define CHECKSUM_HPP
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <string>
+
+namespace core {
+
+    /**
+     * @class Checksum
+     * @brief Hashes a stream of bytes with XXH64, fed in pieces of any size.
+     *
+     * XXH64 is not cryptographic, but it runs at memory speed and its digests match xxhsum's,
+     * so a copy can be checked against the tool. updateZeros() feeds a run of zero bytes, as a
+     * hole in a sparse file reads, without a buffer the size of the run.
+     */
+
+    class Checksum {
+    public:
+        explicit Checksum(std::uint64_t seed = 0) noexcept;
+
+        void update(const void* data, std::size_t length) noexcept;
+        void updateZeros(std::uint64_t length) noexcept;
+        std::uint64_t digest() const noexcept;
+
+        static std::string toHex(std::uint64_t digest);
+
+    private:
+        std::uint64_t _seed;
+        std::uint64_t _lanes[4];
+        std::uint64_t _length;
+        unsigned char _pending[32];
+        std::size_t _pendingSize;
+    };
+
+} // namespace core
+
+#endif // CHECKSUM_HPP
@@ -0,0 +1,41 @@
+/**
+ * @file CommandJob.hpp
+ * @brief Declaration of the core::CommandJob class that runs an external program in the background.
+ */
+
+#ifndef COMMANDJOB_HPP
+    #define COMMANDJOB_HPP
+
+    #include "core/Job.hpp"
+
+    #include <chrono>
+    #include <string>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @class CommandJob
+     * @brief Runs a program such as zip, with its arguments passed as they are, without a shell.
+     *
+     * The program reads from and writes to /dev/null, so that it leaves the terminal alone.
+     * Its progress cannot be told: only the elapsed time is. Pausing stops the process with
+     * SIGSTOP, cancelling terminates it; a non-zero exit status fails the job.
+     */
+
+    class CommandJob : public Job {
+    public:
+        static constexpr std::chrono::milliseconds POLL_INTERVAL { 50 };
+
+        CommandJob(std::string description, std::vector<std::string> arguments);
+
+    protected:
+        void run() override;
+
+    private:
+        std::vector<std::string> _arguments;
+    };
+
+} // namespace core
+
+#endif // COMMANDJOB_HPP
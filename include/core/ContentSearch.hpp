@@ -0,0 +1,116 @@
+/**
+ * @file ContentSearch.hpp
+ * @brief Declaration of the core::ContentSearch class that searches the contents of every file under a directory.
+ */
+
+#ifndef CONTENTSEARCH_HPP
+    #define CONTENTSEARCH_HPP
+
+    #include "core/EventNotifier.hpp"
+    #include "core/ThreadPool.hpp"
+
+    #include <atomic>
+    #include <condition_variable>
+    #include <cstddef>
+    #include <cstdint>
+    #include <functional>
+    #include <memory>
+    #include <mutex>
+    #include <optional>
+    #include <regex>
+    #include <string>
+    #include <string_view>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @struct ContentMatch
+     * @brief A matching line: the file, relative to the searched root, the line and column
+     * (both from 1), and the line itself, cut short and with control characters blanked.
+     */
+    struct ContentMatch {
+        std::string path;
+        std::uint32_t line;
+        std::uint32_t column;
+        std::string text;
+    };
+
+    /**
+     * @class ContentSearch
+     * @brief Greps a directory tree on the shared thread pool, in the background.
+     *
+     * Directories are listed one task each, and their files searched in batches; everything is
+     * opened relative to the descriptor of the directory that holds it. Small files are read
+     * with pread into a per-thread buffer, larger ones are mapped. A file with a NUL byte in its
+     * first kilobytes is taken for binary and skipped.
+     *
+     * The pattern is a literal string or an ECMAScript regular expression. A literal is found
+     * with an SSE2 scan that tests sixteen positions at once; for a regular expression, the
+     * longest literal every match must contain is scanned for the same way, and the expression
+     * only runs on the lines that contain it. Matches are reported one per line.
+     *
+     * Matches accumulate as they are found and matchesSince() hands out the new ones. cancel()
+     * stops the search and keeps what was found; destroying the search cancels it and waits for
+     * the running tasks, which check for cancellation between files and every few megabytes
+     * within one.
+     */
+
+    class ContentSearch {
+    public:
+        static constexpr std::size_t MATCH_LIMIT = 100000;
+        static constexpr std::size_t MAP_THRESHOLD = 64 * 1024;
+        static constexpr std::size_t BINARY_PROBE = 8 * 1024;
+        static constexpr std::size_t LINE_TEXT_LIMIT = 256;
+
+        ContentSearch(const std::string& root, const std::string& pattern, bool regex,
+                      EventNotifier* notifier = nullptr, ThreadPool& pool = ThreadPool::shared());
+        ~ContentSearch();
+
+        ContentSearch(const ContentSearch&) = delete;
+        ContentSearch& operator=(const ContentSearch&) = delete;
+
+        const std::string& root() const noexcept { return _root; }
+        std::vector<ContentMatch> matchesSince(std::size_t first) const;
+        std::size_t matchCount() const noexcept { return _matchCount.load(std::memory_order_relaxed); }
+        std::size_t filesSearched() const noexcept { return _filesSearched.load(std::memory_order_relaxed); }
+        std::uint64_t bytesSearched() const noexcept { return _bytesSearched.load(std::memory_order_relaxed); }
+        bool finished() const noexcept { return _finished.load(std::memory_order_acquire); }
+        bool cancelled() const noexcept { return _cancelled.load(std::memory_order_relaxed); }
+        void cancel() noexcept { _cancelled.store(true, std::memory_order_relaxed); }
+
+        static std::string requiredLiteral(std::string_view regex);
+
+    private:
+        struct Directory;
+
+        std::string _root;
+        int _rootFd;
+        std::string _literal;
+        std::optional<std::regex> _regex;
+        EventNotifier* _notifier;
+        ThreadPool& _pool;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _idle;
+        std::vector<ContentMatch> _matches;
+        std::size_t _pending;
+
+        std::atomic<bool> _cancelled;
+        std::atomic<bool> _finished;
+        std::atomic<std::size_t> _matchCount;
+        std::atomic<std::size_t> _filesSearched;
+        std::atomic<std::uint64_t> _bytesSearched;
+
+        void submit(std::function<void()> task);
+        void done();
+        void walk(std::shared_ptr<const Directory> parent, const std::string& relative);
+        void searchFiles(const Directory& directory, const std::vector<std::string>& paths);
+        void searchFile(const Directory& directory, const std::string& path, std::vector<ContentMatch>& found);
+        void scan(const char* data, std::size_t size, const std::string& path, std::vector<ContentMatch>& found) const;
+        void publish(std::vector<ContentMatch>& found);
+    };
+
+} // namespace core
+
+#endif // CONTENTSEARCH_HPP
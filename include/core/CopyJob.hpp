@@ -0,0 +1,95 @@
+/**
+ * @file CopyJob.hpp
+ * @brief Declaration of the core::CopyJob class that copies a file or a directory tree in the background.
+ */
+
+#ifndef COPYJOB_HPP
+    #define COPYJOB_HPP
+
+    #include "core/Job.hpp"
+    #include "core/ThreadPool.hpp"
+
+    #include <atomic>
+    #include <condition_variable>
+    #include <cstddef>
+    #include <cstdint>
+    #include <exception>
+    #include <memory>
+    #include <mutex>
+    #include <string>
+
+namespace core {
+
+    /**
+     * @struct CopyOptions
+     * @brief How a CopyJob copies. A checksummed copy reads every byte itself, so that it can
+     * hash them; direct I/O keeps the large files of such a copy out of the page cache.
+     */
+    struct CopyOptions {
+        bool checksum = false;
+        bool direct = false;
+    };
+
+    /**
+     * @class CopyJob
+     * @brief Copies a file or a directory tree into a directory, replacing what is in the way.
+     *
+     * Each file goes by the cheapest means the file systems allow, holes kept, a tree's files on a
+     * pool of COPY_THREADS workers; a checksummed copy hashes what it reads, and is not read back.
+     */
+
+    class CopyJob : public Job {
+    public:
+        static constexpr std::size_t CHUNK_SIZE = 1024 * 1024;
+        static constexpr std::size_t RANGE_CHUNK_SIZE = 16 * 1024 * 1024;
+        static constexpr std::size_t COPY_THREADS = 4;
+        static constexpr std::size_t MAX_IN_FLIGHT = 4 * COPY_THREADS;
+        static constexpr std::size_t PIPELINE_CHUNK_SIZE = 4 * 1024 * 1024;
+        static constexpr std::size_t DIRECT_ALIGNMENT = 4096;
+        static constexpr std::uint64_t DIRECT_THRESHOLD = 64 * 1024 * 1024;
+
+        CopyJob(std::string description, std::string source, const std::string& destinationDirectory,
+                CopyOptions options = {});
+
+        const std::string& destination() const noexcept { return _destination; }
+        std::string summary() const override;
+
+    protected:
+        void run() override;
+
+    private:
+        struct Directories;
+
+        std::string _source;
+        std::string _destination;
+        CopyOptions _options;
+        bool _tree;
+        std::atomic<std::uint64_t> _checksum;
+        std::atomic<std::uint64_t> _hashedFiles;
+
+        std::mutex _mutex;
+        std::condition_variable _slots;
+        std::size_t _inFlight;
+        std::exception_ptr _failure;
+        std::atomic<bool> _cloneUnsupported;
+        std::atomic<bool> _rangeUnsupported;
+
+        void copyDirectory(ThreadPool& pool, const std::shared_ptr<Directories>& directories, const std::string& path);
+        void copyLink(int sourceDir, int destinationDir, const char* name, const std::string& path);
+        void submitFile(ThreadPool& pool, std::shared_ptr<Directories> directories, std::string name,
+                        std::string path);
+        void waitForFiles();
+        bool failed();
+
+        void copyFile(int sourceDir, int destinationDir, const char* name, const std::string& path);
+        bool cloneFile(int in, int out, std::uint64_t size);
+        void copyExtents(int in, int out, std::uint64_t size, bool sparse);
+        bool copyRange(int in, int out, std::uint64_t& remaining);
+        bool sendFile(int in, int out, std::uint64_t& remaining);
+        void copyBuffered(int in, int out, std::uint64_t& remaining);
+        std::uint64_t copyHashed(int in, int out, std::uint64_t size, bool sparse);
+    };
+
+} // namespace core
+
+#endif // COPYJOB_HPP
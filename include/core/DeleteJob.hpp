@@ -0,0 +1,62 @@
+/**
+ * @file DeleteJob.hpp
+ * @brief Declaration of the core::DeleteJob class that removes a file or a directory tree in the background.
+ */
+
+#ifndef DELETEJOB_HPP
+    #define DELETEJOB_HPP
+
+    #include "core/Job.hpp"
+    #include "core/ThreadPool.hpp"
+
+    #include <condition_variable>
+    #include <cstddef>
+    #include <cstdint>
+    #include <exception>
+    #include <memory>
+    #include <mutex>
+    #include <string>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @class DeleteJob
+     * @brief Removes a file, or a directory and everything under it, entry by entry, through directory descriptors.
+     * Progress is counted in entries removed; cancelling leaves what is not removed yet.
+     */
+
+    class DeleteJob : public Job {
+    public:
+        static constexpr std::size_t DELETE_THREADS = 4;
+        static constexpr std::size_t CHECKPOINT_INTERVAL = 256;
+
+        DeleteJob(std::string description, std::string path);
+
+    protected:
+        void run() override;
+
+    private:
+        struct Directory;
+
+        std::string _path;
+
+        std::mutex _mutex;
+        std::condition_variable _idle;
+        std::size_t _inFlight;
+        std::exception_ptr _failure;
+
+        std::uint64_t countEntries(int rootFd);
+        void submitDirectory(ThreadPool& pool, std::shared_ptr<Directory> directory);
+        void emptyTree(ThreadPool& pool, std::shared_ptr<Directory> directory);
+        bool emptyDirectory(const std::shared_ptr<Directory>& directory, std::vector<std::string>& subdirectories);
+        void release(std::shared_ptr<Directory> directory);
+        std::string pathOf(const Directory& directory) const;
+        void waitForTasks();
+        bool workerIdle();
+        bool failed();
+    };
+
+} // namespace core
+
+#endif // DELETEJOB_HPP
@@ -7,9 +7,19 @@
 #ifndef DIRECTORY_HPP
     #define DIRECTORY_HPP
 
+    #include "core/AsyncScanner.hpp"
+    #include "core/EntryTable.hpp"
+    #include "core/DirectoryWatcher.hpp"
+    #include "core/EventNotifier.hpp"
     #include "core/File.hpp"
+    #include "core/ListingCache.hpp"
+    #include "core/ListingFilter.hpp"
+    #include "core/ListingSorter.hpp"
+    #include "core/Prefetcher.hpp"
 
+    #include <memory>
     #include <string>
+    #include <string_view>
     #include <vector>
 
 namespace core {
@@ -20,26 +30,101 @@ namespace core {
      *
      * This class allows you to check if a directory exists, create or remove it,
      * list files within the directory, and refresh the file list.
+     * Entries are kept in a packed EntryTable; full paths are rebuilt on demand.
+     * An inotify watch on the directory lets sync() patch the listing in place
+     * instead of rescanning it. Positions passed to the accessors are positions
+     * in the displayed listing, not table indices.
+     *
+     * Scans run on a background AsyncScanner: refresh() and setPath() return at once,
+     * and sync() appends whatever batches have arrived. Changing path cancels a scan
+     * still in flight. Inotify events are held back until the scan completes, since
+     * they can only be matched against a complete listing.
+     *
+     * Leaving a directory parks its listing, and its watch, in a ListingCache; coming back
+     * to it while it is still valid restores the listing without scanning. prefetch() lets a
+     * background worker fill the cache with the directory under the cursor ahead of time.
+     * Given a notifier, the background workers signal it whenever sync() has something to pick up.
+     *
+     * The display order follows a SortOrder. A scan is shown in the order it arrives and sorted
+     * once complete; entries added afterwards are inserted in place.
+     * A filter can hide the entries whose name does not match a pattern; positions then refer
+     * to the matching entries only, and names() has to be fetched again whenever it changes.
      */
 
     class Directory {
     public:
-        explicit Directory(const std::string& path);
-        ~Directory() = default;
+        explicit Directory(const std::string& path, std::size_t cacheBudget = ListingCache::DEFAULT_BYTE_BUDGET,
+                           EventNotifier* notifier = nullptr);
+        ~Directory();
+
+        Directory(const Directory&) = delete;
+        Directory& operator=(const Directory&) = delete;
 
         bool exists() const noexcept;
         bool create() const noexcept;
         bool remove() const noexcept;
 
-        std::vector<std::string> listFiles() const noexcept;
-        void refresh(); // rescans directory and updates _files
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        NameSpan names() const noexcept;
+        const EntryTable& entries() const noexcept;
+        void refresh(); // rescans directory and updates _entries
+        bool sync();    // applies pending inotify events, rescans if unwatched
+        bool isWatching() const noexcept;
+        bool isLoading() const noexcept;
+        std::size_t scannedCount() const noexcept;
+        int watchFd() const noexcept;
+
+        EntryTable::Index entryAt(std::size_t pos) const noexcept;
+        std::uint8_t attributesAt(std::size_t pos) const noexcept;
+        std::size_t indexOf(std::string_view name);
+        std::string pathOf(std::size_t pos) const;
+        bool loadStat(std::size_t pos) noexcept;
+        File fileAt(std::size_t pos) const;
+
+        SortOrder sortOrder() const noexcept;
+        void setSortOrder(SortOrder sortOrder);
+
+        bool isFiltered() const noexcept;
+        const std::string& filter() const noexcept;
+        void pushFilter(char c);
+        void popFilter();
+        void clearFilter() noexcept;
+
+        ListingCache& cache() noexcept;
+        void prefetch(std::size_t pos);
 
         const std::string& getPath() const noexcept;
         void setPath(const std::string& path);
 
     private:
         std::string _path;
-        std::vector<File> _files;
+        int _fd;
+        EntryTable _entries;
+        std::vector<EntryTable::Index> _order;
+        SortOrder _sortOrder;
+        ListingFilter _filter;
+
+        DirectoryWatcher _watcher;
+        EventNotifier* _notifier;
+        int _wd;
+        std::unique_ptr<AsyncScanner> _scanner;
+        ListingCache _cache;
+        Prefetcher _prefetcher;
+
+        const std::vector<EntryTable::Index>& shown() const noexcept;
+        bool pump();
+        void adoptPrefetched();
+        bool applyEvents(bool apply);
+        void release();
+        void stash();
+        bool restore();
+        bool addEntry(std::string_view name);
+        bool removeEntry(std::string_view name);
+        bool touchEntry(std::string_view name);
+        void placeEntry(EntryTable::Index i);
+        void sortEntries();
+        void compactEntries();
     };
 
 } // namespace core
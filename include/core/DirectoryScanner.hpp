@@ -0,0 +1,104 @@
+/**
+ * @file DirectoryScanner.hpp
+ * @brief Declaration of the core::DirectoryScanner class that reads directory entries in bulk.
+ */
+
+#ifndef DIRECTORYSCANNER_HPP
+    #define DIRECTORYSCANNER_HPP
+
+    #include "core/EntryTable.hpp"
+    #include "core/EntryType.hpp"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <memory>
+    #include <string>
+    #include <string_view>
+
+namespace core {
+
+    /**
+     * @class DirectoryScanner
+     * @brief Reads a directory with getdents64 into a large buffer and classifies entries from d_type.
+     *
+     * No stat call is made per entry: the name and the type are all the kernel hands back.
+     * describe() derives what it can of the attribute byte from the name and type alone;
+     * inspect() stats the entry for the rest, and is meant to run off the UI thread.
+     */
+
+    class DirectoryScanner {
+    public:
+        static constexpr std::size_t DEFAULT_BUFFER_SIZE = 256 * 1024;
+
+        explicit DirectoryScanner(const std::string& path, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+        explicit DirectoryScanner(int dirFd, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+        ~DirectoryScanner();
+
+        DirectoryScanner(const DirectoryScanner&) = delete;
+        DirectoryScanner& operator=(const DirectoryScanner&) = delete;
+
+        bool isOpen() const noexcept;
+        int fd() const noexcept;
+
+        template <typename Fn>
+        std::size_t scan(Fn&& onEntry);
+
+        static EntryType typeFromDirent(unsigned char dtype) noexcept;
+        static EntryType typeFromMode(unsigned int mode) noexcept;
+        static EntryDetails describe(std::string_view name, EntryType type) noexcept;
+        static EntryDetails inspect(int dirFd, const char* name, EntryType type) noexcept;
+
+    private:
+        int _fd;
+        bool _ownsFd;
+        std::size_t _bufferSize;
+        std::unique_ptr<char[]> _buffer;
+
+        long readBatch() noexcept;
+        EntryType resolveUnknown(const char* name) const noexcept;
+
+        struct RawDirent {
+            std::uint64_t ino;
+            std::int64_t off;
+            unsigned short reclen;
+            unsigned char type;
+            char name[1];
+        };
+    };
+
+    /**
+     * @brief Reads every entry of the directory and calls onEntry(name, type) for each of them.
+     * "." and ".." are skipped; entries whose d_type is DT_UNKNOWN are resolved with one lstat.
+     * @param onEntry Callable taking (std::string_view name, EntryType type). Returning false stops the scan.
+     * @return The number of entries reported.
+     */
+    template <typename Fn>
+    std::size_t DirectoryScanner::scan(Fn&& onEntry)
+    {
+        std::size_t count = 0;
+
+        if (_fd < 0)
+            return 0;
+        for (long n = readBatch(); n > 0; n = readBatch()) {
+            for (long pos = 0; pos < n;) {
+                const auto* d = reinterpret_cast<const RawDirent*>(_buffer.get() + pos);
+                pos += d->reclen;
+
+                const char* name = d->name;
+                if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                    continue;
+
+                EntryType type = typeFromDirent(d->type);
+                if (type == EntryType::UNKNOWN)
+                    type = resolveUnknown(name);
+                ++count;
+                if (!onEntry(std::string_view(name), type))
+                    return count;
+            }
+        }
+        return count;
+    }
+
+} // namespace core
+
+#endif // DIRECTORYSCANNER_HPP
@@ -0,0 +1,33 @@
+/**
+ * @file DirectoryStamp.hpp
+ * @brief Declaration of the core::DirectoryStamp structure that tells whether a directory changed.
+ */
+
+#ifndef DIRECTORYSTAMP_HPP
+    #define DIRECTORYSTAMP_HPP
+
+    #include <cstdint>
+    #include <optional>
+    #include <string>
+
+namespace core {
+
+    /**
+     * @struct DirectoryStamp
+     * @brief The modification and change times of a directory, used to tell whether a listing
+     * taken earlier still matches it.
+     */
+    struct DirectoryStamp {
+        std::int64_t mtimeSec = 0;
+        std::uint32_t mtimeNsec = 0;
+        std::int64_t ctimeSec = 0;
+        std::uint32_t ctimeNsec = 0;
+
+        static std::optional<DirectoryStamp> of(const std::string& path) noexcept;
+        static std::optional<DirectoryStamp> of(int dirFd, const char* path) noexcept;
+        bool operator==(const DirectoryStamp&) const = default;
+    };
+
+} // namespace core
+
+#endif // DIRECTORYSTAMP_HPP
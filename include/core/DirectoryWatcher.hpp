@@ -0,0 +1,89 @@
+/**
+ * @file DirectoryWatcher.hpp
+ * @brief Declaration of the core::DirectoryWatcher class that wraps an inotify instance.
+ */
+
+#ifndef DIRECTORYWATCHER_HPP
+    #define DIRECTORYWATCHER_HPP
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <string>
+    #include <string_view>
+
+    #include <sys/inotify.h>
+    #include <unistd.h>
+
+namespace core {
+
+    /**
+     * @struct WatchEvent
+     * @brief One inotify event. The name points into the watcher's read buffer and is only
+     * valid during the callback.
+     */
+    struct WatchEvent {
+        int wd;
+        std::uint32_t mask;
+        std::uint32_t cookie;
+        std::string_view name;
+    };
+
+    /**
+     * @class DirectoryWatcher
+     * @brief Owns a non-blocking inotify descriptor and the watches placed on it.
+     */
+
+    class DirectoryWatcher {
+    public:
+        static constexpr std::uint32_t CHILD_EVENTS = IN_ATTRIB | IN_MODIFY | IN_CLOSE_WRITE;
+        static constexpr std::uint32_t LISTING_EVENTS =
+            IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB | IN_MODIFY
+            | IN_CLOSE_WRITE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+        DirectoryWatcher();
+        ~DirectoryWatcher();
+
+        DirectoryWatcher(const DirectoryWatcher&) = delete;
+        DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+        int fd() const noexcept;
+        int watch(const std::string& path, std::uint32_t mask = LISTING_EVENTS) noexcept;
+        void unwatch(int wd) noexcept;
+
+        template <typename Fn>
+        std::size_t drain(Fn&& onEvent);
+
+    private:
+        int _fd;
+        alignas(struct inotify_event) char _buffer[64 * 1024];
+    };
+
+    /**
+     * @brief Reads every pending event without blocking and calls onEvent(const WatchEvent&) for each.
+     * @return The number of events delivered.
+     */
+    template <typename Fn>
+    std::size_t DirectoryWatcher::drain(Fn&& onEvent)
+    {
+        std::size_t count = 0;
+
+        if (_fd < 0)
+            return 0;
+        for (;;) {
+            ssize_t n = ::read(_fd, _buffer, sizeof(_buffer));
+            if (n <= 0)
+                return count;
+            for (ssize_t pos = 0; pos < n;) {
+                const auto* ev = reinterpret_cast<const struct inotify_event*>(_buffer + pos);
+                pos += static_cast<ssize_t>(sizeof(struct inotify_event) + ev->len);
+
+                WatchEvent event { ev->wd, ev->mask, ev->cookie, ev->len ? std::string_view(ev->name) : std::string_view() };
+                onEvent(event);
+                ++count;
+            }
+        }
+    }
+
+} // namespace core
+
+#endif // DIRECTORYWATCHER_HPP
@@ -0,0 +1,151 @@
+/**
+ * @file DiskUsage.hpp
+ * @brief Declaration of the core::DiskUsage class that sizes a directory tree in the background.
+ */
+
+#ifndef DISKUSAGE_HPP
+    #define DISKUSAGE_HPP
+
+    #include "core/EventNotifier.hpp"
+    #include "core/ThreadPool.hpp"
+    #include "core/UsageCache.hpp"
+
+    #include <array>
+    #include <atomic>
+    #include <chrono>
+    #include <condition_variable>
+    #include <cstddef>
+    #include <cstdint>
+    #include <functional>
+    #include <memory>
+    #include <mutex>
+    #include <string>
+    #include <unordered_set>
+    #include <utility>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @struct UsageFile
+     * @brief An entry other than a directory, as kept by a walk asked to: its name lies in the
+     * fileNames of its directory. A further link to a file already counted is kept with no size.
+     */
+    struct UsageFile {
+        std::uint64_t bytes;
+        std::uint64_t allocated;
+        std::uint32_t nameOffset;
+        std::uint16_t nameLength;
+        bool duplicate;
+    };
+
+    /**
+     * @struct UsageNode
+     * @brief One directory of a sized tree.
+     *
+     * own holds the directory itself and the entries listed in it, total the whole subtree once
+     * complete is set. children are the subdirectories and files the other entries, both added
+     * while the directory is listed; they may only be read once complete is set. files stays
+     * empty unless the walk keeps files.
+     */
+    struct UsageNode {
+        std::string name;
+        UsageNode* parent = nullptr;
+        UsageTotals own;
+        UsageTotals total;
+        std::vector<std::unique_ptr<UsageNode>> children;
+        std::vector<UsageFile> files;
+        std::string fileNames;
+        bool unreadable = false;
+        // The directory's own listing, plus each subdirectory not complete yet
+        std::atomic<std::size_t> remaining { 1 };
+        std::atomic<bool> complete { false };
+    };
+
+    /**
+     * @class DiskUsage
+     * @brief Adds up the size of everything under a directory, like du, on the shared thread pool.
+     *
+     * Each directory is listed by a task of its own, opened relative to its parent's descriptor,
+     * and its entries are stated with fstatat relative to its own, without following symlinks.
+     * A file with several hard links is counted the first time one of its links is met, through
+     * a set of (device, inode) pairs split in shards so that workers seldom wait on the same lock.
+     *
+     * progress() gives the running totals while the walk goes on; the notifier is signalled at
+     * most every NOTIFY_INTERVAL, and when the walk ends. A directory is complete once its whole
+     * subtree is, and its totals are then stored in the cache, if any. Files are only kept in
+     * the tree when asked for, for a view that lists them. Destroying the walk cancels it and
+     * waits for the running tasks.
+     */
+
+    class DiskUsage {
+    public:
+        static constexpr std::chrono::milliseconds NOTIFY_INTERVAL { 50 };
+        static constexpr std::size_t LINK_SHARDS = 64;
+
+        DiskUsage(const std::string& root, UsageCache* cache = nullptr, EventNotifier* notifier = nullptr,
+                  bool keepFiles = false, ThreadPool& pool = ThreadPool::shared());
+        ~DiskUsage();
+
+        DiskUsage(const DiskUsage&) = delete;
+        DiskUsage& operator=(const DiskUsage&) = delete;
+
+        const std::string& root() const noexcept { return _root; }
+        const UsageNode& tree() const noexcept { return _tree; }
+        UsageTotals progress() const noexcept;
+        std::size_t errors() const noexcept { return _errors.load(std::memory_order_relaxed); }
+        bool finished() const noexcept { return _finished.load(std::memory_order_acquire); }
+        bool cancelled() const noexcept { return _cancelled.load(std::memory_order_relaxed); }
+        void cancel() noexcept { _cancelled.store(true, std::memory_order_relaxed); }
+        void wait();
+
+    private:
+        struct Directory;
+
+        struct LinkHash {
+            std::size_t operator()(const std::pair<std::uint64_t, std::uint64_t>& key) const noexcept
+            {
+                return std::hash<std::uint64_t>()(key.first * 0x9e3779b97f4a7c15ULL ^ key.second);
+            }
+        };
+
+        struct LinkShard {
+            std::mutex mutex;
+            std::unordered_set<std::pair<std::uint64_t, std::uint64_t>, LinkHash> seen;
+        };
+
+        std::string _root;
+        std::string _base;
+        int _rootFd;
+        UsageCache* _cache;
+        EventNotifier* _notifier;
+        bool _keepFiles;
+        ThreadPool& _pool;
+        UsageNode _tree;
+        std::array<LinkShard, LINK_SHARDS> _links;
+
+        std::mutex _mutex;
+        std::condition_variable _idle;
+        std::size_t _pending;
+
+        std::atomic<bool> _cancelled;
+        std::atomic<bool> _finished;
+        std::atomic<std::uint64_t> _bytes;
+        std::atomic<std::uint64_t> _allocated;
+        std::atomic<std::uint64_t> _files;
+        std::atomic<std::uint64_t> _directories;
+        std::atomic<std::size_t> _errors;
+        std::atomic<std::int64_t> _lastNotify;
+
+        void submit(std::function<void()> task);
+        void done();
+        void walk(UsageNode* node, std::shared_ptr<const Directory> parent);
+        void complete(UsageNode* node);
+        bool firstLink(std::uint64_t device, std::uint64_t inode);
+        void report(const UsageTotals& listed);
+        std::string pathOf(const UsageNode* node) const;
+    };
+
+} // namespace core
+
+#endif // DISKUSAGE_HPP
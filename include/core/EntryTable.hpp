@@ -0,0 +1,151 @@
+/**
+ * @file EntryTable.hpp
+ * @brief Declaration of the core::EntryTable class, a packed struct-of-arrays listing of a directory.
+ */
+
+#ifndef ENTRYTABLE_HPP
+    #define ENTRYTABLE_HPP
+
+    #include "core/EntryType.hpp"
+    #include "core/FileClass.hpp"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <string_view>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @struct EntryDetails
+     * @brief What one statx tells about an entry, plus the attribute byte derived from it.
+     * size, mtime and mode are only meaningful when stated is true.
+     */
+    struct EntryDetails {
+        EntryType type = EntryType::UNKNOWN;
+        std::uint8_t attributes = 0;
+        bool stated = false;
+        std::uint16_t mode = 0;
+        std::uint64_t size = 0;
+        std::int64_t mtime = 0;
+    };
+
+    /**
+     * @class EntryTable
+     * @brief Stores the entries of one directory as fixed-width columns plus a single name arena.
+     *
+     * Names are appended NUL-terminated to one contiguous buffer, so they can be handed to
+     * *at() syscalls without copying, and searched in a single pass. Every other field lives in
+     * its own column, which keeps the cost at 26 bytes per entry plus the name itself, with no
+     * per-entry allocation.
+     * Size, mode and mtime are only valid once hasStat() is true.
+     *
+     * Each entry also has an attribute byte: whether it shows as a directory or as executable
+     * (following symlinks), whether it is a symlink, and its FileClass in the high nibble.
+     * It is filled in when the entry is scanned, so drawing a listing needs no syscall.
+     *
+     * Removed entries keep their slot until compact() is called, so indices stay stable while
+     * a listing is being patched. The name index used by find() is only built on first use.
+     */
+
+    class EntryTable {
+    public:
+        using Index = std::uint32_t;
+        static constexpr Index NPOS = static_cast<Index>(-1);
+
+        static constexpr std::uint8_t ATTR_DIRECTORY = 0x01;
+        static constexpr std::uint8_t ATTR_EXECUTABLE = 0x02;
+        static constexpr std::uint8_t ATTR_SYMLINK = 0x04;
+        static constexpr unsigned ATTR_CLASS_SHIFT = 4;
+
+        static constexpr std::uint8_t makeAttributes(std::uint8_t flags, FileClass fileClass) noexcept
+        {
+            return static_cast<std::uint8_t>(flags | (static_cast<unsigned>(fileClass) << ATTR_CLASS_SHIFT));
+        }
+
+        static constexpr FileClass fileClassOf(std::uint8_t attributes) noexcept
+        {
+            return static_cast<FileClass>(attributes >> ATTR_CLASS_SHIFT);
+        }
+
+        void clear() noexcept;
+        void reserve(std::size_t entries, std::size_t nameBytes);
+        void shrinkToFit();
+
+        Index append(std::string_view name, EntryType type);
+        void setStat(Index i, std::uint64_t size, std::int64_t mtime, std::uint16_t mode) noexcept;
+        void setAttributes(Index i, std::uint8_t attributes) noexcept { _attributes[i] = attributes; }
+        void setDetails(Index i, const EntryDetails& details) noexcept;
+        void invalidateStat(Index i) noexcept { _flags[i] &= static_cast<std::uint8_t>(~FLAG_STAT); }
+        void markRemoved(Index i) noexcept;
+
+        Index find(std::string_view name);
+        std::vector<Index> compact();
+
+        std::size_t size() const noexcept { return _types.size(); }
+        bool empty() const noexcept { return _types.empty(); }
+        std::size_t removedCount() const noexcept { return _removed; }
+
+        std::string_view name(Index i) const noexcept { return { _names.data() + _nameOffsets[i], _nameLengths[i] }; }
+        const char* cname(Index i) const noexcept { return _names.data() + _nameOffsets[i]; }
+        std::uint32_t nameOffset(Index i) const noexcept { return _nameOffsets[i]; }
+        const char* nameData() const noexcept { return _names.data(); }
+        std::size_t nameBytes() const noexcept { return _names.size(); }
+        EntryType type(Index i) const noexcept { return _types[i]; }
+        bool hasStat(Index i) const noexcept { return _flags[i] & FLAG_STAT; }
+        bool isRemoved(Index i) const noexcept { return _flags[i] & FLAG_REMOVED; }
+        std::uint64_t fileSize(Index i) const noexcept { return _sizes[i]; }
+        std::int64_t mtime(Index i) const noexcept { return _mtimes[i]; }
+        std::uint16_t mode(Index i) const noexcept { return _modes[i]; }
+        std::uint8_t attributes(Index i) const noexcept { return _attributes[i]; }
+        FileClass fileClass(Index i) const noexcept { return fileClassOf(_attributes[i]); }
+
+        std::size_t memoryUsage() const noexcept;
+
+    private:
+        static constexpr std::uint8_t FLAG_STAT = 0x01;
+        static constexpr std::uint8_t FLAG_REMOVED = 0x02;
+
+        std::vector<char> _names;
+        std::vector<std::uint32_t> _nameOffsets;
+        std::vector<std::uint8_t> _nameLengths;
+        std::vector<EntryType> _types;
+        std::vector<std::uint8_t> _flags;
+        std::vector<std::uint8_t> _attributes;
+        std::vector<std::uint16_t> _modes;
+        std::vector<std::uint64_t> _sizes;
+        std::vector<std::int64_t> _mtimes;
+        std::size_t _removed = 0;
+
+        std::vector<Index> _slots;
+
+        static std::uint64_t hashName(std::string_view name) noexcept;
+        void buildIndex();
+        void indexInsert(Index i) noexcept;
+    };
+
+    /**
+     * @class NameSpan
+     * @brief A read-only, non-owning view over the names of a listing.
+     *
+     * It reads the table and the display order live, so it stays valid across rescans and patches.
+     */
+
+    class NameSpan {
+    public:
+        NameSpan() = default;
+        NameSpan(const EntryTable& table, const std::vector<EntryTable::Index>& order)
+            : _table(&table), _order(&order) {}
+
+        std::size_t size() const noexcept { return _order ? _order->size() : 0; }
+        bool empty() const noexcept { return size() == 0; }
+        std::string_view operator[](std::size_t i) const noexcept { return _table->name((*_order)[i]); }
+
+    private:
+        const EntryTable* _table = nullptr;
+        const std::vector<EntryTable::Index>* _order = nullptr;
+    };
+
+} // namespace core
+
+#endif // ENTRYTABLE_HPP
@@ -0,0 +1,29 @@
+/**
+ * @file EntryType.hpp
+ * @brief Declaration of the core::EntryType enum class that classifies directory entries.
+ */
+
+#ifndef ENTRYTYPE_HPP
+    #define ENTRYTYPE_HPP
+
+    #include <cstdint>
+
+namespace core {
+
+    /**
+     * @enum EntryType
+     * @brief The kind of a directory entry, as reported by the kernel's d_type.
+     *
+     * UNKNOWN is only kept when neither d_type nor the fallback lstat could tell.
+     */
+    enum class EntryType : std::uint8_t {
+        UNKNOWN,
+        REGULAR,
+        DIRECTORY,
+        SYMLINK,
+        OTHER
+    };
+
+} // namespace core
+
+#endif // ENTRYTYPE_HPP
@@ -0,0 +1,37 @@
+/**
+ * @file EventNotifier.hpp
+ * @brief Declaration of the core::EventNotifier class that wraps an eventfd.
+ */
+
+#ifndef EVENTNOTIFIER_HPP
+    #define EVENTNOTIFIER_HPP
+
+namespace core {
+
+    /**
+     * @class EventNotifier
+     * @brief A non-blocking eventfd that background workers use to wake the main loop.
+     *
+     * Any thread may call notify(); notifications coalesce until the owner drains them.
+     * The descriptor can be waited on with poll alongside the terminal and inotify.
+     */
+
+    class EventNotifier {
+    public:
+        EventNotifier();
+        ~EventNotifier();
+
+        EventNotifier(const EventNotifier&) = delete;
+        EventNotifier& operator=(const EventNotifier&) = delete;
+
+        int fd() const noexcept;
+        void notify() noexcept;
+        void drain() noexcept;
+
+    private:
+        int _fd;
+    };
+
+} // namespace core
+
+#endif // EVENTNOTIFIER_HPP
@@ -6,8 +6,11 @@
 #ifndef FILE_HPP
     #define FILE_HPP
 
+    #include "core/EntryType.hpp"
+
     #include <string>
     #include <filesystem>
+    #include <ctime>
 
 namespace core {
 
@@ -17,11 +20,14 @@ namespace core {
      *
      * This class encapsulates the metadata of a file, including its name, path,
      * size, type (file or directory), and last modified time.
+     * The name and type come from the directory scan; size and time are fetched
+     * with a single statx the first time one of them is asked for.
      */
 
     class File {
     public:
         explicit File(const std::filesystem::directory_entry& entry);
+        File(std::string path, std::string name, EntryType type);
         ~File() = default;
 
         const std::string& getName() const noexcept;
@@ -29,14 +35,19 @@ namespace core {
         std::uintmax_t getSize() const noexcept;
         bool isDirectory() const noexcept;
         std::time_t getLastModified() const noexcept;
+        EntryType getType() const noexcept;
 
     protected:
     private:
         std::string _name;
         std::string _path;
-        std::uintmax_t _size;
-        bool _isDirectory;
-        std::time_t _lastModified;
+        EntryType _type;
+        mutable bool _statLoaded;
+        mutable bool _targetIsDirectory;
+        mutable std::uintmax_t _size;
+        mutable std::time_t _lastModified;
+
+        void loadStat() const noexcept;
     };
 
 } // namespace core
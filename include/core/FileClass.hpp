@@ -0,0 +1,40 @@
+/**
+ * @file FileClass.hpp
+ * @brief Declaration of the core::FileClass enum class and of the name-based classifier.
+ */
+
+#ifndef FILECLASS_HPP
+    #define FILECLASS_HPP
+
+    #include <cstdint>
+    #include <string_view>
+
+namespace core {
+
+    /**
+     * @enum FileClass
+     * @brief What a file is, judging by its extension alone. Fits in four bits.
+     *
+     * The order is the one used when listings are grouped by type.
+     */
+    enum class FileClass : std::uint8_t {
+        NONE,
+        DOCUMENT,
+        SOURCE,
+        SCRIPT,
+        DATA,
+        IMAGE,
+        AUDIO,
+        VIDEO,
+        FONT,
+        ARCHIVE,
+        BINARY
+    };
+
+    FileClass classifyName(std::string_view name) noexcept;
+    FileClass classifyExtension(std::string_view extension) noexcept;
+    std::string_view extensionOf(std::string_view name) noexcept;
+
+} // namespace core
+
+#endif // FILECLASS_HPP
@@ -0,0 +1,30 @@
+/**
+ * @file FileIdentity.hpp
+ * @brief Declaration of the core::FileIdentity structure that tells files apart whatever the path they are reached by.
+ */
+
+#ifndef FILEIDENTITY_HPP
+    #define FILEIDENTITY_HPP
+
+    #include <cstdint>
+    #include <string>
+    #include <sys/stat.h>
+
+namespace core {
+
+    /**
+     * @struct FileIdentity
+     * @brief The device and inode of a file, which neither links, nor "..", nor a bind mount change.
+     */
+    struct FileIdentity {
+        std::uint64_t device = 0;
+        std::uint64_t inode = 0;
+
+        static FileIdentity of(const struct stat& st) noexcept;
+        bool encloses(const std::string& path) const noexcept;
+        bool operator==(const FileIdentity&) const = default;
+    };
+
+} // namespace core
+
+#endif // FILEIDENTITY_HPP
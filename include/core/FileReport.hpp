@@ -0,0 +1,116 @@
+/**
+ * @file FileReport.hpp
+ * @brief Declaration of the core::FileReport class that finds the largest or latest files under a directory.
+ */
+
+#ifndef FILEREPORT_HPP
+    #define FILEREPORT_HPP
+
+    #include "core/EventNotifier.hpp"
+    #include "core/ThreadPool.hpp"
+
+    #include <atomic>
+    #include <chrono>
+    #include <condition_variable>
+    #include <cstddef>
+    #include <cstdint>
+    #include <ctime>
+    #include <functional>
+    #include <mutex>
+    #include <string>
+    #include <thread>
+    #include <unordered_map>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @enum Ranking
+     * @brief What a report ranks files by: size, largest first, or modification time, latest first.
+     */
+    enum class Ranking {
+        LARGEST,
+        RECENT
+    };
+
+    /**
+     * @struct RankedFile
+     * @brief A file of a report: its path relative to the walked root, size and modification time.
+     */
+    struct RankedFile {
+        std::string path;
+        std::uint64_t size;
+        std::time_t modified;
+    };
+
+    /**
+     * @class FileReport
+     * @brief Walks a directory tree on the shared thread pool and keeps the first files of a ranking.
+     *
+     * Directories are listed one task each and their regular files stated relative to the
+     * directory's descriptor. Each worker thread keeps a heap of at most limit candidates, with
+     * the weakest on top: a file that does not beat it is dropped before its path is even built.
+     * The last task merges the heaps, so memory stays bound by the limit and the number of
+     * workers, whatever the size of the tree.
+     *
+     * A RECENT report only considers files modified after since. results() is filled in once the
+     * report is finished; cancelling keeps what was ranked until then. Destroying the report
+     * cancels it and waits for the running tasks.
+     */
+
+    class FileReport {
+    public:
+        static constexpr std::size_t DEFAULT_LIMIT = 100;
+        static constexpr std::chrono::milliseconds NOTIFY_INTERVAL { 100 };
+
+        FileReport(const std::string& root, Ranking ranking, std::size_t limit = DEFAULT_LIMIT, std::time_t since = 0,
+                   EventNotifier* notifier = nullptr, ThreadPool& pool = ThreadPool::shared());
+        ~FileReport();
+
+        FileReport(const FileReport&) = delete;
+        FileReport& operator=(const FileReport&) = delete;
+
+        const std::string& root() const noexcept { return _root; }
+        Ranking ranking() const noexcept { return _ranking; }
+        const std::vector<RankedFile>& results() const noexcept { return _results; }
+        std::size_t filesSeen() const noexcept { return _filesSeen.load(std::memory_order_relaxed); }
+        bool finished() const noexcept { return _finished.load(std::memory_order_acquire); }
+        bool cancelled() const noexcept { return _cancelled.load(std::memory_order_relaxed); }
+        void cancel() noexcept { _cancelled.store(true, std::memory_order_relaxed); }
+        void wait();
+
+    private:
+        struct Candidate {
+            std::int64_t key;
+            RankedFile file;
+        };
+
+        std::string _root;
+        int _rootFd;
+        Ranking _ranking;
+        std::size_t _limit;
+        std::int64_t _since;
+        EventNotifier* _notifier;
+        ThreadPool& _pool;
+
+        std::mutex _mutex;
+        std::condition_variable _idle;
+        std::size_t _pending;
+        std::unordered_map<std::thread::id, std::vector<Candidate>> _heaps;
+        std::vector<RankedFile> _results;
+
+        std::atomic<bool> _cancelled;
+        std::atomic<bool> _finished;
+        std::atomic<std::size_t> _filesSeen;
+        std::atomic<std::int64_t> _lastNotify;
+
+        void submit(std::function<void()> task);
+        void done();
+        void walk(const std::string& relative);
+        std::vector<Candidate>& heapOfThisThread();
+        void merge();
+    };
+
+} // namespace core
+
+#endif // FILEREPORT_HPP
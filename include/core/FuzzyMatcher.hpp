@@ -0,0 +1,68 @@
+/**
+ * @file FuzzyMatcher.hpp
+ * @brief Declaration of the core::FuzzyMatcher class that ranks paths against a fuzzy pattern.
+ */
+
+#ifndef FUZZYMATCHER_HPP
+    #define FUZZYMATCHER_HPP
+
+    #include "core/PathIndex.hpp"
+    #include "core/ThreadPool.hpp"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <optional>
+    #include <string>
+    #include <string_view>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @struct FuzzyMatch
+     * @brief A path of a PathIndex snapshot, by chunk and position, with its score.
+     */
+    struct FuzzyMatch {
+        int score;
+        std::uint16_t length;
+        std::uint32_t chunk;
+        std::uint32_t index;
+    };
+
+    /**
+     * @class FuzzyMatcher
+     * @brief Scores paths the way fzf does: the pattern characters must appear in order, and
+     * matches earn bonuses at word boundaries, after a '/', on camelCase humps and in a row,
+     * and lose points for gaps. A match that lies in the file name scores higher.
+     *
+     * The pattern ignores case unless it has an uppercase letter. Most paths are rejected by
+     * comparing character masks, two paths per SSE2 instruction; the rest are matched with a
+     * vectorised character search before being scored.
+     */
+
+    class FuzzyMatcher {
+    public:
+        explicit FuzzyMatcher(std::string_view pattern);
+
+        const std::string& pattern() const noexcept { return _pattern; }
+
+        std::optional<int> score(const char* text, std::size_t length, std::size_t readable,
+                                 std::size_t nameStart) const noexcept;
+        void search(const PathIndex::Snapshot& chunks, std::size_t firstChunk, std::size_t limit,
+                    std::vector<FuzzyMatch>& results, ThreadPool& pool = ThreadPool::shared()) const;
+
+        static bool better(const FuzzyMatch& a, const FuzzyMatch& b) noexcept;
+
+    private:
+        std::string _pattern;
+        std::string _needle;
+        bool _caseSensitive;
+        std::uint64_t _mask;
+
+        std::size_t find(const char* text, std::size_t from, std::size_t length, std::size_t readable,
+                         char c) const noexcept;
+    };
+
+} // namespace core
+
+#endif // FUZZYMATCHER_HPP
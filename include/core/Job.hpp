@@ -0,0 +1,111 @@
+/**
+ * @file Job.hpp
+ * @brief Declaration of the core::Job class, a long file operation run by the JobQueue.
+ */
+
+#ifndef JOB_HPP
+    #define JOB_HPP
+
+    #include "core/EventNotifier.hpp"
+
+    #include <atomic>
+    #include <chrono>
+    #include <condition_variable>
+    #include <cstdint>
+    #include <mutex>
+    #include <string>
+
+namespace core {
+
+    /**
+     * @struct JobProgress
+     * @brief Where a job stands. The totals are 0 while unknown; elapsed leaves out the time spent paused.
+     * A job that has no bytes to count is measured by its files.
+     */
+    struct JobProgress {
+        std::uint64_t bytesDone = 0;
+        std::uint64_t bytesTotal = 0;
+        std::uint64_t filesDone = 0;
+        std::uint64_t filesTotal = 0;
+        std::chrono::nanoseconds elapsed { 0 };
+
+        double fraction() const noexcept;
+        double throughput() const noexcept;
+        std::chrono::seconds remaining() const noexcept;
+    };
+
+    /**
+     * @class Job
+     * @brief A file operation that runs on the job queue's worker, off the UI thread.
+     *
+     * A job implements run(), which reports its progress with setTotals() and advance(), and calls
+     * checkpoint() between pieces of work: checkpoint() blocks while the job is paused and returns
+     * false once it is cancelled, at which point run() returns early. An exception thrown by run()
+     * fails the job with its message. pause(), resume() and cancel() may be called from any thread.
+     * summary() describes what a finished job found, for jobs that have more to say than done.
+     */
+
+    class Job {
+    public:
+        enum class State {
+            QUEUED,
+            RUNNING,
+            DONE,
+            FAILED,
+            CANCELLED
+        };
+
+        static constexpr std::chrono::milliseconds NOTIFY_INTERVAL { 100 };
+
+        explicit Job(std::string description);
+        virtual ~Job() = default;
+
+        Job(const Job&) = delete;
+        Job& operator=(const Job&) = delete;
+
+        const std::string& description() const noexcept { return _description; }
+        State state() const noexcept { return _state.load(std::memory_order_acquire); }
+        bool paused() const noexcept { return _paused.load(std::memory_order_relaxed); }
+        bool cancelled() const noexcept { return _cancelled.load(std::memory_order_relaxed); }
+        JobProgress progress() const;
+        std::string error() const;
+        virtual std::string summary() const { return {}; }
+
+        void pause();
+        void resume();
+        void cancel();
+
+        void execute(EventNotifier* notifier);
+
+    protected:
+        virtual void run() = 0;
+
+        void setTotals(std::uint64_t bytes, std::uint64_t files) noexcept;
+        void advance(std::uint64_t bytes, std::uint64_t files = 0) noexcept;
+        bool checkpoint();
+
+    private:
+        std::string _description;
+        std::atomic<EventNotifier*> _notifier;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _resumed;
+        std::string _error;
+        std::chrono::steady_clock::time_point _activeSince;
+        std::chrono::nanoseconds _activeBefore;
+
+        std::atomic<State> _state;
+        std::atomic<bool> _paused;
+        std::atomic<bool> _cancelled;
+        std::atomic<std::uint64_t> _bytesDone;
+        std::atomic<std::uint64_t> _bytesTotal;
+        std::atomic<std::uint64_t> _filesDone;
+        std::atomic<std::uint64_t> _filesTotal;
+        std::atomic<std::int64_t> _lastNotify;
+
+        void notify(bool always) noexcept;
+    };
+
+} // namespace core
+
+#endif // JOB_HPP
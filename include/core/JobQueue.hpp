@@ -0,0 +1,64 @@
+/**
+ * @file JobQueue.hpp
+ * @brief Declaration of the core::JobQueue class that runs file operations one after another in the background.
+ */
+
+#ifndef JOBQUEUE_HPP
+    #define JOBQUEUE_HPP
+
+    #include "core/EventNotifier.hpp"
+    #include "core/Job.hpp"
+
+    #include <condition_variable>
+    #include <cstddef>
+    #include <deque>
+    #include <memory>
+    #include <mutex>
+    #include <thread>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @class JobQueue
+     * @brief Runs submitted jobs in order on a worker thread of its own.
+     *
+     * Jobs run one at a time, so that two copies do not fight over the same disks; a job may
+     * still spread its own work over the shared thread pool. The worker is not one of the
+     * pool's, since a job blocks for as long as it runs. The last few finished jobs are kept so
+     * their outcome can be shown. Destroying the queue cancels every job and waits for the
+     * running one to stop.
+     */
+
+    class JobQueue {
+    public:
+        static constexpr std::size_t FINISHED_KEPT = 8;
+
+        explicit JobQueue(EventNotifier* notifier = nullptr);
+        ~JobQueue();
+
+        JobQueue(const JobQueue&) = delete;
+        JobQueue& operator=(const JobQueue&) = delete;
+
+        void submit(std::shared_ptr<Job> job);
+        std::shared_ptr<Job> current() const;
+        std::size_t queued() const;
+        std::shared_ptr<Job> lastFinished() const;
+
+    private:
+        EventNotifier* _notifier;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _ready;
+        std::deque<std::shared_ptr<Job>> _queue;
+        std::shared_ptr<Job> _running;
+        std::deque<std::shared_ptr<Job>> _finished;
+        bool _stopping;
+        std::thread _worker;
+
+        void work();
+    };
+
+} // namespace core
+
+#endif // JOBQUEUE_HPP
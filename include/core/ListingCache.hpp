@@ -0,0 +1,105 @@
+/**
+ * @file ListingCache.hpp
+ * @brief Declaration of the core::ListingCache class, an LRU cache of parsed directory listings.
+ */
+
+#ifndef LISTINGCACHE_HPP
+    #define LISTINGCACHE_HPP
+
+    #include "core/DirectoryStamp.hpp"
+    #include "core/DirectoryWatcher.hpp"
+    #include "core/EntryTable.hpp"
+    #include "core/ListingSorter.hpp"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <list>
+    #include <optional>
+    #include <string>
+    #include <unordered_map>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @struct CachedListing
+     * @brief A complete listing, the watch that keeps it honest, and the stamp it was taken at.
+     * generation is the watch's generation at the time the listing was known to be current,
+     * sorting the order the listing was left in.
+     */
+    struct CachedListing {
+        EntryTable entries;
+        std::vector<EntryTable::Index> order;
+        DirectoryStamp stamp;
+        int wd = -1;
+        std::uint64_t generation = 0;
+        SortOrder sorting = {};
+    };
+
+    /**
+     * @class ListingCache
+     * @brief Keeps the listings of recently left directories, least recently used first out.
+     *
+     * Each cached directory keeps its inotify watch. Any event on it bumps a generation
+     * counter, so a listing is only handed back if no event arrived since it was stored and
+     * the directory's mtime/ctime are unchanged. Lookup and hand-back are O(1): the listing
+     * is moved out, not copied. The cache is capped in bytes; evicting a listing removes
+     * its watch.
+     */
+
+    class ListingCache {
+    public:
+        static constexpr std::size_t DEFAULT_BYTE_BUDGET = 64 * 1024 * 1024;
+
+        struct Stats {
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+            std::size_t entries = 0;
+            std::size_t bytes = 0;
+            std::size_t byteBudget = 0;
+        };
+
+        ListingCache(DirectoryWatcher& watcher, std::size_t byteBudget = DEFAULT_BYTE_BUDGET);
+        ~ListingCache();
+
+        ListingCache(const ListingCache&) = delete;
+        ListingCache& operator=(const ListingCache&) = delete;
+
+        void store(const std::string& path, CachedListing listing);
+        std::optional<CachedListing> take(const std::string& path);
+        bool contains(const std::string& path) const;
+        bool ownsWatch(int wd) const noexcept;
+        static std::string keyOf(const std::string& path);
+
+        std::uint64_t generation(int wd) const noexcept;
+        void noteEvent(int wd) noexcept;
+        void clear();
+
+        void setByteBudget(std::size_t bytes);
+        Stats stats() const noexcept;
+
+    private:
+        struct Node {
+            std::string key;
+            CachedListing listing;
+            std::size_t bytes;
+        };
+
+        DirectoryWatcher& _watcher;
+        std::size_t _byteBudget;
+        std::size_t _bytes;
+        std::uint64_t _hits;
+        std::uint64_t _misses;
+
+        std::list<Node> _lru; // most recently stored first
+        std::unordered_map<std::string, std::list<Node>::iterator> _index;
+        std::unordered_map<int, std::uint64_t> _generations;
+
+        static std::size_t sizeOf(const Node& node) noexcept;
+        void erase(std::list<Node>::iterator it, bool keepWatch);
+        void evictToBudget();
+    };
+
+} // namespace core
+
+#endif // LISTINGCACHE_HPP
@@ -0,0 +1,61 @@
+/**
+ * @file ListingFilter.hpp
+ * @brief Declaration of the core::ListingFilter class that narrows a listing as a pattern is typed.
+ */
+
+#ifndef LISTINGFILTER_HPP
+    #define LISTINGFILTER_HPP
+
+    #include "core/EntryTable.hpp"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <string>
+    #include <string_view>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @class ListingFilter
+     * @brief Keeps the entries of a listing whose name contains a pattern, ignoring ASCII case.
+     * A pattern with '*' or '?' is a glob that can match anywhere in the name.
+     *
+     * Appending a character can only narrow the matches, so push() searches the previous match
+     * set rather than the whole listing, and keeps one match set per pattern length: pop() just
+     * drops the last one. When the listing itself changes, rebuild() starts over from it.
+     *
+     * When the candidates are a large part of the table, the needle is searched for in one SSE2
+     * pass over the contiguous name arena; otherwise each candidate name is searched on its own.
+     */
+
+    class ListingFilter {
+    public:
+        bool active() const noexcept { return !_pattern.empty(); }
+        const std::string& pattern() const noexcept { return _pattern; }
+        const std::vector<EntryTable::Index>& matches() const noexcept { return _levels.back().matches; }
+
+        void push(const EntryTable& table, const std::vector<EntryTable::Index>& order, char c);
+        void pop(const EntryTable& table, const std::vector<EntryTable::Index>& order);
+        void rebuild(const EntryTable& table, const std::vector<EntryTable::Index>& order);
+        void clear() noexcept;
+
+        static bool matchName(std::string_view name, std::string_view pattern) noexcept;
+
+    private:
+        struct Level {
+            std::size_t length;
+            std::vector<EntryTable::Index> matches;
+        };
+
+        std::string _pattern;
+        std::vector<Level> _levels;
+        std::vector<std::uint8_t> _hits;
+
+        void narrow(const EntryTable& table, const std::vector<EntryTable::Index>& candidates,
+                    std::vector<EntryTable::Index>& out);
+    };
+
+} // namespace core
+
+#endif // LISTINGFILTER_HPP
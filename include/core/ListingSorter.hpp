@@ -0,0 +1,91 @@
+/**
+ * @file ListingSorter.hpp
+ * @brief Declaration of the core::ListingSorter class that orders a listing by name, size, date or type.
+ */
+
+#ifndef LISTINGSORTER_HPP
+    #define LISTINGSORTER_HPP
+
+    #include "core/EntryTable.hpp"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <string_view>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @enum SortKey
+     * @brief What a listing is sorted by. SCAN keeps the order the kernel returned the entries in.
+     * SIZE and MTIME put the largest and the most recent entries first.
+     */
+    enum class SortKey : std::uint8_t {
+        SCAN,
+        NAME,
+        EXTENSION,
+        TYPE,
+        SIZE,
+        MTIME
+    };
+
+    constexpr int SORT_KEY_COUNT = 6;
+
+    /**
+     * @struct SortOrder
+     * @brief A sort key, and whether directories come before everything else.
+     */
+    struct SortOrder {
+        SortKey key = SortKey::SCAN;
+        bool directoriesFirst = false;
+
+        bool operator==(const SortOrder&) const = default;
+    };
+
+    /**
+     * @class ListingSorter
+     * @brief Sorts the display order of an EntryTable.
+     *
+     * Every entry gets a compact sort key up front: the primary criterion packed into one integer,
+     * and the first 16 bytes of its name in natural form ("file2" before "file10", case folded).
+     * Comparisons only go back to the full name when two keys tie. Names break ties for every key
+     * but SCAN, and the table index breaks the remaining ones, so the order is total: sorting is
+     * stable, and switching back to a key gives back exactly the order it gave before.
+     *
+     * Large listings are sorted in chunks on the shared ThreadPool, then merged.
+     */
+
+    class ListingSorter {
+    public:
+        static constexpr std::size_t PARALLEL_THRESHOLD = 64 * 1024;
+
+        static void sort(const EntryTable& table, std::vector<EntryTable::Index>& order, SortOrder sortOrder);
+        static std::size_t position(const EntryTable& table, const std::vector<EntryTable::Index>& order,
+                                    EntryTable::Index i, SortOrder sortOrder);
+        static bool dependsOnStat(SortOrder sortOrder) noexcept;
+
+    private:
+        struct Key {
+            std::uint64_t primary;
+            std::uint64_t prefix[2];
+            EntryTable::Index index;
+        };
+
+        class Less {
+        public:
+            Less(const EntryTable& table, SortOrder sortOrder) : _table(table), _byName(sortOrder.key != SortKey::SCAN) {}
+
+            bool operator()(const Key& a, const Key& b) const noexcept;
+
+        private:
+            const EntryTable& _table;
+            bool _byName;
+        };
+
+        static Key makeKey(const EntryTable& table, EntryTable::Index i, SortOrder sortOrder) noexcept;
+        static int compareNames(std::string_view a, std::string_view b) noexcept;
+    };
+
+} // namespace core
+
+#endif // LISTINGSORTER_HPP
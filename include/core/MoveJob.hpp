@@ -0,0 +1,56 @@
+/**
+ * @file MoveJob.hpp
+ * @brief Declaration of the core::MoveJob class that moves a file or a directory tree in the background.
+ */
+
+#ifndef MOVEJOB_HPP
+    #define MOVEJOB_HPP
+
+    #include "core/Job.hpp"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <string>
+
+namespace core {
+
+    /**
+     * @class MoveJob
+     * @brief Moves a file or a directory tree into a directory, never over what is there already.
+     *
+     * A rename within a file system; across file systems, a copy under a hidden name that an
+     * interrupted move carries on from, with each source unlinked once its copy is complete.
+     */
+
+    class MoveJob : public Job {
+    public:
+        static constexpr std::size_t CHUNK_SIZE = 1024 * 1024;
+        static constexpr std::size_t RANGE_CHUNK_SIZE = 16 * 1024 * 1024;
+        static constexpr const char* PARTIAL_PREFIX = ".fman-move.";
+        static constexpr const char* ORIGIN_ATTRIBUTE = "user.fman.origin";
+
+        MoveJob(std::string description, std::string source, const std::string& destinationDirectory);
+
+        const std::string& destination() const noexcept { return _destination; }
+
+    protected:
+        void run() override;
+
+    private:
+        std::string _source;
+        std::string _destination;
+        std::string _partial;
+        bool _rangeUnsupported;
+
+        void moveDirectory(int sourceDir, int destinationDir, const std::string& path);
+        void moveEntry(int sourceDir, int destinationDir, const char* name, const char* destination,
+                       const std::string& path);
+        void moveFile(int sourceDir, int destinationDir, const char* name, const char* destination,
+                      const std::string& path);
+        bool copyRange(int in, int out, std::uint64_t& offset, std::uint64_t size);
+        void copyBuffered(int in, int out, std::uint64_t& offset, std::uint64_t size);
+    };
+
+} // namespace core
+
+#endif // MOVEJOB_HPP
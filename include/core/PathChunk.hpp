@@ -0,0 +1,64 @@
+/**
+ * @file PathChunk.hpp
+ * @brief Declaration of the core::PathChunk and core::PathChunkBuilder structures that hold paths column by column.
+ */
+
+#ifndef PATHCHUNK_HPP
+    #define PATHCHUNK_HPP
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <memory>
+    #include <string_view>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @struct PathChunk
+     * @brief A few thousand paths, relative to the walked root, packed NUL-terminated in one arena.
+     *
+     * Each path also carries where its last component starts, and a 64-bit mask of the characters
+     * it contains (see PathIndex::charMask) so that searches can reject it without reading it.
+     * The columns are read-only views: storage keeps them alive, whether they were built in
+     * memory or are mapped from an index file. A chunk is immutable once published.
+     */
+    struct PathChunk {
+        const char* bytes = nullptr;
+        std::size_t byteCount = 0;
+        const std::uint32_t* offsets = nullptr;
+        const std::uint16_t* lengths = nullptr;
+        const std::uint16_t* nameStarts = nullptr;
+        const std::uint64_t* masks = nullptr;
+        const std::uint8_t* directories = nullptr;
+        std::size_t count = 0;
+        std::shared_ptr<const void> storage;
+
+        std::size_t size() const noexcept { return count; }
+        std::string_view path(std::size_t i) const noexcept { return { bytes + offsets[i], lengths[i] }; }
+        std::string_view name(std::size_t i) const noexcept { return path(i).substr(nameStarts[i]); }
+        bool isDirectory(std::size_t i) const noexcept { return directories[i] != 0; }
+    };
+
+    /**
+     * @struct PathChunkBuilder
+     * @brief Gathers paths into the columns of a PathChunk.
+     */
+    struct PathChunkBuilder {
+        std::vector<char> bytes;
+        std::vector<std::uint32_t> offsets;
+        std::vector<std::uint16_t> lengths;
+        std::vector<std::uint16_t> nameStarts;
+        std::vector<std::uint64_t> masks;
+        std::vector<std::uint8_t> directories;
+
+        std::size_t size() const noexcept { return offsets.size(); }
+        std::string_view path(std::size_t i) const noexcept { return { bytes.data() + offsets[i], lengths[i] }; }
+
+        void add(std::string_view path, bool directory);
+        std::shared_ptr<const PathChunk> publish();
+    };
+
+} // namespace core
+
+#endif // PATHCHUNK_HPP
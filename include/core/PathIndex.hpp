@@ -0,0 +1,96 @@
+/**
+ * @file PathIndex.hpp
+ * @brief Declaration of the core::PathIndex class that collects every path under a directory in the background.
+ */
+
+#ifndef PATHINDEX_HPP
+    #define PATHINDEX_HPP
+
+    #include "core/EventNotifier.hpp"
+    #include "core/PathChunk.hpp"
+    #include "core/PathIndexFile.hpp"
+    #include "core/ThreadPool.hpp"
+
+    #include <atomic>
+    #include <condition_variable>
+    #include <cstddef>
+    #include <cstdint>
+    #include <memory>
+    #include <mutex>
+    #include <string>
+    #include <string_view>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @class PathIndex
+     * @brief Walks a directory tree on the shared thread pool, one task per directory.
+     *
+     * Paths are gathered in PathChunks and published as soon as a chunk fills up, so a search can
+     * start on the first ones while the walk is still running. snapshot() hands out the chunks
+     * published so far; they stay valid as long as the snapshot is held, even after the index is gone.
+     * Symbolic links are listed but not followed. Destroying the index stops the walk and waits for it.
+     *
+     * The last complete walk of a root is saved as a PathIndexFile. When there is one, its chunks
+     * are the snapshot from the start, and the walk only lists the directories that changed since,
+     * reusing the stored entries of the others. The fresh chunks then replace the stored ones in
+     * one go, which bumps generation(), and are saved in turn.
+     */
+
+    class PathIndex {
+    public:
+        using Snapshot = std::vector<std::shared_ptr<const PathChunk>>;
+
+        static constexpr std::size_t CHUNK_PATHS = 4096;
+
+        explicit PathIndex(const std::string& root, EventNotifier* notifier = nullptr,
+                           ThreadPool& pool = ThreadPool::shared());
+        ~PathIndex();
+
+        PathIndex(const PathIndex&) = delete;
+        PathIndex& operator=(const PathIndex&) = delete;
+
+        const std::string& root() const noexcept { return _root; }
+        Snapshot snapshot() const;
+        std::size_t chunkCount() const;
+        std::size_t pathCount() const noexcept { return _paths.load(std::memory_order_relaxed); }
+        std::size_t generation() const;
+        bool finished() const noexcept { return _finished.load(std::memory_order_acquire); }
+        bool stored() const noexcept { return _stored != nullptr; }
+
+        static std::uint64_t charMask(std::string_view text) noexcept;
+
+    private:
+        std::string _root;
+        int _rootFd;
+        EventNotifier* _notifier;
+        ThreadPool& _pool;
+        std::int64_t _started;
+
+        std::shared_ptr<const PathIndexFile> _stored;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _idle;
+        Snapshot _chunks;
+        Snapshot _fresh;
+        PathChunkBuilder _open;
+        std::vector<IndexedDirectory> _walked;
+        std::uint64_t _committed;
+        std::size_t _generation;
+        std::size_t _pending;
+
+        std::atomic<bool> _cancelled;
+        std::atomic<bool> _finished;
+        std::atomic<std::size_t> _paths;
+
+        void start(std::string relative);
+        void walk(const std::string& relative);
+        void commit(PathChunkBuilder& local, IndexedDirectory* walked);
+        void publishOpen();
+        void finish();
+    };
+
+} // namespace core
+
+#endif // PATHINDEX_HPP
@@ -0,0 +1,104 @@
+/**
+ * @file PathIndexFile.hpp
+ * @brief Declaration of the core::PathIndexFile class, a PathIndex saved to disk and searched in place.
+ */
+
+#ifndef PATHINDEXFILE_HPP
+    #define PATHINDEXFILE_HPP
+
+    #include "core/DirectoryStamp.hpp"
+    #include "core/PathChunk.hpp"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <memory>
+    #include <string>
+    #include <string_view>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @struct IndexedDirectory
+     * @brief What a walk saw of one directory: its stamp, and which run of the index's paths
+     * holds its entries. Paths are numbered across chunks, in chunk order.
+     */
+    struct IndexedDirectory {
+        std::string path;
+        DirectoryStamp stamp;
+        std::uint64_t firstPath;
+        std::uint64_t entryCount;
+    };
+
+    /**
+     * @class PathIndexFile
+     * @brief The index of a tree, stored under the XDG cache directory and mapped read-only.
+     *
+     * The file is laid out like the chunks in memory, each column aligned, so chunks() hands out
+     * PathChunks that point straight into the mapping: opening costs one mmap and a check of the
+     * chunk table, whatever the number of paths. The directories walked are stored sorted by path
+     * with their stamp, so the next walk only lists the ones that changed.
+     *
+     * A file whose magic, version, byte order or root does not match is ignored. Files are written
+     * aside and renamed into place, so a reader never sees a partial one.
+     */
+
+    class PathIndexFile : public std::enable_shared_from_this<PathIndexFile> {
+    public:
+        static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+        struct Header;
+        struct ChunkRecord;
+        struct DirectoryRecord;
+
+        ~PathIndexFile();
+
+        PathIndexFile(const PathIndexFile&) = delete;
+        PathIndexFile& operator=(const PathIndexFile&) = delete;
+
+        static std::shared_ptr<const PathIndexFile> open(const std::string& root, std::size_t chunkPaths);
+        static bool write(const std::string& root, const std::vector<std::shared_ptr<const PathChunk>>& chunks,
+                          std::size_t chunkPaths, std::vector<IndexedDirectory> directories);
+        static std::string location(const std::string& root);
+
+        std::size_t pathCount() const noexcept;
+        std::vector<std::shared_ptr<const PathChunk>> chunks() const;
+        const DirectoryRecord* findDirectory(std::string_view path) const noexcept;
+        bool unchanged(const DirectoryRecord& directory, const DirectoryStamp& stamp) const noexcept;
+
+        /**
+         * @brief Calls onEntry(std::string_view path, bool directory) for each entry of a stored directory.
+         */
+        template <typename Fn>
+        void forEachEntry(const DirectoryRecord& directory, Fn&& onEntry) const;
+
+    private:
+        const char* _data;
+        std::size_t _size;
+        std::size_t _chunkPaths;
+        const Header* _header;
+        const ChunkRecord* _chunks;
+        const DirectoryRecord* _directories;
+
+        PathIndexFile(const char* data, std::size_t size, std::size_t chunkPaths);
+
+        bool validate(const std::string& root) noexcept;
+        std::string_view directoryPath(const DirectoryRecord& directory) const noexcept;
+        std::string_view entryPath(std::uint64_t ordinal, bool& directory) const noexcept;
+        std::pair<std::uint64_t, std::uint64_t> entryRange(const DirectoryRecord& directory) const noexcept;
+    };
+
+    template <typename Fn>
+    void PathIndexFile::forEachEntry(const DirectoryRecord& directory, Fn&& onEntry) const
+    {
+        auto [first, last] = entryRange(directory);
+        for (std::uint64_t ordinal = first; ordinal < last; ++ordinal) {
+            bool isDirectory = false;
+            std::string_view path = entryPath(ordinal, isDirectory);
+            onEntry(path, isDirectory);
+        }
+    }
+
+} // namespace core
+
+#endif // PATHINDEXFILE_HPP
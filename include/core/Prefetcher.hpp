@@ -0,0 +1,93 @@
+/**
+ * @file Prefetcher.hpp
+ * @brief Declaration of the core::Prefetcher class that warms up what the cursor is resting on.
+ */
+
+#ifndef PREFETCHER_HPP
+    #define PREFETCHER_HPP
+
+    #include "core/DirectoryWatcher.hpp"
+    #include "core/EventNotifier.hpp"
+    #include "core/ListingCache.hpp"
+
+    #include <atomic>
+    #include <chrono>
+    #include <condition_variable>
+    #include <cstdint>
+    #include <mutex>
+    #include <string>
+    #include <thread>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @struct PrefetchResult
+     * @brief A listing scanned ahead of time, with the watch placed for it.
+     * When complete is false the scan was cancelled and only the watch needs disposing of.
+     */
+    struct PrefetchResult {
+        std::string path;
+        CachedListing listing;
+        bool complete = false;
+    };
+
+    /**
+     * @class Prefetcher
+     * @brief A low-priority worker that pre-scans the highlighted directory, or asks the kernel to
+     * read ahead the highlighted small file.
+     *
+     * Only the latest request matters: a new one cancels the scan in flight. Work starts once a
+     * request has been left alone for a settle delay, and scans are spaced by a minimum interval,
+     * so scrolling through many folders does not start a scan for each of them.
+     * The worker never touches the cache: finished listings are picked up with collect() on the
+     * caller's thread, which decides what to keep and which watches to drop; an optional
+     * notifier tells it when there is something to collect.
+     */
+
+    class Prefetcher {
+    public:
+        static constexpr std::uint64_t SMALL_FILE_LIMIT = 1024 * 1024;
+        static constexpr std::size_t MAX_ENTRIES = 1'000'000;
+
+        explicit Prefetcher(DirectoryWatcher& watcher, EventNotifier* notifier = nullptr,
+                            std::chrono::milliseconds settleDelay = std::chrono::milliseconds(150),
+                            std::chrono::milliseconds minInterval = std::chrono::milliseconds(100));
+        ~Prefetcher();
+
+        Prefetcher(const Prefetcher&) = delete;
+        Prefetcher& operator=(const Prefetcher&) = delete;
+
+        void prefetchDirectory(const std::string& path);
+        void prefetchFile(const std::string& path);
+        void cancel();
+
+        std::vector<PrefetchResult> collect();
+
+    private:
+        enum class Kind { NONE, DIRECTORY, FILE };
+
+        DirectoryWatcher& _watcher;
+        EventNotifier* _notifier;
+        std::chrono::milliseconds _settleDelay;
+        std::chrono::milliseconds _minInterval;
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        Kind _kind;
+        std::string _target;
+        std::atomic<std::uint64_t> _generation;
+        bool _stopping;
+        std::vector<PrefetchResult> _results;
+        std::thread _thread;
+
+        void request(Kind kind, const std::string& path);
+        bool stale(std::uint64_t generation) const noexcept;
+        void run();
+        void scanDirectory(const std::string& path, std::uint64_t generation);
+        void readAhead(const std::string& path);
+    };
+
+} // namespace core
+
+#endif // PREFETCHER_HPP
@@ -0,0 +1,76 @@
+/**
+ * @file SpscQueue.hpp
+ * @brief Declaration of the core::SpscQueue class template, a bounded lock-free single-producer single-consumer queue.
+ */
+
+#ifndef SPSCQUEUE_HPP
+    #define SPSCQUEUE_HPP
+
+    #include <atomic>
+    #include <cstddef>
+    #include <utility>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @class SpscQueue
+     * @brief A fixed-capacity ring buffer for handing items from one thread to exactly one other.
+     *
+     * Head and tail sit on separate cache lines; each side only writes its own index and
+     * publishes it with release ordering, so no lock is ever taken.
+     */
+
+    template <typename T>
+    class SpscQueue {
+    public:
+        explicit SpscQueue(std::size_t capacity)
+        {
+            std::size_t size = 2;
+
+            while (size < capacity)
+                size <<= 1;
+            _slots.resize(size);
+            _mask = size - 1;
+        }
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        bool tryPush(T&& item)
+        {
+            std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+            if (tail - _head.load(std::memory_order_acquire) > _mask)
+                return false;
+            _slots[tail & _mask] = std::move(item);
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool tryPop(T& item)
+        {
+            std::size_t head = _head.load(std::memory_order_relaxed);
+
+            if (head == _tail.load(std::memory_order_acquire))
+                return false;
+            item = std::move(_slots[head & _mask]);
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool empty() const noexcept
+        {
+            return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+        }
+
+    private:
+        std::vector<T> _slots;
+        std::size_t _mask;
+        alignas(64) std::atomic<std::size_t> _head { 0 };
+        alignas(64) std::atomic<std::size_t> _tail { 0 };
+    };
+
+} // namespace core
+
+#endif // SPSCQUEUE_HPP
@@ -0,0 +1,72 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief Declaration of the core::ThreadPool class, a fixed set of worker threads shared by background jobs.
+ */
+
+#ifndef THREADPOOL_HPP
+    #define THREADPOOL_HPP
+
+    #include <atomic>
+    #include <condition_variable>
+    #include <cstddef>
+    #include <deque>
+    #include <functional>
+    #include <memory>
+    #include <mutex>
+    #include <thread>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @class ThreadPool
+     * @brief Runs tasks on one worker per core.
+     *
+     * Each worker keeps a deque of its own: a task submitted from a worker goes on that worker's
+     * deque, which it takes from the back, so that a walk that submits its subdirectories goes
+     * depth first, while an idle worker steals from the front of another's, where the oldest and
+     * largest pieces of work wait. A task submitted from any other thread goes on a shared queue,
+     * which workers look at first. parallelFor() splits a loop over the workers and the calling
+     * thread, and jumps the shared queue, since someone is waiting on it. Tasks still queued when
+     * the pool is destroyed are dropped, so whoever submits tasks waits for them first.
+     */
+
+    class ThreadPool {
+    public:
+        explicit ThreadPool(std::size_t threads = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        static ThreadPool& shared();
+
+        std::size_t size() const noexcept { return _workers.size(); }
+
+        void submit(std::function<void()> task);
+        void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body);
+
+    private:
+        struct Deque {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::thread> _workers;
+        std::vector<std::unique_ptr<Deque>> _deques;
+        std::deque<std::function<void()>> _tasks;
+        std::mutex _mutex;
+        std::condition_variable _ready;
+        std::atomic<std::size_t> _queued;
+        std::atomic<std::size_t> _shared;
+        std::atomic<std::size_t> _sleeping;
+        std::atomic<bool> _stopping;
+
+        void wake();
+        bool take(std::size_t index, std::function<void()>& task);
+        void work(std::size_t index);
+    };
+
+} // namespace core
+
+#endif // THREADPOOL_HPP
@@ -0,0 +1,72 @@
+/**
+ * @file UsageCache.hpp
+ * @brief Declaration of the core::UsageCache class, the last known disk usage of each directory sized.
+ */
+
+#ifndef USAGECACHE_HPP
+    #define USAGECACHE_HPP
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <mutex>
+    #include <optional>
+    #include <string>
+    #include <unordered_map>
+
+namespace core {
+
+    /**
+     * @struct UsageTotals
+     * @brief What a tree holds: the apparent size of its entries, the space they take on disk,
+     * and how many files and subdirectories it counts.
+     */
+    struct UsageTotals {
+        std::uint64_t bytes = 0;
+        std::uint64_t allocated = 0;
+        std::uint64_t files = 0;
+        std::uint64_t directories = 0;
+
+        UsageTotals& operator+=(const UsageTotals& other) noexcept
+        {
+            bytes += other.bytes;
+            allocated += other.allocated;
+            files += other.files;
+            directories += other.directories;
+            return *this;
+        }
+    };
+
+    /**
+     * @class UsageCache
+     * @brief Keeps the totals of every directory a DiskUsage walk completed, by canonical path.
+     *
+     * A walk stores every directory of the tree it sizes, not only its root, so sizing a
+     * subdirectory later has totals to show straight away, while the new walk runs. Entries are
+     * not checked against the disk: they are the last known totals, not current ones. Past
+     * ENTRY_LIMIT directories, only the ones already known are updated.
+     */
+
+    class UsageCache {
+    public:
+        static constexpr std::size_t ENTRY_LIMIT = 1024 * 1024;
+
+        UsageCache() = default;
+        ~UsageCache() = default;
+
+        UsageCache(const UsageCache&) = delete;
+        UsageCache& operator=(const UsageCache&) = delete;
+
+        void store(const std::string& key, const UsageTotals& totals);
+        std::optional<UsageTotals> find(const std::string& key) const;
+        std::size_t size() const;
+        void clear();
+        static std::string keyOf(const std::string& path);
+
+    private:
+        mutable std::mutex _mutex;
+        std::unordered_map<std::string, UsageTotals> _entries;
+    };
+
+} // namespace core
+
+#endif // USAGECACHE_HPP
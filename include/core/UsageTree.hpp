@@ -0,0 +1,95 @@
+/**
+ * @file UsageTree.hpp
+ * @brief Declaration of the core::UsageTree class, the sized entries of a directory tree in flat arrays.
+ */
+
+#ifndef USAGETREE_HPP
+    #define USAGETREE_HPP
+
+    #include "core/DiskUsage.hpp"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <memory>
+    #include <string>
+    #include <string_view>
+    #include <vector>
+
+namespace core {
+
+    /**
+     * @class UsageTree
+     * @brief Every entry of a sized tree, files included, with the totals of each directory.
+     *
+     * Entries are 40-byte records in one array, numbered breadth first from the root, so the
+     * children of a directory are one contiguous run; names share a single buffer. A directory
+     * is browsed without walking anything again.
+     *
+     * remove() drops an entry and takes its size off every ancestor. graft() replaces the
+     * subtree of a directory by a fresh walk of it, appended to the arrays, and patches the
+     * ancestors the same way; what was replaced or removed stays in the arrays until the tree
+     * is saved, which only writes what is still reachable.
+     *
+     * The file drops the links between entries, rebuilt from the breadth-first order and the
+     * child counts on load, which leaves 28 bytes per entry plus its name. A file whose magic,
+     * version, byte order or sizes do not add up is refused.
+     */
+
+    class UsageTree {
+    public:
+        using Index = std::uint32_t;
+
+        static constexpr Index ROOT = 0;
+        static constexpr Index npos = static_cast<Index>(-1);
+        static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+        enum Flag : std::uint16_t {
+            DIRECTORY = 1 << 0,
+            REMOVED = 1 << 1,
+            DUPLICATE = 1 << 2,
+            UNREADABLE = 1 << 3
+        };
+
+        struct Entry {
+            std::uint64_t bytes;
+            std::uint64_t allocated;
+            // Entries under this one, itself left out
+            std::uint32_t items;
+            Index parent;
+            Index firstChild;
+            std::uint32_t childCount;
+            std::uint32_t nameOffset;
+            std::uint16_t nameLength;
+            std::uint16_t flags;
+        };
+
+        explicit UsageTree(const DiskUsage& usage);
+        ~UsageTree() = default;
+
+        static std::unique_ptr<UsageTree> load(const std::string& path);
+        bool save(const std::string& path) const;
+
+        const std::string& root() const noexcept { return _root; }
+        const Entry& entry(Index index) const noexcept { return _entries[index]; }
+        std::string_view name(Index index) const noexcept;
+        std::string path(Index index) const;
+        bool isDirectory(Index index) const noexcept { return _entries[index].flags & DIRECTORY; }
+        std::vector<Index> children(Index directory) const;
+        std::size_t memoryUsage() const noexcept;
+
+        void remove(Index index);
+        void graft(Index directory, const UsageTree& scan);
+
+    private:
+        std::string _root;
+        std::vector<Entry> _entries;
+        std::string _names;
+
+        UsageTree() = default;
+
+        void addToAncestors(Index index, std::uint64_t bytes, std::uint64_t allocated, std::uint32_t items);
+    };
+
+} // namespace core
+
+#endif // USAGETREE_HPP
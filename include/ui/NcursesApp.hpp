@@ -7,11 +7,19 @@
     #define NCURSESAPP_HPP
 
     #include "ui/NcursesManager.hpp"
+    #include "core/EventNotifier.hpp"
+    #include "core/JobQueue.hpp"
+    #include "core/UsageCache.hpp"
     #include "views/ViewType.hpp"
     #include "views/IView.hpp"
     #include "views/SidebarView.hpp"
     #include "views/ExplorerView.hpp"
     #include "views/FileInfoView.hpp"
+    #include "views/FinderView.hpp"
+    #include "views/GrepView.hpp"
+    #include "views/UsageView.hpp"
+    #include "views/ReportView.hpp"
+    #include "views/StatusBarView.hpp"
 
     #include <memory>
     #include <functional>
@@ -40,6 +48,9 @@ namespace ui {
      *
      * This class provides methods for running the application, handling user input,
      * updating the UI, and managing the ncurses library.
+     * The loop sleeps in poll() until a key arrives, the terminal is resized, a background
+     * worker signals the notifier, or one of the current view's descriptors becomes readable.
+     * File operations run on the job queue; the status bar shows them under every view.
      */
 
     class NcursesApp {
@@ -51,15 +62,30 @@ namespace ui {
 
         void setSelectedFile(std::shared_ptr<core::File> file);
         std::shared_ptr<core::File> getSelectedFile() const;
+        core::EventNotifier& getNotifier() { return _notifier; }
+        core::JobQueue& getJobs() { return _jobs; }
 
     protected:
     private:
         NcursesWrapper _wrapper;
         NcursesManager _manager;
+        core::EventNotifier _notifier;
+        core::UsageCache _usageCache;
+        // Declared after the notifier, so that the running job is stopped before the notifier goes
+        core::JobQueue _jobs;
+        int _resizeFd;
 
         std::mutex _fileMutex;
         std::shared_ptr<core::File> _selectedFile;
-        std::unique_ptr<IView> _currentView;
+        std::unique_ptr<SidebarView> _menuView;
+        std::unique_ptr<ExplorerView> _explorerView;
+        std::unique_ptr<FileInfoView> _fileInfoView;
+        std::unique_ptr<FinderView> _finderView;
+        std::unique_ptr<GrepView> _grepView;
+        std::unique_ptr<UsageView> _usageView;
+        std::unique_ptr<ReportView> _reportView;
+        std::unique_ptr<StatusBarView> _statusBar;
+        IView* _currentView;
         bool _running;
 
         std::vector<MenuOption> _menuOptions;
@@ -67,6 +93,8 @@ namespace ui {
 
         void switchView(ViewType type);
         void handleUserInput();
+        void waitForEvents();
+        void handleResize();
         void update();
         void initLayout();
     };
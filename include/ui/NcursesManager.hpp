@@ -7,6 +7,7 @@
     #define NCURSES_MANAGER_HPP
 
     #include "NcursesWrapper.hpp"
+    #include "WindowCanvas.hpp"
 
     #include <vector>
     #include <map>
@@ -27,6 +28,8 @@ namespace ui {
      * This class provides methods for initializing and terminating the ncurses library,
      * creating and destroying windows, drawing borders, updating windows, printing text,
      * clearing windows, and refreshing the screen.
+     * Each registered window has a WindowCanvas; refreshAll() pushes every window to the
+     * terminal in a single update.
      */
 
     class NcursesManager {
@@ -38,10 +41,13 @@ namespace ui {
         void drawText(int winIndex, int y, int x, const std::string& text);
         void clearWindow(int winIndex);
         void refreshAll();
+        void touchAll();
 
         void registerWindow(WindowRole role, WINDOW* window);
+        WINDOW* placeWindow(WindowRole role, int height, int width, int startY, int startX);
         WINDOW* createAndRegisterWindow(WindowRole role, int height, int width, int startY, int startX);
         WINDOW* getWindow(WindowRole role);
+        WindowCanvas& getCanvas(WindowRole role);
 
         NcursesWrapper& getWrapper() { return _wrapper; }
 
@@ -49,6 +55,7 @@ namespace ui {
         NcursesWrapper& _wrapper;
         std::vector<WINDOW*> _windows;
         std::map<WindowRole, WINDOW*> _roleMap;
+        std::map<WindowRole, WindowCanvas> _canvases;
     };
     
 } // namespace ui
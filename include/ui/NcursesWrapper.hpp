@@ -35,9 +35,12 @@ namespace ui {
         void destroyWindow(WINDOW* window);
         void clearWindow(WINDOW* window);
         void refreshWindow(WINDOW* window);
+        void stageWindow(WINDOW* window);
+        void updateScreen();
         void drawTextInWindow(WINDOW* window, int y, int x, const std::string& text);
 
         int getChar();
+        void resize();
     
     protected:
     private:
@@ -0,0 +1,62 @@
+/**
+ * @file WindowCanvas.hpp
+ * @brief Declaration of the ui::WindowCanvas class that redraws only the rows of a window that changed.
+ */
+
+#ifndef WINDOW_CANVAS_HPP
+    #define WINDOW_CANVAS_HPP
+
+    #include <ncurses.h>
+    #include <string>
+    #include <string_view>
+    #include <vector>
+
+namespace ui {
+
+    /**
+     * @class WindowCanvas
+     * @brief A row model of what a window shows.
+     *
+     * A view describes a whole frame with begin(), box() and text(). present() compares it row by
+     * row with the previous frame and only rewrites the rows that differ. The manager then stages
+     * every window with wnoutrefresh and pushes them all in a single doupdate.
+     * A row that was drawn into directly, outside the canvas, is rewritten as well.
+     */
+
+    class WindowCanvas {
+    public:
+        explicit WindowCanvas(WINDOW* window);
+
+        void begin();
+        void box();
+        void text(int y, int x, std::string_view text, attr_t attrs = A_NORMAL);
+
+        void present();
+        void invalidate();
+
+        WINDOW* window() const { return _window; }
+
+    private:
+        struct Span {
+            int x;
+            attr_t attrs;
+            std::string text;
+
+            bool operator==(const Span&) const = default;
+        };
+        using Row = std::vector<Span>;
+
+        WINDOW* _window;
+        bool _framed = false;
+        bool _boxed = false;
+        bool _shownBoxed = false;
+        bool _invalid = true;
+        std::vector<Row> _pending;
+        std::vector<Row> _shown;
+
+        void drawRow(int y, int height, int width);
+    };
+
+} // namespace ui
+
+#endif // WINDOW_CANVAS_HPP
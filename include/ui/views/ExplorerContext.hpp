@@ -15,7 +15,7 @@ namespace ui {
     /**
      * @struct ExplorerContext
      * @brief A structure that holds the context for the explorer view, including the manager, app, directory,
-     * file names, selected index, switch callback, and copied path.
+     * file names, selected index, switch callback, and copied path, with whether it was cut.
      *
      * This structure is used to pass necessary information to the explorer view and its associated actions.
      */
@@ -23,10 +23,11 @@ namespace ui {
         NcursesManager& manager;
         NcursesApp& app;
         core::Directory& directory;
-        std::vector<std::string>& fileNames;
+        core::NameSpan& fileNames;
         int& selectedIndex;
         std::function<void(ViewType)> switchCallback;
         std::optional<std::string>& copiedPath;
+        bool& cutPending;
     };
 
 } // namespace ui
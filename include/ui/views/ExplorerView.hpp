@@ -21,6 +21,10 @@ namespace ui {
      * @brief A class that represents the explorer view in the application.
      *
      * This class provides methods for handling user input and updating the explorer view.
+     * Only the rows that fit in the window are drawn; a scroll offset keeps the selection in view.
+     * 's' cycles through the sort keys and 'S' toggles directories first. '/' opens a filter
+     * prompt that narrows the listing as the pattern is typed. 'f' opens the finder and 'g' the
+     * content search on the current directory; jumpTo() brings the explorer to the path picked there.
      */
     class ExplorerView : public IView {
     public:
@@ -28,13 +32,22 @@ namespace ui {
 
         void handleInput(int ch) override;
         void update() override;
+        void pollFds(std::vector<int>& fds) const override;
+
+        const std::string& currentPath() const { return _directory.getPath(); }
+        void jumpTo(const std::string& path);
 
     protected:
     private:
         core::Directory _directory;
-        std::vector<std::string> _fileNames;
+        core::NameSpan _fileNames;
         std::optional<std::string> _copiedPath;
+        bool _cutPending;
+        std::optional<std::string> _pendingSelection;
         int _selectedIndex;
+        int _scrollOffset;
+        int _pageSize;
+        bool _filtering;
 
         NcursesManager& _manager;
         NcursesApp& _parent;
@@ -44,6 +57,12 @@ namespace ui {
         std::function<void(ViewType)> _switchCallback;
 
         void enterSelected();
+        void showInfo();
+        void changeSortOrder(core::SortOrder order);
+        bool handleFilterInput(int ch);
+        void keepSelection(const std::function<void()>& change);
+        void moveSelection(int delta);
+        void scrollToSelection(int rows);
     
     };
 
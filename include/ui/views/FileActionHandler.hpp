@@ -2,6 +2,7 @@
 
 #include "ExplorerContext.hpp"
 #include <string>
+#include <string_view>
 
 namespace ui {
 
@@ -11,12 +12,13 @@ namespace ui {
      *
      * This class provides methods for creating, deleting, renaming, zipping, unzipping,
      * navigating directories, copying, and pasting files in the explorer view.
+     * Deleting, zipping, unzipping and pasting run as jobs on the application's job queue.
      */
     class FileActionHandler {
     public:
         FileActionHandler(ExplorerContext& context);
 
-        bool isArchive(const std::string& name);
+        bool isArchive(std::string_view name);
 
         void createNewFile();
         void createNewDirectory();
@@ -26,7 +28,11 @@ namespace ui {
         void unzipSelected();
         void goBackToParent();
         void copySelected();
-        void pasteCopied();
+        void cutSelected();
+        void pasteCopied(bool checksum = false);
+        void toggleJobPause();
+        void cancelJob();
+        void refreshListing(const std::string& selectName = "");
 
     private:
         ExplorerContext& _ctx;
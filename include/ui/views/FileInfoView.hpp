@@ -7,11 +7,16 @@
     #define FILEINFOVIEW_HPP
 
     #include "ui/NcursesManager.hpp"
+    #include "core/DiskUsage.hpp"
+    #include "core/EventNotifier.hpp"
     #include "core/File.hpp"
+    #include "core/UsageCache.hpp"
     #include "IView.hpp"
     #include "ViewType.hpp"
 
     #include <functional>
+    #include <memory>
+    #include <optional>
 
 namespace ui {
 
@@ -20,10 +25,13 @@ namespace ui {
      * @brief A class that represents the file information view in the application.
      *
      * This class provides methods for handling user input and updating the file information view.
+     * The size of a directory is that of everything under it, added up in the background; the
+     * running totals are shown while the walk goes on, along with the last ones known, if any.
      */
     class FileInfoView : public IView {
     public:
-        FileInfoView(NcursesManager& manager, const core::File& file, std::function<void(ViewType)> switchCallback);
+        FileInfoView(NcursesManager& manager, const core::File& file, core::UsageCache& usageCache,
+                     core::EventNotifier* notifier, std::function<void(ViewType)> switchCallback);
 
         void handleInput(int ch) override;
         void update() override;
@@ -33,9 +41,12 @@ namespace ui {
         NcursesManager& _manager;
         std::function<void(ViewType)> _switchCallback;
         core::File _file;
+        std::unique_ptr<core::DiskUsage> _usage;
+        std::optional<core::UsageTotals> _lastUsage;
 
         std::string formatSize(std::uintmax_t size) const;
         std::string formatTime(std::time_t time) const;
+        void drawUsage(WindowCanvas& canvas) const;
     };
 
 } // namespace ui
@@ -0,0 +1,70 @@
+/**
+ * @file FinderView.hpp
+ * @brief Declaration of the ui::FinderView class, a fuzzy "jump to file" search over a whole tree.
+ */
+
+#ifndef FINDERVIEW_HPP
+    #define FINDERVIEW_HPP
+
+    #include "ui/NcursesManager.hpp"
+    #include "core/EventNotifier.hpp"
+    #include "core/FuzzyMatcher.hpp"
+    #include "core/PathIndex.hpp"
+    #include "IView.hpp"
+    #include "ViewType.hpp"
+
+    #include <functional>
+    #include <memory>
+    #include <string>
+    #include <string_view>
+    #include <vector>
+
+namespace ui {
+
+    /**
+     * @class FinderView
+     * @brief Finds any path under a directory by typing a few of its characters.
+     *
+     * The tree is indexed in the background as soon as the view opens. The best matches are
+     * shown while indexing goes on: each frame only scores the chunks that arrived since the
+     * previous one, and merges them into the results. Typing starts the ranking over, and so
+     * does the index replacing its stored paths with freshly walked ones.
+     * Picking a result hands its full path to the pick callback.
+     */
+
+    class FinderView : public IView {
+    public:
+        static constexpr std::size_t RESULT_LIMIT = 500;
+
+        FinderView(NcursesManager& manager, const std::string& root, core::EventNotifier* notifier,
+                   std::function<void(const std::string&)> pickCallback, std::function<void(ViewType)> switchCallback);
+
+        void handleInput(int ch) override;
+        void update() override;
+
+    protected:
+    private:
+        NcursesManager& _manager;
+        std::string _root;
+        std::unique_ptr<core::PathIndex> _index;
+        core::PathIndex::Snapshot _chunks;
+        std::vector<core::FuzzyMatch> _results;
+        std::size_t _scoredChunks;
+        std::string _pattern;
+        bool _dirty;
+        std::size_t _generation;
+        int _selectedIndex;
+        int _scrollOffset;
+        int _pageSize;
+
+        std::function<void(const std::string&)> _pickCallback;
+        std::function<void(ViewType)> _switchCallback;
+
+        void search();
+        void pick();
+        std::string_view pathOf(const core::FuzzyMatch& match) const;
+    };
+
+} // namespace ui
+
+#endif // FINDERVIEW_HPP
@@ -0,0 +1,66 @@
+/**
+ * @file GrepView.hpp
+ * @brief Declaration of the ui::GrepView class, a search through the contents of every file under a directory.
+ */
+
+#ifndef GREPVIEW_HPP
+    #define GREPVIEW_HPP
+
+    #include "ui/NcursesManager.hpp"
+    #include "core/ContentSearch.hpp"
+    #include "core/EventNotifier.hpp"
+    #include "IView.hpp"
+    #include "ViewType.hpp"
+
+    #include <functional>
+    #include <memory>
+    #include <string>
+    #include <vector>
+
+namespace ui {
+
+    /**
+     * @class GrepView
+     * @brief Lists the lines that contain a text or match a regular expression, in every file
+     * under a directory.
+     *
+     * The search starts when Enter is pressed and runs in the background; matching lines are
+     * listed as they are found. Escape stops a running search and keeps its matches, Tab switches
+     * between a literal text and a regular expression. Picking a match hands the full path of
+     * its file to the pick callback.
+     */
+
+    class GrepView : public IView {
+    public:
+        GrepView(NcursesManager& manager, const std::string& root, core::EventNotifier* notifier,
+                 std::function<void(const std::string&)> pickCallback, std::function<void(ViewType)> switchCallback);
+
+        void handleInput(int ch) override;
+        void update() override;
+
+    protected:
+    private:
+        NcursesManager& _manager;
+        std::string _root;
+        core::EventNotifier* _notifier;
+        std::unique_ptr<core::ContentSearch> _search;
+        std::vector<core::ContentMatch> _matches;
+        std::string _pattern;
+        std::string _error;
+        bool _regex;
+        bool _modified;
+        int _selectedIndex;
+        int _scrollOffset;
+        int _pageSize;
+
+        std::function<void(const std::string&)> _pickCallback;
+        std::function<void(ViewType)> _switchCallback;
+
+        void start();
+        void pick();
+        std::string status() const;
+    };
+
+} // namespace ui
+
+#endif // GREPVIEW_HPP
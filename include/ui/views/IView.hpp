@@ -8,6 +8,8 @@
 
 #include "ui/NcursesManager.hpp"
 
+#include <vector>
+
 namespace ui {
 
     /**
@@ -15,6 +17,7 @@ namespace ui {
      * @brief An interface that defines the contract for view classes in the application.
      *
      * This interface provides methods for handling user input and updating the view.
+     * A view with background work lists the descriptors the main loop should wake up for.
      */
 
     class IView {
@@ -23,6 +26,7 @@ namespace ui {
 
         virtual void handleInput(int ch) = 0;
         virtual void update() = 0;
+        virtual void pollFds(std::vector<int>& /*fds*/) const {}
     
     protected:
     private:
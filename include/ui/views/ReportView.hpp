@@ -0,0 +1,61 @@
+/**
+ * @file ReportView.hpp
+ * @brief Declaration of the ui::ReportView class, the largest or latest files under a directory.
+ */
+
+#ifndef REPORTVIEW_HPP
+    #define REPORTVIEW_HPP
+
+    #include "ui/NcursesManager.hpp"
+    #include "core/EventNotifier.hpp"
+    #include "core/FileReport.hpp"
+    #include "IView.hpp"
+    #include "ViewType.hpp"
+
+    #include <functional>
+    #include <memory>
+    #include <string>
+
+namespace ui {
+
+    /**
+     * @class ReportView
+     * @brief Lists the largest files under a directory, or the ones modified in the last hour,
+     * latest first.
+     *
+     * The report runs in the background as soon as the view opens; Tab switches between the two
+     * rankings and starts over. Picking a file hands its full path to the pick callback.
+     */
+
+    class ReportView : public IView {
+    public:
+        static constexpr std::time_t RECENT_WINDOW = 60 * 60;
+
+        ReportView(NcursesManager& manager, const std::string& root, core::EventNotifier* notifier,
+                   std::function<void(const std::string&)> pickCallback, std::function<void(ViewType)> switchCallback);
+
+        void handleInput(int ch) override;
+        void update() override;
+
+    protected:
+    private:
+        NcursesManager& _manager;
+        std::string _root;
+        core::EventNotifier* _notifier;
+        core::Ranking _ranking;
+        std::unique_ptr<core::FileReport> _report;
+        int _selectedIndex;
+        int _scrollOffset;
+        int _pageSize;
+
+        std::function<void(const std::string&)> _pickCallback;
+        std::function<void(ViewType)> _switchCallback;
+
+        void start();
+        void pick();
+        std::string status() const;
+    };
+
+} // namespace ui
+
+#endif // REPORTVIEW_HPP
@@ -0,0 +1,44 @@
+/**
+ * @file StatusBarView.hpp
+ * @brief Declaration of the ui::StatusBarView class that shows the background file operations.
+ */
+
+#ifndef STATUSBARVIEW_HPP
+    #define STATUSBARVIEW_HPP
+
+    #include "ui/NcursesManager.hpp"
+    #include "core/JobQueue.hpp"
+    #include "IView.hpp"
+
+    #include <string>
+
+namespace ui {
+
+    /**
+     * @class StatusBarView
+     * @brief Shows the running job on the status window: how far it is, its throughput and the
+     * time left, or how the last job ended once the queue is empty.
+     *
+     * It is drawn under whichever view is current and takes no keys of its own: the explorer
+     * pauses and cancels jobs.
+     */
+
+    class StatusBarView : public IView {
+    public:
+        StatusBarView(NcursesManager& manager, core::JobQueue& jobs);
+
+        void handleInput(int ch) override;
+        void update() override;
+
+    protected:
+    private:
+        NcursesManager& _manager;
+        core::JobQueue& _jobs;
+
+        std::string describeRunning(const core::Job& job) const;
+        std::string describeFinished(const core::Job& job) const;
+    };
+
+} // namespace ui
+
+#endif // STATUSBARVIEW_HPP
@@ -0,0 +1,83 @@
+/**
+ * @file UsageView.hpp
+ * @brief Declaration of the ui::UsageView class, a disk usage browser in the manner of ncdu.
+ */
+
+#ifndef USAGEVIEW_HPP
+    #define USAGEVIEW_HPP
+
+    #include "ui/NcursesManager.hpp"
+    #include "core/DiskUsage.hpp"
+    #include "core/EventNotifier.hpp"
+    #include "core/UsageCache.hpp"
+    #include "core/UsageTree.hpp"
+    #include "IView.hpp"
+    #include "ViewType.hpp"
+
+    #include <functional>
+    #include <memory>
+    #include <string>
+    #include <vector>
+
+namespace ui {
+
+    /**
+     * @class UsageView
+     * @brief Sizes a directory tree and lists each directory's entries largest first, with the
+     * share of the directory each one takes.
+     *
+     * The tree is walked once, in the background; moving into a directory and back out only reads
+     * the sized tree. Deleting an entry takes its size off the directories above it, and r walks
+     * the shown directory again, replacing its subtree only. The tree can be saved to a file and
+     * a saved one loaded, to look at a scan taken elsewhere; a loaded tree cannot be changed.
+     */
+
+    class UsageView : public IView {
+    public:
+        static constexpr const char* DEFAULT_FILE = "fman-usage.bin";
+        static constexpr int BAR_WIDTH = 10;
+
+        UsageView(NcursesManager& manager, const std::string& root, core::UsageCache& usageCache,
+                  core::EventNotifier* notifier, std::function<void(ViewType)> switchCallback);
+
+        void handleInput(int ch) override;
+        void update() override;
+
+    protected:
+    private:
+        using Index = core::UsageTree::Index;
+
+        NcursesManager& _manager;
+        std::string _root;
+        core::UsageCache& _usageCache;
+        core::EventNotifier* _notifier;
+        std::unique_ptr<core::DiskUsage> _scan;
+        Index _scanTarget;
+        std::unique_ptr<core::UsageTree> _tree;
+        bool _readOnly;
+        Index _current;
+        std::vector<Index> _listing;
+        std::string _message;
+        bool _confirming;
+        int _selectedIndex;
+        int _scrollOffset;
+        int _pageSize;
+
+        std::function<void(ViewType)> _switchCallback;
+
+        void startScan(Index directory);
+        void finishScan();
+        void open(Index directory, Index select = core::UsageTree::npos);
+        void enterSelected();
+        void goUp();
+        void deleteSelected();
+        void exportTree();
+        void loadTree();
+        std::string prompt(const std::string& label);
+        std::string status() const;
+        std::string describe(Index index) const;
+    };
+
+} // namespace ui
+
+#endif // USAGEVIEW_HPP
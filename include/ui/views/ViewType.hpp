@@ -16,6 +16,10 @@ namespace ui {
         MAIN_MENU,
         EXPLORER,
         FILE_INFO,
+        FINDER,
+        GREP,
+        USAGE,
+        REPORT,
         QUIT
     };
 
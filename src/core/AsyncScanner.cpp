@@ -0,0 +1,168 @@
+/**
+ * @file AsyncScanner.cpp
+ * @brief Implementation of the core::AsyncScanner class
+ * @date 2025-06-10
+ */
+
+#include "core/AsyncScanner.hpp"
+#include "core/DirectoryScanner.hpp"
+
+#include <chrono>
+#include <cstring>
+
+#include <unistd.h>
+
+namespace core {
+
+    /**
+     * @brief Starts scanning right away.
+     * @param dirFd A directory descriptor with its own file offset; the scanner takes ownership.
+     * @param watcher Optional watcher to place a watch on watchPath with, from the scan thread.
+     * @param watchPath The path of the directory, as inotify wants one.
+     * @param notifier Optional notifier to wake the consumer when there is something to poll().
+     */
+    AsyncScanner::AsyncScanner(int dirFd, DirectoryWatcher* watcher, std::string watchPath, EventNotifier* notifier)
+        : _fd(dirFd), _watcher(watcher), _watchPath(std::move(watchPath)), _wd(-1), _notifier(notifier),
+          _queue(64), _cancelled(false), _done(false), _scanned(0)
+    {
+        _thread = std::thread(&AsyncScanner::run, this);
+    }
+
+    AsyncScanner::~AsyncScanner()
+    {
+        cancel();
+        if (_thread.joinable())
+            _thread.join();
+        if (_watcher)
+            _watcher->unwatch(_wd);
+        if (_fd >= 0)
+            ::close(_fd);
+    }
+
+    void AsyncScanner::cancel() noexcept
+    {
+        _cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Takes the next batch off the queue, if any. Consumer side only.
+     */
+    std::unique_ptr<ScanBatch> AsyncScanner::poll()
+    {
+        std::unique_ptr<ScanBatch> batch;
+
+        _queue.tryPop(batch);
+        return batch;
+    }
+
+    /**
+     * @brief True once the scan is over and every batch has been collected.
+     */
+    bool AsyncScanner::finished() const noexcept
+    {
+        return _done.load(std::memory_order_acquire) && _queue.empty();
+    }
+
+    /**
+     * @brief Hands the watch placed by the scan thread over to the caller.
+     * Only meaningful once finished() is true.
+     * @return The watch descriptor, or -1 if none could be placed.
+     */
+    int AsyncScanner::takeWatch() noexcept
+    {
+        int wd = _wd;
+
+        _wd = -1;
+        return wd;
+    }
+
+    std::size_t AsyncScanner::scannedCount() const noexcept
+    {
+        return _scanned.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Pushes a batch, waiting for room if the consumer is behind.
+     * @return False if the scan was cancelled meanwhile.
+     */
+    bool AsyncScanner::publish(std::unique_ptr<ScanBatch>& batch)
+    {
+        while (!_queue.tryPush(std::move(batch))) {
+            if (_cancelled.load(std::memory_order_relaxed))
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (_notifier)
+            _notifier->notify();
+        return true;
+    }
+
+    void AsyncScanner::addChildEvents()
+    {
+        if (_wd >= 0 && !_cancelled.load(std::memory_order_relaxed))
+            _watcher->watch(_watchPath, DirectoryWatcher::CHILD_EVENTS | IN_MASK_ADD);
+    }
+
+    /**
+     * @brief Second pass: stats every entry in scan order and publishes the details.
+     */
+    void AsyncScanner::inspectAll(const std::vector<char>& names, const std::vector<EntryType>& types)
+    {
+        const char* name = names.data();
+        auto batch = std::make_unique<ScanBatch>();
+
+        batch->inspected = true;
+        for (std::size_t i = 0; i < types.size(); ++i) {
+            if (_cancelled.load(std::memory_order_relaxed))
+                return;
+            batch->details.push_back(DirectoryScanner::inspect(_fd, name, types[i]));
+            name += std::strlen(name) + 1;
+            if (batch->details.size() < BATCH)
+                continue;
+            if (!publish(batch))
+                return;
+            batch = std::make_unique<ScanBatch>();
+            batch->inspected = true;
+            batch->first = i + 1;
+        }
+        if (!batch->details.empty())
+            publish(batch);
+    }
+
+    void AsyncScanner::run()
+    {
+        DirectoryScanner scanner(_fd);
+        auto batch = std::make_unique<ScanBatch>();
+        std::size_t limit = FIRST_BATCH;
+        std::vector<char> names;
+        std::vector<EntryType> types;
+
+        if (_watcher)
+            _wd = _watcher->watch(_watchPath, DirectoryWatcher::LISTING_EVENTS & ~DirectoryWatcher::CHILD_EVENTS);
+        scanner.scan([&](std::string_view name, EntryType type) {
+            if (_cancelled.load(std::memory_order_relaxed))
+                return false;
+            batch->names.insert(batch->names.end(), name.begin(), name.end());
+            batch->names.push_back('\0');
+            batch->details.push_back(DirectoryScanner::describe(name, type));
+            names.insert(names.end(), name.begin(), name.end() + 1);
+            types.push_back(type);
+            _scanned.fetch_add(1, std::memory_order_relaxed);
+            if (batch->details.size() < limit)
+                return true;
+            if (!publish(batch))
+                return false;
+            batch = std::make_unique<ScanBatch>();
+            limit = BATCH;
+            return true;
+        });
+        if (batch && !batch->details.empty())
+            publish(batch);
+        inspectAll(names, types);
+        addChildEvents();
+        _done.store(true, std::memory_order_release);
+        if (_notifier)
+            _notifier->notify();
+    }
+
+} // namespace core
@@ -0,0 +1,162 @@
+/**
+ * @file Checksum.cpp
+ * @brief Implementation of the core::Checksum class
+ * @date 2025-06-30
+ */
+
+#include "core/Checksum.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace core {
+
+    namespace {
+
+        constexpr std::uint64_t PRIME1 = 11400714785074694791ULL;
+        constexpr std::uint64_t PRIME2 = 14029467366897019727ULL;
+        constexpr std::uint64_t PRIME3 = 1609587929392839161ULL;
+        constexpr std::uint64_t PRIME4 = 9650029242287828579ULL;
+        constexpr std::uint64_t PRIME5 = 2870177450012600261ULL;
+
+        constexpr std::size_t ZERO_BLOCK = 64 * 1024;
+
+        inline std::uint64_t rotl(std::uint64_t x, int r) noexcept
+        {
+            return (x << r) | (x >> (64 - r));
+        }
+
+        // Little-endian reads, as the digest is defined; memcpy compiles to a plain load
+        inline std::uint64_t read64(const unsigned char* p) noexcept
+        {
+            std::uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline std::uint32_t read32(const unsigned char* p) noexcept
+        {
+            std::uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline std::uint64_t round(std::uint64_t acc, std::uint64_t input) noexcept
+        {
+            acc += input * PRIME2;
+            acc = rotl(acc, 31);
+            return acc * PRIME1;
+        }
+
+        inline std::uint64_t merge(std::uint64_t acc, std::uint64_t lane) noexcept
+        {
+            acc ^= round(0, lane);
+            return acc * PRIME1 + PRIME4;
+        }
+
+    } // namespace
+
+    Checksum::Checksum(std::uint64_t seed) noexcept
+        : _seed(seed), _lanes { seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1 }, _length(0),
+          _pending {}, _pendingSize(0)
+    {}
+
+    void Checksum::update(const void* data, std::size_t length) noexcept
+    {
+        const auto* p = static_cast<const unsigned char*>(data);
+        const unsigned char* end = p + length;
+
+        _length += length;
+        if (_pendingSize + length < sizeof(_pending)) {
+            std::memcpy(_pending + _pendingSize, p, length);
+            _pendingSize += length;
+            return;
+        }
+        if (_pendingSize > 0) {
+            std::size_t fill = sizeof(_pending) - _pendingSize;
+            std::memcpy(_pending + _pendingSize, p, fill);
+            p += fill;
+            for (int lane = 0; lane < 4; ++lane)
+                _lanes[lane] = round(_lanes[lane], read64(_pending + 8 * lane));
+            _pendingSize = 0;
+        }
+
+        // Four independent lanes, so the multiplications of one stripe overlap
+        std::uint64_t v1 = _lanes[0], v2 = _lanes[1], v3 = _lanes[2], v4 = _lanes[3];
+        for (; end - p >= 32; p += 32) {
+            v1 = round(v1, read64(p));
+            v2 = round(v2, read64(p + 8));
+            v3 = round(v3, read64(p + 16));
+            v4 = round(v4, read64(p + 24));
+        }
+        _lanes[0] = v1; _lanes[1] = v2; _lanes[2] = v3; _lanes[3] = v4;
+
+        _pendingSize = static_cast<std::size_t>(end - p);
+        std::memcpy(_pending, p, _pendingSize);
+    }
+
+    void Checksum::updateZeros(std::uint64_t length) noexcept
+    {
+        static const unsigned char zeros[ZERO_BLOCK] = {};
+
+        while (length > 0) {
+            std::size_t piece = static_cast<std::size_t>(std::min<std::uint64_t>(length, ZERO_BLOCK));
+            update(zeros, piece);
+            length -= piece;
+        }
+    }
+
+    /**
+     * @brief The digest of what was fed so far. Feeding may go on afterwards.
+     */
+    std::uint64_t Checksum::digest() const noexcept
+    {
+        std::uint64_t h;
+
+        if (_length >= 32) {
+            h = rotl(_lanes[0], 1) + rotl(_lanes[1], 7) + rotl(_lanes[2], 12) + rotl(_lanes[3], 18);
+            for (std::uint64_t lane : _lanes)
+                h = merge(h, lane);
+        } else {
+            h = _seed + PRIME5;
+        }
+        h += _length;
+
+        const unsigned char* p = _pending;
+        const unsigned char* end = _pending + _pendingSize;
+        for (; end - p >= 8; p += 8) {
+            h ^= round(0, read64(p));
+            h = rotl(h, 27) * PRIME1 + PRIME4;
+        }
+        if (end - p >= 4) {
+            h ^= static_cast<std::uint64_t>(read32(p)) * PRIME1;
+            h = rotl(h, 23) * PRIME2 + PRIME3;
+            p += 4;
+        }
+        for (; p < end; ++p) {
+            h ^= *p * PRIME5;
+            h = rotl(h, 11) * PRIME1;
+        }
+
+        h ^= h >> 33;
+        h *= PRIME2;
+        h ^= h >> 29;
+        h *= PRIME3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    /**
+     * @brief Writes a digest as xxhsum does: 16 lowercase hexadecimal digits.
+     */
+    std::string Checksum::toHex(std::uint64_t digest)
+    {
+        static const char digits[] = "0123456789abcdef";
+        std::string text(16, '0');
+
+        for (int i = 15; i >= 0; --i, digest >>= 4)
+            text[static_cast<std::size_t>(i)] = digits[digest & 0xf];
+        return text;
+    }
+
+} // namespace core
@@ -0,0 +1,88 @@
+/**
+ * @file CommandJob.cpp
+ * @brief Implementation of the core::CommandJob class
+ * @date 2025-06-29
+ */
+
+#include "core/CommandJob.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace core {
+
+    /**
+     * @param description What the job is shown as.
+     * @param arguments The program, looked up in PATH, followed by its arguments.
+     */
+    CommandJob::CommandJob(std::string description, std::vector<std::string> arguments)
+        : Job(std::move(description)), _arguments(std::move(arguments))
+    {}
+
+    void CommandJob::run()
+    {
+        std::vector<char*> argv;
+        for (auto& argument : _arguments)
+            argv.push_back(argument.data());
+        argv.push_back(nullptr);
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+        posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+        // The UI thread blocks SIGWINCH for its signalfd; the child should not inherit that
+        posix_spawnattr_t attributes;
+        sigset_t empty;
+        posix_spawnattr_init(&attributes);
+        sigemptyset(&empty);
+        posix_spawnattr_setsigmask(&attributes, &empty);
+        posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGMASK);
+
+        pid_t pid;
+        int error = posix_spawnp(&pid, argv[0], &actions, &attributes, argv.data(), environ);
+        posix_spawn_file_actions_destroy(&actions);
+        posix_spawnattr_destroy(&attributes);
+        if (error != 0)
+            throw std::system_error(error, std::generic_category(), _arguments[0]);
+
+        bool stopped = false;
+        bool terminated = false;
+        int status = 0;
+        while (true) {
+            pid_t result = ::waitpid(pid, &status, WNOHANG);
+            if (result == pid)
+                break;
+            if (result < 0 && errno != EINTR)
+                throw std::system_error(errno, std::generic_category(), _arguments[0]);
+
+            if (cancelled() && !terminated) {
+                ::kill(pid, SIGTERM);
+                if (stopped)
+                    ::kill(pid, SIGCONT);
+                terminated = true;
+            } else if (!terminated && paused() != stopped) {
+                stopped = paused();
+                ::kill(pid, stopped ? SIGSTOP : SIGCONT);
+            }
+            // Nothing to count, but the elapsed time shown keeps up
+            advance(0);
+            std::this_thread::sleep_for(POLL_INTERVAL);
+        }
+
+        if (terminated)
+            return;
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            throw std::runtime_error(_arguments[0] + ": exit status "
+                                     + std::to_string(WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status)));
+    }
+
+} // namespace core
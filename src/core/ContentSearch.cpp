@@ -0,0 +1,463 @@
+/**
+ * @file ContentSearch.cpp
+ * @brief Implementation of the core::ContentSearch class
+ * @date 2025-06-25
+ */
+
+#include "core/ContentSearch.hpp"
+#include "core/DirectoryScanner.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace core {
+
+    namespace {
+
+        constexpr std::size_t SCAN_BUFFER = 32 * 1024;
+        // Files handed to one task, so that tiny files do not cost a task each
+        constexpr std::size_t FILE_BATCH = 32;
+        // How much of a file is scanned between two looks at the cancel flag
+        constexpr std::size_t CANCEL_WINDOW = 8 * 1024 * 1024;
+        // std::regex recurses per character: longer lines are not handed to it
+        constexpr std::size_t REGEX_LINE_LIMIT = 64 * 1024;
+
+        /**
+         * @brief The first position where needle occurs in text, or npos.
+         *
+         * Sixteen candidate positions are tested at once by comparing the first and the last byte
+         * of the needle; only positions where both match are compared in full.
+         */
+        std::size_t findLiteral(const char* text, std::size_t length, std::string_view needle) noexcept
+        {
+            std::size_t k = needle.size();
+
+            if (k == 0 || k > length)
+                return std::string_view::npos;
+            if (k == 1) {
+                const void* at = std::memchr(text, needle[0], length);
+                return at ? static_cast<std::size_t>(static_cast<const char*>(at) - text) : std::string_view::npos;
+            }
+
+            std::size_t last = length - k;
+            std::size_t pos = 0;
+        #if defined(__SSE2__)
+            const __m128i first = _mm_set1_epi8(needle[0]);
+            const __m128i final = _mm_set1_epi8(needle[k - 1]);
+            for (; pos + 15 <= last; pos += 16) {
+                __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + pos));
+                __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + pos + k - 1));
+                auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first),
+                                                                                  _mm_cmpeq_epi8(tail, final))));
+                for (; mask != 0; mask &= mask - 1) {
+                    std::size_t at = pos + static_cast<std::size_t>(std::countr_zero(mask));
+                    if (std::memcmp(text + at + 1, needle.data() + 1, k - 2) == 0)
+                        return at;
+                }
+            }
+        #endif
+            for (; pos <= last; ++pos)
+                if (text[pos] == needle[0] && std::memcmp(text + pos, needle.data(), k) == 0)
+                    return pos;
+            return std::string_view::npos;
+        }
+
+        std::size_t countLines(const char* from, const char* to) noexcept
+        {
+            std::size_t count = 0;
+
+            while (from < to) {
+                const void* at = std::memchr(from, '\n', static_cast<std::size_t>(to - from));
+                if (at == nullptr)
+                    break;
+                ++count;
+                from = static_cast<const char*>(at) + 1;
+            }
+            return count;
+        }
+
+        std::string lineText(const char* line, std::size_t length)
+        {
+            std::string text(line, std::min(length, ContentSearch::LINE_TEXT_LIMIT));
+
+            for (char& c : text)
+                if (static_cast<unsigned char>(c) < 0x20 || c == 0x7f)
+                    c = ' ';
+            return text;
+        }
+
+        /**
+         * @brief Reads a small file whole into a buffer kept by the calling worker.
+         */
+        std::string_view readSmall(int fd, std::size_t size)
+        {
+            thread_local std::vector<char> buffer;
+
+            buffer.resize(std::max(buffer.size(), size));
+            std::size_t done = 0;
+            while (done < size) {
+                ssize_t n = ::pread(fd, buffer.data() + done, size - done, static_cast<off_t>(done));
+                if (n <= 0)
+                    break;
+                done += static_cast<std::size_t>(n);
+            }
+            return { buffer.data(), done };
+        }
+
+        /**
+         * @brief The last component of a path relative to the root, which is what is opened
+         * relative to the directory holding it.
+         */
+        const char* nameOf(const std::string& relative) noexcept
+        {
+            std::size_t slash = relative.rfind('/');
+            return relative.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+        }
+
+    } // namespace
+
+    /**
+     * @brief A directory's descriptor, kept open by the tasks that open entries relative to it.
+     */
+    struct ContentSearch::Directory {
+        int fd;
+
+        explicit Directory(int descriptor) noexcept : fd(descriptor) {}
+        ~Directory() { ::close(fd); }
+
+        Directory(const Directory&) = delete;
+        Directory& operator=(const Directory&) = delete;
+    };
+
+    /**
+     * @brief Starts searching right away.
+     * @param root The directory to search; matches are reported relative to it.
+     * @param pattern The text to look for.
+     * @param regex Whether pattern is an ECMAScript regular expression rather than a literal.
+     * @param notifier Optional notifier, signalled whenever matches are added and when the search ends.
+     * @param pool The pool the search runs on.
+     * @throws std::regex_error If pattern is not a valid regular expression.
+     */
+    ContentSearch::ContentSearch(const std::string& root, const std::string& pattern, bool regex,
+                                 EventNotifier* notifier, ThreadPool& pool)
+        : _root(root), _rootFd(-1), _notifier(notifier), _pool(pool), _pending(0), _cancelled(false),
+          _finished(false), _matchCount(0), _filesSearched(0), _bytesSearched(0)
+    {
+        if (regex) {
+            _regex.emplace(pattern, std::regex::ECMAScript | std::regex::optimize);
+            _literal = requiredLiteral(pattern);
+        } else {
+            _literal = pattern;
+        }
+
+        _rootFd = ::open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (_rootFd < 0 || (pattern.empty() && !regex)) {
+            _finished = true;
+            return;
+        }
+        submit([this] { walk(nullptr, ""); });
+    }
+
+    ContentSearch::~ContentSearch()
+    {
+        _cancelled = true;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _idle.wait(lock, [this] { return _pending == 0; });
+        }
+        if (_rootFd >= 0)
+            ::close(_rootFd);
+    }
+
+    /**
+     * @brief The matches found after the first ones, in the order they were found.
+     */
+    std::vector<ContentMatch> ContentSearch::matchesSince(std::size_t first) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (first >= _matches.size())
+            return {};
+        return std::vector<ContentMatch>(_matches.begin() + static_cast<std::ptrdiff_t>(first), _matches.end());
+    }
+
+    /**
+     * @brief The longest run of plain characters that every match of an ECMAScript expression
+     * must contain, or an empty string if there is none or it cannot be told.
+     * Characters made optional by a following quantifier are left out, and so is anything inside
+     * groups and classes; an alternation anywhere gives up.
+     */
+    std::string ContentSearch::requiredLiteral(std::string_view regex)
+    {
+        std::string best;
+        std::string run;
+        int depth = 0;
+
+        auto endRun = [&]() {
+            if (depth == 0 && run.size() > best.size())
+                best = run;
+            run.clear();
+        };
+
+        for (std::size_t i = 0; i < regex.size(); ++i) {
+            char c = regex[i];
+            switch (c) {
+                case '|':
+                    return {};
+                case '*':
+                case '?':
+                case '{':
+                    // The quantified character may not be there at all
+                    if (!run.empty())
+                        run.pop_back();
+                    endRun();
+                    if (c == '{')
+                        i = std::min(regex.find('}', i), regex.size());
+                    break;
+                case '+':
+                    endRun();
+                    break;
+                case '(':
+                    endRun();
+                    ++depth;
+                    break;
+                case ')':
+                    endRun();
+                    depth = std::max(0, depth - 1);
+                    break;
+                case '[':
+                    endRun();
+                    for (++i; i < regex.size() && regex[i] != ']'; ++i)
+                        if (regex[i] == '\\')
+                            ++i;
+                    break;
+                case '\\':
+                    if (i + 1 < regex.size() && !std::isalnum(static_cast<unsigned char>(regex[i + 1]))) {
+                        ++i;
+                        if (depth == 0)
+                            run.push_back(regex[i]);
+                    } else {
+                        endRun();
+                        ++i;
+                    }
+                    break;
+                case '.':
+                case '^':
+                case '$':
+                    endRun();
+                    break;
+                default:
+                    if (depth == 0)
+                        run.push_back(c);
+                    break;
+            }
+        }
+        endRun();
+        return best;
+    }
+
+    void ContentSearch::submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_pending;
+        }
+        _pool.submit(std::move(task));
+    }
+
+    /**
+     * @brief Ends a task. The last one marks the search finished.
+     */
+    void ContentSearch::done()
+    {
+        EventNotifier* notifier = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_pending == 0) {
+                _finished.store(true, std::memory_order_release);
+                notifier = _notifier;
+                // The destructor may run as soon as the lock is released: no member is used past it
+                _idle.notify_all();
+            }
+        }
+        if (notifier)
+            notifier->notify();
+    }
+
+    /**
+     * @brief Lists one directory, opened relative to its parent, queues its subdirectories and
+     * hands its files to batch tasks. The paths built are only those the matches report.
+     * @param parent The parent directory, or none for the root.
+     */
+    void ContentSearch::walk(std::shared_ptr<const Directory> parent, const std::string& relative)
+    {
+        int fd = -1;
+        if (!_cancelled.load(std::memory_order_relaxed))
+            fd = ::openat(parent ? parent->fd : _rootFd, parent ? nameOf(relative) : ".",
+                          O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        // The parent is only needed to open the directory: it may close once its other entries are done
+        parent.reset();
+        if (fd >= 0) {
+            auto directory = std::make_shared<const Directory>(fd);
+            DirectoryScanner scanner(fd, SCAN_BUFFER);
+            std::string prefix = relative.empty() ? relative : relative + "/";
+            std::vector<std::string> batch;
+
+            scanner.scan([&](std::string_view name, EntryType type) {
+                std::string path = prefix + std::string(name);
+                if (type == EntryType::DIRECTORY) {
+                    submit([this, directory, path = std::move(path)] { walk(directory, path); });
+                } else if (type == EntryType::REGULAR) {
+                    batch.push_back(std::move(path));
+                    if (batch.size() == FILE_BATCH) {
+                        submit([this, directory, files = std::move(batch)] { searchFiles(*directory, files); });
+                        batch.clear();
+                    }
+                }
+                return !_cancelled.load(std::memory_order_relaxed);
+            });
+            if (!batch.empty())
+                submit([this, directory, files = std::move(batch)] { searchFiles(*directory, files); });
+        }
+        done();
+    }
+
+    void ContentSearch::searchFiles(const Directory& directory, const std::vector<std::string>& paths)
+    {
+        std::vector<ContentMatch> found;
+
+        for (const auto& path : paths) {
+            if (_cancelled.load(std::memory_order_relaxed))
+                break;
+            searchFile(directory, path, found);
+        }
+        publish(found);
+        done();
+    }
+
+    /**
+     * @brief Searches one file, opened relative to its directory, read or mapped whole depending on its size.
+     */
+    void ContentSearch::searchFile(const Directory& directory, const std::string& path, std::vector<ContentMatch>& found)
+    {
+        int fd = ::openat(directory.fd, nameOf(path), O_RDONLY | O_NOFOLLOW | O_NOCTTY | O_CLOEXEC);
+        if (fd < 0)
+            return;
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+            ::close(fd);
+            return;
+        }
+
+        auto size = static_cast<std::size_t>(st.st_size);
+        std::string_view contents;
+        void* mapping = MAP_FAILED;
+        if (size < MAP_THRESHOLD) {
+            contents = readSmall(fd, size);
+        } else {
+            mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                ::madvise(mapping, size, MADV_SEQUENTIAL);
+                contents = std::string_view(static_cast<const char*>(mapping), size);
+            }
+        }
+        ::close(fd);
+
+        if (!contents.empty() && std::memchr(contents.data(), '\0', std::min(contents.size(), BINARY_PROBE)) == nullptr) {
+            scan(contents.data(), contents.size(), path, found);
+            _filesSearched.fetch_add(1, std::memory_order_relaxed);
+            _bytesSearched.fetch_add(contents.size(), std::memory_order_relaxed);
+        }
+        if (mapping != MAP_FAILED)
+            ::munmap(mapping, size);
+    }
+
+    /**
+     * @brief Finds the matching lines of a file's contents.
+     * The literal, if any, is searched for first, window by window; the line around each
+     * occurrence is then checked against the expression. Without a literal, every line is.
+     */
+    void ContentSearch::scan(const char* data, std::size_t size, const std::string& path,
+                             std::vector<ContentMatch>& found) const
+    {
+        std::size_t lineFloor = 0;      // a line start no later than any line still to report
+        std::size_t counted = 0;        // lines before it are counted up to here
+        std::size_t lineNumber = 1;
+        std::size_t pos = 0;
+
+        while (pos < size) {
+            if (_cancelled.load(std::memory_order_relaxed))
+                return;
+
+            std::size_t hit = pos;
+            if (!_literal.empty()) {
+                std::size_t window = std::min(size, pos + CANCEL_WINDOW + _literal.size() - 1);
+                std::size_t at = findLiteral(data + pos, window - pos, _literal);
+                if (at == std::string_view::npos) {
+                    if (window == size)
+                        return;
+                    pos = window - (_literal.size() - 1);
+                    continue;
+                }
+                hit = pos + at;
+            }
+
+            const void* before = hit > lineFloor ? ::memrchr(data + lineFloor, '\n', hit - lineFloor) : nullptr;
+            std::size_t lineStart = before ? static_cast<std::size_t>(static_cast<const char*>(before) - data) + 1 : lineFloor;
+            const void* after = std::memchr(data + hit, '\n', size - hit);
+            std::size_t lineEnd = after ? static_cast<std::size_t>(static_cast<const char*>(after) - data) : size;
+
+            std::optional<std::size_t> column;
+            if (!_regex) {
+                column = hit - lineStart;
+            } else if (lineEnd - lineStart <= REGEX_LINE_LIMIT) {
+                std::cmatch match;
+                if (std::regex_search(data + lineStart, data + lineEnd, match, *_regex))
+                    column = static_cast<std::size_t>(match.position(0));
+            }
+
+            if (column) {
+                lineNumber += countLines(data + counted, data + lineStart);
+                counted = lineStart;
+                found.push_back(ContentMatch { path, static_cast<std::uint32_t>(lineNumber),
+                                               static_cast<std::uint32_t>(*column + 1),
+                                               lineText(data + lineStart, lineEnd - lineStart) });
+            }
+            lineFloor = lineEnd + 1;
+            pos = lineEnd + 1;
+        }
+    }
+
+    /**
+     * @brief Adds a batch's matches, as long as the limit is not reached.
+     */
+    void ContentSearch::publish(std::vector<ContentMatch>& found)
+    {
+        if (found.empty())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::size_t room = MATCH_LIMIT - std::min(MATCH_LIMIT, _matches.size());
+            std::size_t kept = std::min(room, found.size());
+            _matches.insert(_matches.end(), std::make_move_iterator(found.begin()),
+                            std::make_move_iterator(found.begin() + static_cast<std::ptrdiff_t>(kept)));
+            _matchCount.fetch_add(found.size(), std::memory_order_relaxed);
+        }
+        if (_notifier)
+            _notifier->notify();
+    }
+
+} // namespace core
@@ -0,0 +1,699 @@
+/**
+ * @file CopyJob.cpp
+ * @brief Implementation of the core::CopyJob class
+ * @date 2025-06-29
+ */
+
+#include "core/CopyJob.hpp"
+#include "core/Checksum.hpp"
+#include "core/DirectoryScanner.hpp"
+#include "core/DiskUsage.hpp"
+#include "core/FileIdentity.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace core {
+
+    namespace {
+
+        constexpr std::size_t SCAN_BUFFER = 32 * 1024;
+
+        [[noreturn]] void fail(const std::string& path)
+        {
+            throw std::system_error(errno, std::generic_category(), path);
+        }
+
+        std::string filenameOf(const std::string& path)
+        {
+            std::string trimmed = path;
+            while (trimmed.size() > 1 && trimmed.back() == '/')
+                trimmed.pop_back();
+            std::size_t slash = trimmed.rfind('/');
+            return slash == std::string::npos ? trimmed : trimmed.substr(slash + 1);
+        }
+
+        /**
+         * @brief Whether a kernel copy failed because it cannot copy between these files, rather
+         * than because of the files themselves: the next way down may still work.
+         */
+        bool unsupported(int error) noexcept
+        {
+            return error == EXDEV || error == EINVAL || error == ENOSYS || error == EOPNOTSUPP || error == EBADF
+                || error == ENOTTY;
+        }
+
+        /**
+         * @brief Closes a descriptor when the copy leaves, whether it ends or throws.
+         */
+        struct FdGuard {
+            int fd = -1;
+            ~FdGuard() { if (fd >= 0) ::close(fd); }
+        };
+
+        /**
+         * @brief A pipeline buffer, aligned as direct I/O wants it.
+         */
+        struct AlignedBuffer {
+            char* data;
+
+            explicit AlignedBuffer(std::size_t size)
+                : data(static_cast<char*>(::operator new(size, std::align_val_t(CopyJob::DIRECT_ALIGNMENT))))
+            {}
+            ~AlignedBuffer() { ::operator delete(data, std::align_val_t(CopyJob::DIRECT_ALIGNMENT)); }
+
+            AlignedBuffer(const AlignedBuffer&) = delete;
+            AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+        };
+
+        std::uint64_t alignUp(std::uint64_t value) noexcept
+        {
+            return (value + CopyJob::DIRECT_ALIGNMENT - 1) & ~static_cast<std::uint64_t>(CopyJob::DIRECT_ALIGNMENT - 1);
+        }
+
+        bool setDirect(int fd, bool direct) noexcept
+        {
+            int flags = ::fcntl(fd, F_GETFL);
+            return flags >= 0 && ::fcntl(fd, F_SETFL, direct ? flags | O_DIRECT : flags & ~O_DIRECT) == 0;
+        }
+
+        /**
+         * @brief Finds the next extent of data from an offset on.
+         * A file that is not sparse, or whose file system cannot tell, is one extent to its end.
+         * @return False if only a hole, or nothing, is left.
+         */
+        bool nextExtent(int fd, std::uint64_t from, std::uint64_t size, bool sparse, std::uint64_t& start,
+                        std::uint64_t& end)
+        {
+            if (from >= size)
+                return false;
+            if (!sparse) {
+                start = from;
+                end = size;
+                return true;
+            }
+
+            off_t data = ::lseek(fd, static_cast<off_t>(from), SEEK_DATA);
+            if (data < 0) {
+                if (errno == ENXIO)
+                    return false;
+                start = from;
+                end = size;
+                return true;
+            }
+            if (static_cast<std::uint64_t>(data) >= size)
+                return false;
+            off_t hole = ::lseek(fd, data, SEEK_HOLE);
+            start = static_cast<std::uint64_t>(data);
+            end = hole < 0 ? size : std::min(static_cast<std::uint64_t>(hole), size);
+            return true;
+        }
+
+    } // namespace
+
+    /**
+     * @brief A source directory and its copy, open for as long as a file in them is being copied.
+     * Shared, never copied, since each side closes its descriptor.
+     */
+    struct CopyJob::Directories {
+        FdGuard source;
+        FdGuard destination;
+    };
+
+    /**
+     * @param description What the job is shown as.
+     * @param source The file or directory to copy.
+     * @param destinationDirectory The directory the copy is made in, under the source's name.
+     */
+    CopyJob::CopyJob(std::string description, std::string source, const std::string& destinationDirectory,
+                     CopyOptions options)
+        : Job(std::move(description)), _source(std::move(source)),
+          _destination(destinationDirectory + "/" + filenameOf(_source)), _options(options), _tree(false),
+          _checksum(0), _hashedFiles(0), _inFlight(0), _cloneUnsupported(false), _rangeUnsupported(false)
+    {}
+
+    /**
+     * @brief The digest of a checksummed file, or that of a checksummed tree: the sum of the
+     * digests of its files, each seeded with the file's own and taken over its path in the tree.
+     */
+    std::string CopyJob::summary() const
+    {
+        if (!_options.checksum || state() != State::DONE)
+            return {};
+        std::string digest = "xxh64 " + Checksum::toHex(_checksum.load(std::memory_order_relaxed));
+        if (_tree)
+            return digest + " over " + std::to_string(_hashedFiles.load(std::memory_order_relaxed)) + " files";
+        return digest;
+    }
+
+    void CopyJob::run()
+    {
+        struct stat st;
+        if (::lstat(_source.c_str(), &st) != 0)
+            fail(_source);
+
+        if (S_ISLNK(st.st_mode)) {
+            setTotals(static_cast<std::uint64_t>(st.st_size), 1);
+            copyLink(AT_FDCWD, AT_FDCWD, _source.c_str(), _source);
+            return;
+        }
+        if (!S_ISDIR(st.st_mode)) {
+            setTotals(static_cast<std::uint64_t>(st.st_size), 1);
+            if (S_ISREG(st.st_mode))
+                copyFile(AT_FDCWD, AT_FDCWD, _source.c_str(), _source);
+            return;
+        }
+
+        _tree = true;
+        // The copy would be the source itself, or grow inside it as it is walked
+        std::string destinationDirectory = _destination.substr(0, _destination.rfind('/'));
+        FileIdentity source = FileIdentity::of(st);
+        if (source.encloses(_destination) || source.encloses(destinationDirectory))
+            throw std::runtime_error(_destination + ": the source itself or inside it");
+        {
+            // The walk leaves the root out of the directories it counts
+            DiskUsage usage(_source);
+            usage.wait();
+            UsageTotals totals = usage.progress();
+            setTotals(totals.bytes, totals.files + totals.directories + 1);
+        }
+
+        if (::mkdir(_destination.c_str(), st.st_mode & 07777) != 0 && errno != EEXIST)
+            fail(_destination);
+        auto directories = std::make_shared<Directories>();
+        directories->source.fd = ::open(_source.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        directories->destination.fd = ::open(_destination.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (directories->source.fd < 0)
+            fail(_source);
+        if (directories->destination.fd < 0)
+            fail(_destination);
+
+        ThreadPool pool(COPY_THREADS);
+        try {
+            copyDirectory(pool, directories, _source);
+        } catch (...) {
+            waitForFiles();
+            throw;
+        }
+        // The pool drops what it has not run yet when it goes: every file has to be done first
+        waitForFiles();
+        if (_failure)
+            std::rethrow_exception(_failure);
+    }
+
+    /**
+     * @brief Copies what a directory holds into its copy, which exists already. Files go to the
+     * pool; subdirectories and links are made here, so a directory exists before its files are
+     * copied. A directory counts its own size, as du does, so that the bytes done meet the total.
+     * @param path The source directory's path, for error messages.
+     */
+    void CopyJob::copyDirectory(ThreadPool& pool, const std::shared_ptr<Directories>& directories,
+                                const std::string& path)
+    {
+        struct stat st;
+        int sourceDir = directories->source.fd;
+        int destinationDir = directories->destination.fd;
+
+        if (::fstat(sourceDir, &st) != 0)
+            fail(path);
+        advance(static_cast<std::uint64_t>(st.st_size), 1);
+
+        std::vector<std::pair<std::string, EntryType>> entries;
+        DirectoryScanner scanner(sourceDir, SCAN_BUFFER);
+        scanner.scan([&](std::string_view name, EntryType type) {
+            entries.emplace_back(std::string(name), type);
+            return true;
+        });
+
+        for (auto& [name, type] : entries) {
+            if (!checkpoint() || failed())
+                return;
+            std::string child = path + "/" + name;
+
+            if (type == EntryType::DIRECTORY) {
+                if (::fstatat(sourceDir, name.c_str(), &st, AT_SYMLINK_NOFOLLOW) != 0)
+                    fail(child);
+                if (::mkdirat(destinationDir, name.c_str(), st.st_mode & 07777) != 0 && errno != EEXIST)
+                    fail(child);
+                auto subdirectories = std::make_shared<Directories>();
+                subdirectories->source.fd = ::openat(sourceDir, name.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+                subdirectories->destination.fd = ::openat(destinationDir, name.c_str(),
+                                                          O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+                if (subdirectories->source.fd < 0 || subdirectories->destination.fd < 0)
+                    fail(child);
+                copyDirectory(pool, subdirectories, child);
+            } else if (type == EntryType::SYMLINK) {
+                copyLink(sourceDir, destinationDir, name.c_str(), child);
+            } else if (type == EntryType::REGULAR) {
+                submitFile(pool, directories, std::move(name), std::move(child));
+            }
+        }
+    }
+
+    /**
+     * @brief Copies a symbolic link as a link, over whatever is in the way.
+     * @param path The link's path, for error messages.
+     */
+    void CopyJob::copyLink(int sourceDir, int destinationDir, const char* name, const std::string& path)
+    {
+        struct stat st;
+
+        if (::fstatat(sourceDir, name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+            fail(path);
+        std::string target(static_cast<std::size_t>(st.st_size) + 1, '\0');
+        ssize_t length = ::readlinkat(sourceDir, name, target.data(), target.size());
+        if (length < 0)
+            fail(path);
+        target.resize(static_cast<std::size_t>(length));
+
+        // A lone link is copied to the destination path, a link in a tree under the same name
+        const char* destination = destinationDir == AT_FDCWD ? _destination.c_str() : name;
+        struct stat existing;
+        if (::fstatat(destinationDir, destination, &existing, AT_SYMLINK_NOFOLLOW) == 0
+            && FileIdentity::of(existing) == FileIdentity::of(st))
+            throw std::runtime_error(path + ": the source itself");
+        ::unlinkat(destinationDir, destination, 0);
+        if (::symlinkat(target.c_str(), destinationDir, destination) != 0)
+            fail(path);
+        advance(static_cast<std::uint64_t>(st.st_size), 1);
+    }
+
+    /**
+     * @brief Hands a file to the pool, once fewer than MAX_IN_FLIGHT are being copied.
+     */
+    void CopyJob::submitFile(ThreadPool& pool, std::shared_ptr<Directories> directories, std::string name,
+                             std::string path)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _slots.wait(lock, [this] { return _inFlight < MAX_IN_FLIGHT; });
+            ++_inFlight;
+        }
+        pool.submit([this, directories = std::move(directories), name = std::move(name), path = std::move(path)] {
+            try {
+                if (checkpoint() && !failed())
+                    copyFile(directories->source.fd, directories->destination.fd, name.c_str(), path);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_failure)
+                    _failure = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                --_inFlight;
+            }
+            _slots.notify_all();
+        });
+    }
+
+    void CopyJob::waitForFiles()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _slots.wait(lock, [this] { return _inFlight == 0; });
+    }
+
+    bool CopyJob::failed()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _failure != nullptr;
+    }
+
+    /**
+     * @brief Copies a regular file's content over any file already there, unless that file is
+     * the source itself, which is only truncated once it is known not to be.
+     * The file is copied as large as it was when opened.
+     * @param path The source file's path, for error messages.
+     */
+    void CopyJob::copyFile(int sourceDir, int destinationDir, const char* name, const std::string& path)
+    {
+        struct stat st;
+        struct stat existing;
+
+        FdGuard in{::openat(sourceDir, name, O_RDONLY | O_NOFOLLOW | O_CLOEXEC)};
+        if (in.fd < 0 || ::fstat(in.fd, &st) != 0)
+            fail(path);
+        // A lone file is copied to the destination path, a file in a tree under the same name
+        const char* destination = destinationDir == AT_FDCWD ? _destination.c_str() : name;
+        FdGuard out{::openat(destinationDir, destination, O_WRONLY | O_CREAT | O_CLOEXEC, st.st_mode & 07777)};
+        if (out.fd < 0 || ::fstat(out.fd, &existing) != 0)
+            fail(destinationDir == AT_FDCWD ? _destination : path);
+        if (FileIdentity::of(existing) == FileIdentity::of(st))
+            throw std::runtime_error(path + ": the source itself");
+        if (::ftruncate(out.fd, 0) != 0)
+            fail(destinationDir == AT_FDCWD ? _destination : path);
+
+        auto size = static_cast<std::uint64_t>(st.st_size);
+        // Fewer blocks than the size needs: there are holes somewhere
+        bool sparse = static_cast<std::uint64_t>(st.st_blocks) * 512 < size;
+        try {
+            if (_options.checksum) {
+                if (_options.direct && size >= DIRECT_THRESHOLD) {
+                    // A file system that cannot do direct I/O refuses the flag, and the copy goes through the cache
+                    setDirect(in.fd, true);
+                    setDirect(out.fd, true);
+                }
+                std::uint64_t digest = copyHashed(in.fd, out.fd, size, sparse);
+                if (cancelled())
+                    return;
+                if (_tree) {
+                    // Summed, so that the order the workers end in does not matter; taken over the
+                    // path, seeded with the file's digest, so that two files swapped change the sum
+                    std::string_view relative = std::string_view(path).substr(_source.size());
+                    Checksum entry(digest);
+                    entry.update(relative.data(), relative.size());
+                    _checksum.fetch_add(entry.digest(), std::memory_order_relaxed);
+                } else {
+                    _checksum.store(digest, std::memory_order_relaxed);
+                }
+                _hashedFiles.fetch_add(1, std::memory_order_relaxed);
+            } else if (!cloneFile(in.fd, out.fd, size)) {
+                copyExtents(in.fd, out.fd, size, sparse);
+            }
+        } catch (const std::system_error& e) {
+            // The helpers only know the descriptors: name the file
+            throw std::system_error(e.code(), path);
+        }
+        advance(0, 1);
+    }
+
+    /**
+     * @brief Shares the source's extents with the copy, which costs no data written at all.
+     * @return False where the file system cannot, or the files are on two of them.
+     */
+    bool CopyJob::cloneFile(int in, int out, std::uint64_t size)
+    {
+        if (size == 0 || _cloneUnsupported.load(std::memory_order_relaxed))
+            return false;
+        if (::ioctl(out, FICLONE, in) != 0) {
+            if (unsupported(errno) || errno == EPERM)
+                _cloneUnsupported.store(true, std::memory_order_relaxed);
+            return false;
+        }
+        advance(size);
+        return true;
+    }
+
+    /**
+     * @brief Copies the data extents at the same offsets, by the cheapest means that works, and
+     * gives the copy its size, which leaves the holes as holes. A kernel copy that gives up part
+     * way leaves both offsets where it stopped, so the next one carries on from there.
+     */
+    void CopyJob::copyExtents(int in, int out, std::uint64_t size, bool sparse)
+    {
+        std::uint64_t position = 0;
+        std::uint64_t start, end;
+
+        while (nextExtent(in, position, size, sparse, start, end)) {
+            if (!checkpoint())
+                return;
+            advance(start - position);
+            if (::lseek(in, static_cast<off_t>(start), SEEK_SET) < 0 || ::lseek(out, static_cast<off_t>(start), SEEK_SET) < 0)
+                throw std::system_error(errno, std::generic_category());
+
+            std::uint64_t remaining = end - start;
+            if (!copyRange(in, out, remaining) && !sendFile(in, out, remaining))
+                copyBuffered(in, out, remaining);
+            if (cancelled())
+                return;
+            position = end;
+        }
+        advance(size - std::min(position, size));
+        if (sparse && ::ftruncate(out, static_cast<off_t>(size)) != 0)
+            throw std::system_error(errno, std::generic_category());
+    }
+
+    /**
+     * @param remaining What is left to copy, brought down as it is copied.
+     * @return False if copy_file_range cannot copy between these files; it may have copied a part.
+     */
+    bool CopyJob::copyRange(int in, int out, std::uint64_t& remaining)
+    {
+        if (_rangeUnsupported.load(std::memory_order_relaxed))
+            return false;
+
+        while (remaining > 0 && checkpoint()) {
+            std::size_t chunk = static_cast<std::size_t>(std::min<std::uint64_t>(RANGE_CHUNK_SIZE, remaining));
+            ssize_t n = ::copy_file_range(in, nullptr, out, nullptr, chunk, 0);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                if (unsupported(errno)) {
+                    _rangeUnsupported.store(true, std::memory_order_relaxed);
+                    return false;
+                }
+                throw std::system_error(errno, std::generic_category());
+            }
+            if (n == 0)
+                break;
+            remaining -= static_cast<std::uint64_t>(n);
+            advance(static_cast<std::uint64_t>(n));
+        }
+        return true;
+    }
+
+    /**
+     * @param remaining What is left to copy, brought down as it is copied.
+     * @return False if sendfile cannot copy between these files; it may have copied a part.
+     */
+    bool CopyJob::sendFile(int in, int out, std::uint64_t& remaining)
+    {
+        while (remaining > 0 && checkpoint()) {
+            std::size_t chunk = static_cast<std::size_t>(std::min<std::uint64_t>(RANGE_CHUNK_SIZE, remaining));
+            ssize_t n = ::sendfile(out, in, nullptr, chunk);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                if (unsupported(errno))
+                    return false;
+                throw std::system_error(errno, std::generic_category());
+            }
+            if (n == 0)
+                break;
+            remaining -= static_cast<std::uint64_t>(n);
+            advance(static_cast<std::uint64_t>(n));
+        }
+        return true;
+    }
+
+    /**
+     * @param remaining What is left to copy, brought down as it is copied.
+     */
+    void CopyJob::copyBuffered(int in, int out, std::uint64_t& remaining)
+    {
+        std::unique_ptr<char[]> buffer(new char[CHUNK_SIZE]);
+        while (remaining > 0 && checkpoint()) {
+            std::size_t chunk = static_cast<std::size_t>(std::min<std::uint64_t>(CHUNK_SIZE, remaining));
+            ssize_t n = ::read(in, buffer.get(), chunk);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::generic_category());
+            }
+            if (n == 0)
+                return;
+            for (ssize_t written = 0; written < n;) {
+                ssize_t w = ::write(out, buffer.get() + written, static_cast<std::size_t>(n - written));
+                if (w < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::system_error(errno, std::generic_category());
+                }
+                written += w;
+            }
+            remaining -= static_cast<std::uint64_t>(n);
+            advance(static_cast<std::uint64_t>(n));
+        }
+    }
+
+    /**
+     * @brief Copies a file through the read and write pipeline, hashing what is read.
+     * A descriptor in direct I/O that the kernel refuses an access on goes back through the cache.
+     * @return The digest of the source's data, or 0 if the copy was cancelled.
+     */
+    std::uint64_t CopyJob::copyHashed(int in, int out, std::uint64_t size, bool sparse)
+    {
+        // A chunk of data in one of the buffers, or a hole when buffer is -1
+        struct Chunk {
+            int buffer;
+            std::uint64_t offset;
+            std::uint64_t length;
+        };
+
+        AlignedBuffer buffers[2] = { AlignedBuffer(PIPELINE_CHUNK_SIZE), AlignedBuffer(PIPELINE_CHUNK_SIZE) };
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::deque<Chunk> filled;
+        std::vector<int> free = { 0, 1 };
+        bool reading = true;
+        std::exception_ptr writeError;
+        // Mirrors writeError for the reader to look at between chunks, without the lock
+        std::atomic<bool> writeFailed(false);
+        Checksum read;
+
+        std::thread writer([&] {
+            bool direct = (::fcntl(out, F_GETFL) & O_DIRECT) != 0;
+            try {
+                while (true) {
+                    Chunk chunk;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        changed.wait(lock, [&] { return !filled.empty() || !reading; });
+                        if (filled.empty())
+                            return;
+                        chunk = filled.front();
+                        filled.pop_front();
+                    }
+
+                    // A hole is left to the final size
+                    if (chunk.buffer >= 0) {
+                        char* data = buffers[chunk.buffer].data;
+                        // Direct I/O writes whole blocks: the tail is padded, and cut off by the final size
+                        std::uint64_t length = direct ? alignUp(chunk.length) : chunk.length;
+                        std::memset(data + chunk.length, 0, static_cast<std::size_t>(length - chunk.length));
+                        for (std::uint64_t done = 0; done < length;) {
+                            ssize_t w = ::pwrite(out, data + done, static_cast<std::size_t>(length - done),
+                                                 static_cast<off_t>(chunk.offset + done));
+                            if (w < 0) {
+                                if (errno == EINTR)
+                                    continue;
+                                if (errno == EINVAL && direct && setDirect(out, false)) {
+                                    direct = false;
+                                    length = chunk.length;
+                                    continue;
+                                }
+                                throw std::system_error(errno, std::generic_category());
+                            }
+                            done += static_cast<std::uint64_t>(w);
+                        }
+                    }
+                    advance(chunk.length);
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (chunk.buffer >= 0)
+                            free.push_back(chunk.buffer);
+                    }
+                    changed.notify_all();
+                }
+            } catch (...) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    writeError = std::current_exception();
+                    writeFailed.store(true, std::memory_order_release);
+                }
+                changed.notify_all();
+            }
+        });
+
+        auto push = [&](Chunk chunk) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                filled.push_back(chunk);
+            }
+            changed.notify_all();
+        };
+
+        try {
+            bool direct = (::fcntl(in, F_GETFL) & O_DIRECT) != 0;
+            std::uint64_t position = 0;
+            std::uint64_t start, end;
+
+            while (nextExtent(in, position, size, sparse, start, end) && checkpoint()) {
+                if (start > position) {
+                    read.updateZeros(start - position);
+                    push({ -1, position, start - position });
+                }
+                for (std::uint64_t offset = start; offset < end && checkpoint();) {
+                    int index;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        changed.wait(lock, [&] { return !free.empty() || writeError; });
+                        if (writeError)
+                            break;
+                        index = free.back();
+                        free.pop_back();
+                    }
+
+                    char* data = buffers[index].data;
+                    std::uint64_t length = std::min<std::uint64_t>(PIPELINE_CHUNK_SIZE, end - offset);
+                    std::uint64_t got = 0;
+                    while (got < length) {
+                        // Direct I/O reads whole blocks; past the end of the file, the read comes back short
+                        std::uint64_t want = direct ? alignUp(length - got) : length - got;
+                        ssize_t n = ::pread(in, data + got, static_cast<std::size_t>(want), static_cast<off_t>(offset + got));
+                        if (n < 0) {
+                            if (errno == EINTR)
+                                continue;
+                            if (errno == EINVAL && direct && setDirect(in, false)) {
+                                direct = false;
+                                continue;
+                            }
+                            throw std::system_error(errno, std::generic_category());
+                        }
+                        if (n == 0)
+                            break;
+                        got += static_cast<std::uint64_t>(n);
+                    }
+                    // The file may have shrunk since it was opened; a read past the extent brings nothing of it
+                    length = std::min(length, got);
+                    if (length == 0) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        free.push_back(index);
+                        end = offset;
+                        break;
+                    }
+
+                    read.update(data, static_cast<std::size_t>(length));
+                    push({ index, offset, length });
+                    offset += length;
+                }
+                position = end;
+                if (writeFailed.load(std::memory_order_acquire))
+                    break;
+            }
+            if (position < size && !cancelled() && !writeFailed.load(std::memory_order_acquire)) {
+                read.updateZeros(size - position);
+                push({ -1, position, size - position });
+            }
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                reading = false;
+            }
+            changed.notify_all();
+            writer.join();
+            throw;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            reading = false;
+        }
+        changed.notify_all();
+        writer.join();
+
+        if (writeError)
+            std::rethrow_exception(writeError);
+        if (cancelled())
+            return 0;
+        if (::ftruncate(out, static_cast<off_t>(size)) != 0)
+            throw std::system_error(errno, std::generic_category());
+        return read.digest();
+    }
+
+} // namespace core
@@ -0,0 +1,303 @@
+/**
+ * @file DeleteJob.cpp
+ * @brief Implementation of the core::DeleteJob class
+ * @date 2025-06-29
+ */
+
+#include "core/DeleteJob.hpp"
+#include "core/DirectoryScanner.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace core {
+
+    namespace {
+
+        constexpr std::size_t SCAN_BUFFER = 32 * 1024;
+        constexpr int DIRECTORY_FLAGS = O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC;
+
+        [[noreturn]] void fail(const std::string& path)
+        {
+            throw std::system_error(errno, std::generic_category(), path);
+        }
+
+        /**
+         * @brief Closes a descriptor when the directory is done with, whether it is read to the end or not.
+         */
+        struct FdGuard {
+            int fd = -1;
+
+            explicit FdGuard(int descriptor) noexcept : fd(descriptor) {}
+            FdGuard(FdGuard&& other) noexcept : fd(std::exchange(other.fd, -1)) {}
+            ~FdGuard() { if (fd >= 0) ::close(fd); }
+        };
+
+    } // namespace
+
+    /**
+     * @brief A directory being emptied, by its name in its parent; open once its walk reaches it.
+     * It keeps its parent, whose descriptor it is opened and removed through, for as long as it
+     * is there to be removed. pending counts its own walk and those of its subdirectories that
+     * are not removed yet.
+     */
+    struct DeleteJob::Directory {
+        std::shared_ptr<Directory> parent;
+        std::string name;
+        int fd = -1;
+        std::atomic<std::size_t> pending{1};
+
+        ~Directory() { if (fd >= 0) ::close(fd); }
+    };
+
+    /**
+     * @param description What the job is shown as.
+     * @param path The file or directory to remove.
+     */
+    DeleteJob::DeleteJob(std::string description, std::string path)
+        : Job(std::move(description)), _path(std::move(path)), _inFlight(0)
+    {}
+
+    void DeleteJob::run()
+    {
+        struct stat st;
+        if (::lstat(_path.c_str(), &st) != 0)
+            fail(_path);
+
+        if (!S_ISDIR(st.st_mode)) {
+            setTotals(0, 1);
+            if (::unlink(_path.c_str()) != 0 && errno != ENOENT)
+                fail(_path);
+            advance(0, 1);
+            return;
+        }
+
+        auto root = std::make_shared<Directory>();
+        root->fd = ::open(_path.c_str(), DIRECTORY_FLAGS);
+        if (root->fd < 0)
+            fail(_path);
+        setTotals(0, countEntries(root->fd) + 1);
+
+        ThreadPool pool(DELETE_THREADS);
+        submitDirectory(pool, std::move(root));
+        // The pool drops what it has not run yet when it goes: every task has to be done first
+        waitForTasks();
+        if (_failure)
+            std::rethrow_exception(_failure);
+    }
+
+    /**
+     * @brief Counts the entries under the root, from their names and types alone. The walk goes
+     * depth first, each directory opened relative to its parent, so that only the directories
+     * on the way down to the one being read are open.
+     */
+    std::uint64_t DeleteJob::countEntries(int rootFd)
+    {
+        struct Level {
+            FdGuard dir;
+            std::string name;
+            std::vector<std::string> subdirectories;
+        };
+
+        std::uint64_t count = 0;
+        std::vector<Level> chain;
+        auto enter = [&](FdGuard dir, std::string name) {
+            if (dir.fd < 0) {
+                std::string path = _path;
+                for (const auto& level : chain)
+                    if (!level.name.empty())
+                        path.append("/").append(level.name);
+                if (!name.empty())
+                    path.append("/").append(name);
+                fail(path);
+            }
+            Level level{std::move(dir), std::move(name), {}};
+            DirectoryScanner scanner(level.dir.fd, SCAN_BUFFER);
+            scanner.scan([&](std::string_view entry, EntryType type) {
+                ++count;
+                if (type == EntryType::DIRECTORY)
+                    level.subdirectories.emplace_back(entry);
+                return true;
+            });
+            chain.push_back(std::move(level));
+        };
+
+        // Read through a descriptor of its own, so that the root's is still at its start for the delete
+        enter(FdGuard(::openat(rootFd, ".", DIRECTORY_FLAGS)), {});
+        while (!chain.empty() && checkpoint()) {
+            Level& level = chain.back();
+            if (level.subdirectories.empty()) {
+                chain.pop_back();
+                continue;
+            }
+            std::string name = std::move(level.subdirectories.back());
+            level.subdirectories.pop_back();
+            FdGuard dir(::openat(level.dir.fd, name.c_str(), DIRECTORY_FLAGS));
+            enter(std::move(dir), std::move(name));
+        }
+        return count;
+    }
+
+    void DeleteJob::submitDirectory(ThreadPool& pool, std::shared_ptr<Directory> directory)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_inFlight;
+        }
+        pool.submit([this, &pool, directory = std::move(directory)]() mutable {
+            try {
+                if (checkpoint() && !failed())
+                    emptyTree(pool, std::move(directory));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_failure)
+                    _failure = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                --_inFlight;
+            }
+            _idle.notify_all();
+        });
+    }
+
+    /**
+     * @brief Removes a directory and what is under it, depth first, so that only the directories
+     * on the way down to the one being emptied are open. A subdirectory met while a worker of the
+     * pool has nothing to do is handed to a task of its own instead, so that subtrees are removed
+     * side by side.
+     */
+    void DeleteJob::emptyTree(ThreadPool& pool, std::shared_ptr<Directory> directory)
+    {
+        struct Level {
+            std::shared_ptr<Directory> directory;
+            std::vector<std::string> subdirectories;
+        };
+
+        std::vector<Level> chain;
+        Level top{std::move(directory), {}};
+        if (emptyDirectory(top.directory, top.subdirectories))
+            chain.push_back(std::move(top));
+
+        while (!chain.empty() && checkpoint() && !failed()) {
+            Level& level = chain.back();
+            if (level.subdirectories.empty()) {
+                std::shared_ptr<Directory> done = std::move(level.directory);
+                chain.pop_back();
+                release(std::move(done));
+                continue;
+            }
+
+            auto subdirectory = std::make_shared<Directory>();
+            subdirectory->parent = level.directory;
+            subdirectory->name = std::move(level.subdirectories.back());
+            level.subdirectories.pop_back();
+            level.directory->pending.fetch_add(1, std::memory_order_relaxed);
+            if (workerIdle()) {
+                submitDirectory(pool, std::move(subdirectory));
+                continue;
+            }
+
+            Level next{std::move(subdirectory), {}};
+            if (emptyDirectory(next.directory, next.subdirectories))
+                chain.push_back(std::move(next));
+        }
+    }
+
+    /**
+     * @brief Opens a directory relative to its parent, unlinks its files and lists its subdirectories.
+     * The names are read in full before anything is unlinked, since what a directory read returns
+     * once entries go is up to the file system. A directory gone already is released at once.
+     * @return False if there is nothing more to do with the directory, or the job stopped.
+     */
+    bool DeleteJob::emptyDirectory(const std::shared_ptr<Directory>& directory, std::vector<std::string>& subdirectories)
+    {
+        if (directory->fd < 0) {
+            directory->fd = ::openat(directory->parent->fd, directory->name.c_str(), DIRECTORY_FLAGS);
+            if (directory->fd < 0) {
+                if (errno != ENOENT)
+                    fail(pathOf(*directory));
+                release(directory);
+                return false;
+            }
+        }
+
+        std::vector<std::string> files;
+        DirectoryScanner scanner(directory->fd, SCAN_BUFFER);
+        scanner.scan([&](std::string_view name, EntryType type) {
+            (type == EntryType::DIRECTORY ? subdirectories : files).emplace_back(name);
+            return true;
+        });
+
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            if (i % CHECKPOINT_INTERVAL == 0 && (!checkpoint() || failed()))
+                return false;
+            if (::unlinkat(directory->fd, files[i].c_str(), 0) != 0 && errno != ENOENT)
+                fail(pathOf(*directory) + "/" + files[i]);
+            advance(0, 1);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Ends a walk of a directory; the last one closes and removes it, relative to its
+     * parent, and ends a walk of the parent. The root is removed by its own path.
+     */
+    void DeleteJob::release(std::shared_ptr<Directory> directory)
+    {
+        while (directory && directory->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (directory->fd >= 0)
+                ::close(std::exchange(directory->fd, -1));
+            int result = directory->parent ? ::unlinkat(directory->parent->fd, directory->name.c_str(), AT_REMOVEDIR)
+                                           : ::rmdir(_path.c_str());
+            if (result != 0 && errno != ENOENT)
+                fail(pathOf(*directory));
+            advance(0, 1);
+            directory = directory->parent;
+        }
+    }
+
+    /**
+     * @brief The path of a directory, from the names on its way up; only error messages need it.
+     */
+    std::string DeleteJob::pathOf(const Directory& directory) const
+    {
+        std::vector<const std::string*> names;
+        for (const Directory* d = &directory; d->parent; d = d->parent.get())
+            names.push_back(&d->name);
+
+        std::string path = _path;
+        for (auto it = names.rbegin(); it != names.rend(); ++it)
+            path.append("/").append(**it);
+        return path;
+    }
+
+    void DeleteJob::waitForTasks()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this] { return _inFlight == 0; });
+    }
+
+    /**
+     * @brief Whether a worker of the pool would otherwise wait: a subdirectory is worth a task of its own.
+     */
+    bool DeleteJob::workerIdle()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _inFlight < DELETE_THREADS;
+    }
+
+    bool DeleteJob::failed()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _failure != nullptr;
+    }
+
+} // namespace core
@@ -6,26 +6,46 @@
  */
 
 #include "core/Directory.hpp"
+#include "core/DirectoryScanner.hpp"
+#include <algorithm>
 #include <filesystem>
 #include <stdexcept>
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace core {
 
-    Directory::Directory(const std::string& path)
-        : _path(path)
+    Directory::Directory(const std::string& path, std::size_t cacheBudget, EventNotifier* notifier)
+        : _path(path), _fd(-1), _notifier(notifier), _wd(-1), _cache(_watcher, cacheBudget), _prefetcher(_watcher, notifier)
     {
         refresh();
     }
 
+    Directory::~Directory()
+    {
+        release();
+    }
+
     const std::string& Directory::getPath() const noexcept
     {
         return _path;
     }
 
+    /**
+     * @brief Moves to another directory.
+     * The current listing goes to the cache; the new one comes from it when still valid,
+     * otherwise a scan is started.
+     */
     void Directory::setPath(const std::string& path)
     {
+        _prefetcher.cancel();
+        _filter.clear();
+        stash();
         _path = path;
-        refresh();
+        if (!restore())
+            refresh();
     }
 
     bool Directory::exists() const noexcept
@@ -43,24 +63,460 @@ namespace core {
         return std::filesystem::remove_all(_path) > 0;
     }
 
-    std::vector<std::string> Directory::listFiles() const noexcept
+    NameSpan Directory::names() const noexcept
+    {
+        return NameSpan(_entries, shown());
+    }
+
+    const EntryTable& Directory::entries() const noexcept
+    {
+        return _entries;
+    }
+
+    bool Directory::isWatching() const noexcept
+    {
+        return _wd >= 0;
+    }
+
+    bool Directory::isLoading() const noexcept
+    {
+        return _scanner != nullptr;
+    }
+
+    /**
+     * @brief Number of entries the background scan has read so far.
+     */
+    std::size_t Directory::scannedCount() const noexcept
+    {
+        return _scanner ? _scanner->scannedCount() : _order.size();
+    }
+
+    SortOrder Directory::sortOrder() const noexcept
+    {
+        return _sortOrder;
+    }
+
+    /**
+     * @brief Changes how the listing is ordered, and sorts it right away.
+     */
+    void Directory::setSortOrder(SortOrder sortOrder)
+    {
+        if (sortOrder == _sortOrder)
+            return;
+        _sortOrder = sortOrder;
+        sortEntries();
+        _filter.rebuild(_entries, _order);
+    }
+
+    bool Directory::isFiltered() const noexcept
+    {
+        return _filter.active();
+    }
+
+    const std::string& Directory::filter() const noexcept
+    {
+        return _filter.pattern();
+    }
+
+    /**
+     * @brief Adds a character to the filter. Only the entries that matched so far are searched.
+     */
+    void Directory::pushFilter(char c)
+    {
+        _filter.push(_entries, _order, c);
+    }
+
+    /**
+     * @brief Removes the last character of the filter, going back to the matches it had.
+     */
+    void Directory::popFilter()
+    {
+        _filter.pop(_entries, _order);
+    }
+
+    void Directory::clearFilter() noexcept
+    {
+        _filter.clear();
+    }
+
+    /**
+     * @brief The order positions refer to: the matches of the filter when there is one.
+     */
+    const std::vector<EntryTable::Index>& Directory::shown() const noexcept
+    {
+        return _filter.active() ? _filter.matches() : _order;
+    }
+
+    ListingCache& Directory::cache() noexcept
+    {
+        return _cache;
+    }
+
+    /**
+     * @brief Warms up the entry at a position: a directory is pre-scanned into the cache,
+     * a small regular file is read ahead. Anything else cancels the pending prefetch.
+     * Cheap enough to call on every frame with the cursor position.
+     */
+    void Directory::prefetch(std::size_t pos)
+    {
+        if (pos >= shown().size()) {
+            _prefetcher.cancel();
+            return;
+        }
+
+        EntryTable::Index i = shown()[pos];
+        if (_entries.type(i) == EntryType::DIRECTORY) {
+            std::string path = pathOf(pos);
+            if (_cache.contains(path))
+                _prefetcher.cancel();
+            else
+                _prefetcher.prefetchDirectory(path);
+        } else if (_entries.type(i) == EntryType::REGULAR && loadStat(pos)
+                   && _entries.fileSize(i) <= Prefetcher::SMALL_FILE_LIMIT) {
+            _prefetcher.prefetchFile(pathOf(pos));
+        } else {
+            _prefetcher.cancel();
+        }
+    }
+
+    /**
+     * @brief Moves finished prefetches into the cache.
+     * A listing is dropped if it is incomplete, already cached, or the current directory;
+     * its watch goes with it unless someone else holds the same watch.
+     */
+    void Directory::adoptPrefetched()
+    {
+        for (auto& result : _prefetcher.collect()) {
+            bool current = ListingCache::keyOf(result.path) == ListingCache::keyOf(_path);
+            if (result.complete && !current && !_cache.contains(result.path) && result.listing.wd != _wd) {
+                _cache.store(result.path, std::move(result.listing));
+                continue;
+            }
+            if (result.listing.wd != _wd && !_cache.ownsWatch(result.listing.wd))
+                _watcher.unwatch(result.listing.wd);
+        }
+    }
+
+    int Directory::watchFd() const noexcept
+    {
+        return _watcher.fd();
+    }
+
+    EntryTable::Index Directory::entryAt(std::size_t pos) const noexcept
+    {
+        return shown()[pos];
+    }
+
+    /**
+     * @brief The attribute byte of an entry (see EntryTable). Never touches the filesystem.
+     */
+    std::uint8_t Directory::attributesAt(std::size_t pos) const noexcept
+    {
+        return _entries.attributes(shown()[pos]);
+    }
+
+    /**
+     * @brief Finds the position of an entry in the listing by name.
+     * @return The position, or npos if there is no such entry.
+     */
+    std::size_t Directory::indexOf(std::string_view name)
     {
-        std::vector<std::string> names;
+        EntryTable::Index i = _entries.find(name);
 
-        for (const auto& file : _files)
-            names.push_back(file.getName());
-        return names;
+        if (i == EntryTable::NPOS)
+            return npos;
+        const auto& order = shown();
+        auto it = std::find(order.begin(), order.end(), i);
+        return it == order.end() ? npos : static_cast<std::size_t>(it - order.begin());
     }
 
+    /**
+     * @brief Rebuilds the full path of an entry from the directory path.
+     */
+    std::string Directory::pathOf(std::size_t pos) const
+    {
+        std::string_view name = _entries.name(shown()[pos]);
+        std::string path;
+
+        path.reserve(_path.size() + 1 + name.size());
+        path.append(_path).append("/").append(name);
+        return path;
+    }
+
+    /**
+     * @brief Fetches size, mode and mtime of one entry with statx relative to the directory fd.
+     * Does nothing if they were already loaded.
+     * @return True if the entry's metadata is available.
+     */
+    bool Directory::loadStat(std::size_t pos) noexcept
+    {
+        EntryTable::Index i = shown()[pos];
+        struct statx stx;
+
+        if (_entries.hasStat(i))
+            return true;
+        if (_fd < 0 || ::statx(_fd, _entries.cname(i), AT_SYMLINK_NOFOLLOW | AT_STATX_SYNC_AS_STAT,
+                               STATX_TYPE | STATX_MODE | STATX_SIZE | STATX_MTIME, &stx) != 0)
+            return false;
+        _entries.setStat(i, stx.stx_size, stx.stx_mtime.tv_sec, stx.stx_mode);
+        return true;
+    }
+
+    /**
+     * @brief Builds a standalone core::File for an entry, e.g. for the information view.
+     */
+    File Directory::fileAt(std::size_t pos) const
+    {
+        EntryTable::Index i = shown()[pos];
+
+        return File(pathOf(pos), std::string(_entries.name(i)), _entries.type(i));
+    }
+
+    /**
+     * @brief Starts a background rescan of the directory, cancelling any scan in flight.
+     * The scan thread places the inotify watch before reading so that no change falls between
+     * the two; events for entries the scan already saw are absorbed by sync().
+     */
     void Directory::refresh()
     {
-        _files.clear();
-        if (!exists())
+        release();
+        _fd = ::open(_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (_fd < 0)
+            return;
+
+        int scanFd = ::openat(_fd, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (scanFd >= 0)
+            _scanner = std::make_unique<AsyncScanner>(scanFd, &_watcher, _path, _notifier);
+    }
+
+    /**
+     * @brief Drops the current listing: cancels its scan, removes its watch, closes the directory.
+     */
+    void Directory::release()
+    {
+        _scanner.reset();
+        _entries.clear();
+        _order.clear();
+        _filter.rebuild(_entries, _order);
+        _watcher.unwatch(_wd);
+        _wd = -1;
+        if (_fd >= 0)
+            ::close(_fd);
+        _fd = -1;
+    }
+
+    /**
+     * @brief Parks the current listing in the cache before leaving the directory.
+     * Pending events are applied first so that the listing is current when stored.
+     * Incomplete or unwatched listings are not worth keeping.
+     */
+    void Directory::stash()
+    {
+        if (_scanner || _wd < 0) {
+            applyEvents(false);
             return;
+        }
+        applyEvents(true);
+
+        auto stamp = DirectoryStamp::of(_path);
+        if (_scanner || _wd < 0 || !stamp)
+            return;
+        _cache.store(_path, CachedListing { std::move(_entries), std::move(_order), *stamp, _wd, _cache.generation(_wd), _sortOrder });
+        _wd = -1;
+        release();
+    }
+
+    /**
+     * @brief Takes the listing of _path from the cache if it is still valid.
+     * @return True if the listing was restored, false if it has to be scanned.
+     */
+    bool Directory::restore()
+    {
+        auto cached = _cache.take(_path);
+
+        if (!cached)
+            return false;
+        release();
+        _fd = ::open(_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (_fd < 0) {
+            _watcher.unwatch(cached->wd);
+            return false;
+        }
+        _entries = std::move(cached->entries);
+        _order = std::move(cached->order);
+        _wd = cached->wd;
+        if (cached->sorting != _sortOrder)
+            sortEntries();
+        _filter.rebuild(_entries, _order);
+        return true;
+    }
+
+    /**
+     * @brief Appends the batches the background scan has produced so far.
+     * Names go straight into the entry table arena; the metadata the scan thread reads in its
+     * second pass is filled in as it arrives.
+     * @return True if entries were added or the scan just completed.
+     */
+    bool Directory::pump()
+    {
+        bool changed = false;
+
+        while (auto batch = _scanner->poll()) {
+            if (batch->inspected) {
+                // No event is applied while loading, so scan positions are still table indices
+                for (std::size_t j = 0; j < batch->details.size(); ++j)
+                    _entries.setDetails(static_cast<EntryTable::Index>(batch->first + j), batch->details[j]);
+            } else {
+                batch->forEach([this](std::string_view name, const EntryDetails& details) {
+                    EntryTable::Index i = _entries.append(name, details.type);
+                    _entries.setDetails(i, details);
+                    _order.push_back(i);
+                });
+            }
+            changed = true;
+        }
+        if (_scanner->finished()) {
+            _wd = _scanner->takeWatch();
+            _scanner.reset();
+            _entries.shrinkToFit();
+            sortEntries();
+            changed = true;
+        }
+        return changed;
+    }
+
+    /**
+     * @brief Brings the listing up to date with the directory.
+     * Pending create/delete/move/attrib events are applied as patches to the entry table.
+     * A full rescan only happens when there is no watch, the event queue overflowed, or the
+     * directory itself was moved or deleted. While a scan is running, this only collects its batches.
+     * @return True if the listing may have changed.
+     */
+    bool Directory::sync()
+    {
+        adoptPrefetched();
+        bool changed = _scanner ? pump() : applyEvents(true);
+        if (changed)
+            _filter.rebuild(_entries, _order);
+        return changed;
+    }
+
+    /**
+     * @brief Drains the inotify queue.
+     * Events on cached directories bump their generation; events on the current one patch
+     * the listing when apply is true and are dropped otherwise.
+     * @return True if the listing may have changed.
+     */
+    bool Directory::applyEvents(bool apply)
+    {
+        bool changed = false;
+        bool rescan = apply && _wd < 0;
+
+        _watcher.drain([&](const WatchEvent& ev) {
+            if (ev.mask & IN_Q_OVERFLOW) {
+                _cache.clear();
+                rescan = apply;
+                return;
+            }
+            if (ev.wd != _wd) {
+                _cache.noteEvent(ev.wd);
+                return;
+            }
+            if (!apply || rescan)
+                return;
+            if (ev.mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+                rescan = true;
+            else if (ev.mask & (IN_CREATE | IN_MOVED_TO))
+                changed |= addEntry(ev.name);
+            else if (ev.mask & (IN_DELETE | IN_MOVED_FROM))
+                changed |= removeEntry(ev.name);
+            else if (ev.mask & (IN_ATTRIB | IN_MODIFY | IN_CLOSE_WRITE))
+                changed |= touchEntry(ev.name);
+        });
+
+        if (rescan) {
+            refresh();
+            return true;
+        }
+        if (_entries.removedCount() > 1024 && _entries.removedCount() * 4 > _entries.size())
+            compactEntries();
+        return changed;
+    }
+
+    bool Directory::addEntry(std::string_view name)
+    {
+        std::string cname(name);
+        EntryDetails details = DirectoryScanner::inspect(_fd, cname.c_str(), EntryType::UNKNOWN);
+
+        if (!details.stated)
+            return removeEntry(name);
+
+        EntryTable::Index i = _entries.find(name);
+        if (i == EntryTable::NPOS) {
+            i = _entries.append(name, details.type);
+            placeEntry(i);
+        }
+        _entries.setDetails(i, details);
+        return true;
+    }
+
+    bool Directory::removeEntry(std::string_view name)
+    {
+        EntryTable::Index i = _entries.find(name);
+
+        if (i == EntryTable::NPOS)
+            return false;
+        _entries.markRemoved(i);
+        _order.erase(std::find(_order.begin(), _order.end(), i));
+        return true;
+    }
+
+    bool Directory::touchEntry(std::string_view name)
+    {
+        EntryTable::Index i = _entries.find(name);
 
-        for (const auto& entry : std::filesystem::directory_iterator(_path)) {
-            _files.emplace_back(entry);
+        if (i == EntryTable::NPOS)
+            return false;
+
+        // A chmod can change the attribute byte, so the entry is inspected again right away
+        EntryDetails details = DirectoryScanner::inspect(_fd, _entries.cname(i), _entries.type(i));
+        _entries.setDetails(i, details);
+        if (!details.stated)
+            _entries.invalidateStat(i);
+
+        if (ListingSorter::dependsOnStat(_sortOrder)) {
+            _order.erase(std::find(_order.begin(), _order.end(), i));
+            placeEntry(i);
         }
+        return true;
+    }
+
+    /**
+     * @brief Inserts an entry into the display order where the sort order puts it.
+     */
+    void Directory::placeEntry(EntryTable::Index i)
+    {
+        _order.insert(_order.begin() + ListingSorter::position(_entries, _order, i, _sortOrder), i);
+    }
+
+    /**
+     * @brief Sorts the whole display order. While loading, this only orders what arrived so far.
+     */
+    void Directory::sortEntries()
+    {
+        ListingSorter::sort(_entries, _order, _sortOrder);
+    }
+
+    /**
+     * @brief Reclaims the slots of removed entries once they make up a good part of the table.
+     */
+    void Directory::compactEntries()
+    {
+        std::vector<EntryTable::Index> remap = _entries.compact();
+
+        for (auto& i : _order)
+            i = remap[i];
+        _filter.rebuild(_entries, _order);
     }
 
 }
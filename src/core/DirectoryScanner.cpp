@@ -0,0 +1,144 @@
+/**
+ * @file DirectoryScanner.cpp
+ * @brief Implementation of the core::DirectoryScanner class
+ * @date 2025-06-02
+ */
+
+#include "core/DirectoryScanner.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace core {
+
+    DirectoryScanner::DirectoryScanner(const std::string& path, std::size_t bufferSize)
+        : _fd(::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)),
+          _ownsFd(true),
+          _bufferSize(bufferSize),
+          _buffer(std::make_unique<char[]>(bufferSize))
+    {}
+
+    /**
+     * @brief Scans an already opened directory. The descriptor stays owned by the caller.
+     */
+    DirectoryScanner::DirectoryScanner(int dirFd, std::size_t bufferSize)
+        : _fd(dirFd),
+          _ownsFd(false),
+          _bufferSize(bufferSize),
+          _buffer(std::make_unique<char[]>(bufferSize))
+    {}
+
+    DirectoryScanner::~DirectoryScanner()
+    {
+        if (_ownsFd && _fd >= 0)
+            ::close(_fd);
+    }
+
+    bool DirectoryScanner::isOpen() const noexcept
+    {
+        return _fd >= 0;
+    }
+
+    int DirectoryScanner::fd() const noexcept
+    {
+        return _fd;
+    }
+
+    /**
+     * @brief Fills the buffer with as many raw dirents as the kernel returns in one call.
+     * @return The number of bytes read, 0 at the end of the directory, -1 on error.
+     */
+    long DirectoryScanner::readBatch() noexcept
+    {
+        return ::syscall(SYS_getdents64, _fd, _buffer.get(), _bufferSize);
+    }
+
+    EntryType DirectoryScanner::resolveUnknown(const char* name) const noexcept
+    {
+        struct stat st;
+
+        if (::fstatat(_fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+            return EntryType::UNKNOWN;
+        return typeFromMode(st.st_mode);
+    }
+
+    EntryType DirectoryScanner::typeFromDirent(unsigned char dtype) noexcept
+    {
+        switch (dtype) {
+            case DT_REG: return EntryType::REGULAR;
+            case DT_DIR: return EntryType::DIRECTORY;
+            case DT_LNK: return EntryType::SYMLINK;
+            case DT_UNKNOWN: return EntryType::UNKNOWN;
+            default: return EntryType::OTHER;
+        }
+    }
+
+    EntryType DirectoryScanner::typeFromMode(unsigned int mode) noexcept
+    {
+        switch (mode & S_IFMT) {
+            case S_IFREG: return EntryType::REGULAR;
+            case S_IFDIR: return EntryType::DIRECTORY;
+            case S_IFLNK: return EntryType::SYMLINK;
+            default: return EntryType::OTHER;
+        }
+    }
+
+    /**
+     * @brief Works out the attribute byte from the scan alone: no syscall, but no exec bit,
+     * and a symlink is not followed.
+     */
+    EntryDetails DirectoryScanner::describe(std::string_view name, EntryType type) noexcept
+    {
+        EntryDetails details;
+        std::uint8_t flags = 0;
+
+        details.type = type;
+        if (type == EntryType::DIRECTORY)
+            flags |= EntryTable::ATTR_DIRECTORY;
+        else if (type == EntryType::SYMLINK)
+            flags |= EntryTable::ATTR_SYMLINK;
+        details.attributes = EntryTable::makeAttributes(flags, classifyName(name));
+        return details;
+    }
+
+    /**
+     * @brief Stats one entry and works out its attribute byte.
+     * The entry itself is not followed, so size and mode are those of a symlink, as loadStat()
+     * reports them; a symlink costs a second statx to find out what it points to.
+     * @param dirFd The directory the name is relative to.
+     * @param name The entry name, NUL-terminated.
+     * @param type The type the scan reported; replaced by the one statx finds, if it succeeds.
+     */
+    EntryDetails DirectoryScanner::inspect(int dirFd, const char* name, EntryType type) noexcept
+    {
+        EntryDetails details;
+        struct statx stx;
+
+        details.type = type;
+        if (::statx(dirFd, name, AT_SYMLINK_NOFOLLOW | AT_STATX_SYNC_AS_STAT,
+                    STATX_TYPE | STATX_MODE | STATX_SIZE | STATX_MTIME, &stx) == 0) {
+            details.stated = true;
+            details.type = typeFromMode(stx.stx_mode);
+            details.mode = stx.stx_mode;
+            details.size = stx.stx_size;
+            details.mtime = stx.stx_mtime.tv_sec;
+        }
+
+        std::uint8_t flags = 0;
+        unsigned int mode = details.mode;
+        if (details.type == EntryType::SYMLINK) {
+            flags |= EntryTable::ATTR_SYMLINK;
+            mode = ::statx(dirFd, name, AT_STATX_SYNC_AS_STAT, STATX_TYPE | STATX_MODE, &stx) == 0 ? stx.stx_mode : 0;
+        }
+        if (details.type == EntryType::DIRECTORY || S_ISDIR(mode))
+            flags |= EntryTable::ATTR_DIRECTORY;
+        else if (mode & S_IXUSR)
+            flags |= EntryTable::ATTR_EXECUTABLE;
+        details.attributes = EntryTable::makeAttributes(flags, classifyName(name));
+        return details;
+    }
+
+} // namespace core
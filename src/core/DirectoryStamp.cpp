@@ -0,0 +1,44 @@
+/**
+ * @file DirectoryStamp.cpp
+ * @brief Implementation of the core::DirectoryStamp structure
+ * @date 2025-06-24
+ */
+
+#include "core/DirectoryStamp.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+namespace core {
+
+    namespace {
+
+        std::optional<DirectoryStamp> stampOf(int dirFd, const char* path, int flags) noexcept
+        {
+            struct statx stx;
+
+            if (::statx(dirFd, path, AT_STATX_SYNC_AS_STAT | flags, STATX_MTIME | STATX_CTIME, &stx) != 0)
+                return std::nullopt;
+            return DirectoryStamp { stx.stx_mtime.tv_sec, stx.stx_mtime.tv_nsec, stx.stx_ctime.tv_sec, stx.stx_ctime.tv_nsec };
+        }
+
+    } // namespace
+
+    /**
+     * @brief Reads the stamp of a directory with one statx call.
+     */
+    std::optional<DirectoryStamp> DirectoryStamp::of(const std::string& path) noexcept
+    {
+        return stampOf(AT_FDCWD, path.c_str(), 0);
+    }
+
+    /**
+     * @brief Reads the stamp of a directory given relative to dirFd, without following a final
+     * symbolic link.
+     */
+    std::optional<DirectoryStamp> DirectoryStamp::of(int dirFd, const char* path) noexcept
+    {
+        return stampOf(dirFd, path, AT_SYMLINK_NOFOLLOW);
+    }
+
+} // namespace core
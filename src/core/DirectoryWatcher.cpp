@@ -0,0 +1,45 @@
+/**
+ * @file DirectoryWatcher.cpp
+ * @brief Implementation of the core::DirectoryWatcher class
+ * @date 2025-06-06
+ */
+
+#include "core/DirectoryWatcher.hpp"
+
+#include <unistd.h>
+
+namespace core {
+
+    DirectoryWatcher::DirectoryWatcher()
+        : _fd(::inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+    {}
+
+    DirectoryWatcher::~DirectoryWatcher()
+    {
+        if (_fd >= 0)
+            ::close(_fd);
+    }
+
+    int DirectoryWatcher::fd() const noexcept
+    {
+        return _fd;
+    }
+
+    /**
+     * @brief Adds a watch on a directory.
+     * @return The watch descriptor, or -1 if inotify is unavailable or the path cannot be watched.
+     */
+    int DirectoryWatcher::watch(const std::string& path, std::uint32_t mask) noexcept
+    {
+        if (_fd < 0)
+            return -1;
+        return ::inotify_add_watch(_fd, path.c_str(), mask);
+    }
+
+    void DirectoryWatcher::unwatch(int wd) noexcept
+    {
+        if (_fd >= 0 && wd >= 0)
+            ::inotify_rm_watch(_fd, wd);
+    }
+
+} // namespace core
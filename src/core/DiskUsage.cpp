@@ -0,0 +1,267 @@
+/**
+ * @file DiskUsage.cpp
+ * @brief Implementation of the core::DiskUsage class
+ * @date 2025-06-26
+ */
+
+#include "core/DiskUsage.hpp"
+#include "core/DirectoryScanner.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace core {
+
+    namespace {
+
+        constexpr std::size_t SCAN_BUFFER = 32 * 1024;
+
+        std::uint64_t allocatedBytes(const struct stat& st) noexcept
+        {
+            // st_blocks counts 512-byte units, whatever the file system's block size
+            return static_cast<std::uint64_t>(st.st_blocks) * 512;
+        }
+
+        std::int64_t monotonicNow() noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+    } // namespace
+
+    /**
+     * @brief A directory's descriptor, kept open until its subdirectories are opened relative to it.
+     */
+    struct DiskUsage::Directory {
+        int fd;
+
+        explicit Directory(int descriptor) noexcept : fd(descriptor) {}
+        ~Directory() { ::close(fd); }
+
+        Directory(const Directory&) = delete;
+        Directory& operator=(const Directory&) = delete;
+    };
+
+    /**
+     * @brief Starts sizing right away.
+     * @param root The directory to size.
+     * @param cache Optional cache that receives the totals of every directory completed.
+     * @param notifier Optional notifier, signalled as the totals grow and when the walk ends.
+     * @param keepFiles Whether the tree keeps the name and size of each file, not only the totals.
+     * @param pool The pool the walk runs on.
+     */
+    DiskUsage::DiskUsage(const std::string& root, UsageCache* cache, EventNotifier* notifier, bool keepFiles,
+                         ThreadPool& pool)
+        : _root(root), _rootFd(-1), _cache(cache), _notifier(notifier), _keepFiles(keepFiles), _pool(pool),
+          _pending(0), _cancelled(false), _finished(false), _bytes(0), _allocated(0), _files(0), _directories(0),
+          _errors(0), _lastNotify(0)
+    {
+        _tree.name = root;
+        if (_cache)
+            _base = UsageCache::keyOf(root);
+        _rootFd = ::open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (_rootFd < 0) {
+            _errors = 1;
+            _tree.unreadable = true;
+            _finished = true;
+            return;
+        }
+        submit([this] { walk(&_tree, nullptr); });
+    }
+
+    DiskUsage::~DiskUsage()
+    {
+        _cancelled = true;
+        wait();
+        if (_rootFd >= 0)
+            ::close(_rootFd);
+    }
+
+    /**
+     * @brief Blocks until the walk is finished or, once cancelled, stopped.
+     */
+    void DiskUsage::wait()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this] { return _pending == 0; });
+    }
+
+    /**
+     * @brief The totals of everything listed so far, in every directory, complete or not.
+     */
+    UsageTotals DiskUsage::progress() const noexcept
+    {
+        UsageTotals totals;
+
+        totals.bytes = _bytes.load(std::memory_order_relaxed);
+        totals.allocated = _allocated.load(std::memory_order_relaxed);
+        totals.files = _files.load(std::memory_order_relaxed);
+        totals.directories = _directories.load(std::memory_order_relaxed);
+        return totals;
+    }
+
+    void DiskUsage::submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_pending;
+        }
+        _pool.submit(std::move(task));
+    }
+
+    /**
+     * @brief Ends a task. The last one marks the walk finished.
+     */
+    void DiskUsage::done()
+    {
+        EventNotifier* notifier = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_pending == 0) {
+                _finished.store(true, std::memory_order_release);
+                notifier = _notifier;
+                // The destructor may run as soon as the lock is released: no member is used past it
+                _idle.notify_all();
+            }
+        }
+        if (notifier)
+            notifier->notify();
+    }
+
+    /**
+     * @brief Lists one directory, opened relative to its parent, sizes its entries and queues
+     * its subdirectories.
+     * @param parent The parent directory, or none for the root.
+     */
+    void DiskUsage::walk(UsageNode* node, std::shared_ptr<const Directory> parent)
+    {
+        int fd = -1;
+        if (!_cancelled.load(std::memory_order_relaxed)) {
+            fd = ::openat(parent ? parent->fd : _rootFd, parent ? node->name.c_str() : ".",
+                          O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+            if (fd < 0) {
+                _errors.fetch_add(1, std::memory_order_relaxed);
+                node->unreadable = true;
+            }
+        }
+        // The parent is only needed to open the directory: it closes once its last subdirectory is open
+        parent.reset();
+        if (fd >= 0) {
+            auto directory = std::make_shared<const Directory>(fd);
+            UsageTotals listed;
+            struct stat st;
+
+            if (::fstat(fd, &st) == 0) {
+                listed.bytes += static_cast<std::uint64_t>(st.st_size);
+                listed.allocated += allocatedBytes(st);
+            }
+
+            DirectoryScanner scanner(fd, SCAN_BUFFER);
+            scanner.scan([&](std::string_view name, EntryType type) {
+                if (type == EntryType::DIRECTORY) {
+                    auto child = std::make_unique<UsageNode>();
+                    child->name = std::string(name);
+                    child->parent = node;
+                    UsageNode* raw = child.get();
+                    node->children.push_back(std::move(child));
+                    node->remaining.fetch_add(1, std::memory_order_relaxed);
+                    ++listed.directories;
+                    submit([this, raw, directory] { walk(raw, directory); });
+                } else if (::fstatat(fd, name.data(), &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                    _errors.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    bool duplicate = st.st_nlink > 1 && !firstLink(st.st_dev, st.st_ino);
+                    UsageFile file { 0, 0, 0, 0, duplicate };
+                    if (!duplicate) {
+                        file.bytes = static_cast<std::uint64_t>(st.st_size);
+                        file.allocated = allocatedBytes(st);
+                        listed.bytes += file.bytes;
+                        listed.allocated += file.allocated;
+                        ++listed.files;
+                    }
+                    if (_keepFiles) {
+                        file.nameOffset = static_cast<std::uint32_t>(node->fileNames.size());
+                        file.nameLength = static_cast<std::uint16_t>(name.size());
+                        node->fileNames.append(name);
+                        node->files.push_back(file);
+                    }
+                }
+                return !_cancelled.load(std::memory_order_relaxed);
+            });
+
+            node->own = listed;
+            report(listed);
+        }
+        // A cancelled walk leaves its directories incomplete, so partial totals never reach the cache
+        if (!_cancelled.load(std::memory_order_relaxed))
+            complete(node);
+        done();
+    }
+
+    /**
+     * @brief Ends the listing of a directory, or the walk of one of its subdirectories. Whoever
+     * ends the last of them adds up the subtree, then does the same for the parent.
+     */
+    void DiskUsage::complete(UsageNode* node)
+    {
+        while (node && node->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            UsageTotals total = node->own;
+            for (const auto& child : node->children)
+                total += child->total;
+            node->total = total;
+            node->complete.store(true, std::memory_order_release);
+            if (_cache)
+                _cache->store(pathOf(node), total);
+            node = node->parent;
+        }
+    }
+
+    /**
+     * @brief Whether this is the first link met to a file with several.
+     */
+    bool DiskUsage::firstLink(std::uint64_t device, std::uint64_t inode)
+    {
+        LinkShard& shard = _links[(inode ^ device) % LINK_SHARDS];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        return shard.seen.emplace(device, inode).second;
+    }
+
+    /**
+     * @brief Adds a listed directory to the running totals and signals the notifier if the
+     * last signal is old enough.
+     */
+    void DiskUsage::report(const UsageTotals& listed)
+    {
+        _bytes.fetch_add(listed.bytes, std::memory_order_relaxed);
+        _allocated.fetch_add(listed.allocated, std::memory_order_relaxed);
+        _files.fetch_add(listed.files, std::memory_order_relaxed);
+        _directories.fetch_add(listed.directories, std::memory_order_relaxed);
+
+        if (!_notifier)
+            return;
+        std::int64_t now = monotonicNow();
+        std::int64_t last = _lastNotify.load(std::memory_order_relaxed);
+        if (now - last >= std::chrono::nanoseconds(NOTIFY_INTERVAL).count()
+            && _lastNotify.compare_exchange_strong(last, now, std::memory_order_relaxed))
+            _notifier->notify();
+    }
+
+    /**
+     * @brief The canonical path of a directory of the tree, its cache key.
+     */
+    std::string DiskUsage::pathOf(const UsageNode* node) const
+    {
+        std::vector<const UsageNode*> chain;
+        for (; node->parent; node = node->parent)
+            chain.push_back(node);
+
+        std::string path = _base;
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+            path += (path == "/" ? "" : "/") + (*it)->name;
+        return path;
+    }
+
+} // namespace core
@@ -0,0 +1,215 @@
+/**
+ * @file EntryTable.cpp
+ * @brief Implementation of the core::EntryTable class
+ * @date 2025-06-04
+ */
+
+#include "core/EntryTable.hpp"
+
+namespace core {
+
+    void EntryTable::clear() noexcept
+    {
+        _names.clear();
+        _nameOffsets.clear();
+        _nameLengths.clear();
+        _types.clear();
+        _flags.clear();
+        _attributes.clear();
+        _modes.clear();
+        _sizes.clear();
+        _mtimes.clear();
+        _slots.clear();
+        _removed = 0;
+    }
+
+    void EntryTable::reserve(std::size_t entries, std::size_t nameBytes)
+    {
+        _names.reserve(nameBytes);
+        _nameOffsets.reserve(entries);
+        _nameLengths.reserve(entries);
+        _types.reserve(entries);
+        _flags.reserve(entries);
+        _attributes.reserve(entries);
+        _modes.reserve(entries);
+        _sizes.reserve(entries);
+        _mtimes.reserve(entries);
+    }
+
+    /**
+     * @brief Drops the slack left by vector growth once a scan is complete.
+     */
+    void EntryTable::shrinkToFit()
+    {
+        _names.shrink_to_fit();
+        _nameOffsets.shrink_to_fit();
+        _nameLengths.shrink_to_fit();
+        _types.shrink_to_fit();
+        _flags.shrink_to_fit();
+        _attributes.shrink_to_fit();
+        _modes.shrink_to_fit();
+        _sizes.shrink_to_fit();
+        _mtimes.shrink_to_fit();
+    }
+
+    /**
+     * @brief Appends an entry whose metadata has not been fetched yet.
+     * @param name The entry name; NAME_MAX guarantees it fits the 8-bit length column.
+     * @param type The type reported by the scan.
+     * @return The index of the new entry.
+     */
+    EntryTable::Index EntryTable::append(std::string_view name, EntryType type)
+    {
+        auto index = static_cast<Index>(_types.size());
+
+        _nameOffsets.push_back(static_cast<std::uint32_t>(_names.size()));
+        _nameLengths.push_back(static_cast<std::uint8_t>(name.size()));
+        _names.insert(_names.end(), name.begin(), name.end());
+        _names.push_back('\0');
+        _types.push_back(type);
+        _flags.push_back(0);
+        _attributes.push_back(0);
+        _modes.push_back(0);
+        _sizes.push_back(0);
+        _mtimes.push_back(0);
+
+        if (!_slots.empty()) {
+            if (_types.size() * 2 > _slots.size())
+                buildIndex();
+            else
+                indexInsert(index);
+        }
+        return index;
+    }
+
+    void EntryTable::setStat(Index i, std::uint64_t size, std::int64_t mtime, std::uint16_t mode) noexcept
+    {
+        _sizes[i] = size;
+        _mtimes[i] = mtime;
+        _modes[i] = mode;
+        _flags[i] |= FLAG_STAT;
+    }
+
+    /**
+     * @brief Stores what inspecting an entry found. Metadata is left alone if the statx failed.
+     */
+    void EntryTable::setDetails(Index i, const EntryDetails& details) noexcept
+    {
+        if (details.stated)
+            setStat(i, details.size, details.mtime, details.mode);
+        _attributes[i] = details.attributes;
+    }
+
+    /**
+     * @brief Marks an entry as gone. Its slot and name bytes are reclaimed by compact().
+     */
+    void EntryTable::markRemoved(Index i) noexcept
+    {
+        if (_flags[i] & FLAG_REMOVED)
+            return;
+        _flags[i] |= FLAG_REMOVED;
+        ++_removed;
+    }
+
+    /**
+     * @brief Looks up a live entry by name through an open-addressing index of entry numbers.
+     * The index costs 8 bytes per entry, so it is only built the first time a listing is patched.
+     * @return The entry index, or NPOS.
+     */
+    EntryTable::Index EntryTable::find(std::string_view name)
+    {
+        if (_slots.empty()) {
+            if (_types.empty())
+                return NPOS;
+            buildIndex();
+        }
+
+        std::size_t mask = _slots.size() - 1;
+        for (std::size_t slot = hashName(name) & mask;; slot = (slot + 1) & mask) {
+            Index i = _slots[slot];
+            if (i == NPOS)
+                return NPOS;
+            if (!(_flags[i] & FLAG_REMOVED) && this->name(i) == name)
+                return i;
+        }
+    }
+
+    /**
+     * @brief Drops removed entries and repacks the arena.
+     * @return For every old index, its new index, or NPOS if it was removed.
+     */
+    std::vector<EntryTable::Index> EntryTable::compact()
+    {
+        std::vector<Index> remap(_types.size(), NPOS);
+        EntryTable packed;
+        bool indexed = !_slots.empty();
+
+        packed.reserve(_types.size() - _removed, _names.size());
+        for (Index i = 0; i < _types.size(); ++i) {
+            if (_flags[i] & FLAG_REMOVED)
+                continue;
+            Index j = packed.append(name(i), _types[i]);
+            packed._flags[j] = _flags[i];
+            packed._attributes[j] = _attributes[i];
+            packed._modes[j] = _modes[i];
+            packed._sizes[j] = _sizes[i];
+            packed._mtimes[j] = _mtimes[i];
+            remap[i] = j;
+        }
+        *this = std::move(packed);
+        if (indexed)
+            buildIndex();
+        return remap;
+    }
+
+    /**
+     * @brief Bytes held by the table, capacity included.
+     */
+    std::size_t EntryTable::memoryUsage() const noexcept
+    {
+        return _names.capacity()
+            + _nameOffsets.capacity() * sizeof(std::uint32_t)
+            + _nameLengths.capacity() * sizeof(std::uint8_t)
+            + _types.capacity() * sizeof(EntryType)
+            + _flags.capacity() * sizeof(std::uint8_t)
+            + _attributes.capacity() * sizeof(std::uint8_t)
+            + _modes.capacity() * sizeof(std::uint16_t)
+            + _sizes.capacity() * sizeof(std::uint64_t)
+            + _mtimes.capacity() * sizeof(std::int64_t)
+            + _slots.capacity() * sizeof(Index);
+    }
+
+    std::uint64_t EntryTable::hashName(std::string_view name) noexcept
+    {
+        std::uint64_t h = 14695981039346656037ull;
+
+        for (unsigned char c : name) {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+        return h ^ (h >> 29);
+    }
+
+    void EntryTable::buildIndex()
+    {
+        std::size_t capacity = 16;
+
+        while (capacity < _types.size() * 2 + 2)
+            capacity <<= 1;
+        _slots.assign(capacity, NPOS);
+        for (Index i = 0; i < _types.size(); ++i)
+            if (!(_flags[i] & FLAG_REMOVED))
+                indexInsert(i);
+    }
+
+    void EntryTable::indexInsert(Index i) noexcept
+    {
+        std::size_t mask = _slots.size() - 1;
+        std::size_t slot = hashName(name(i)) & mask;
+
+        while (_slots[slot] != NPOS)
+            slot = (slot + 1) & mask;
+        _slots[slot] = i;
+    }
+
+} // namespace core
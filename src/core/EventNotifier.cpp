@@ -0,0 +1,50 @@
+/**
+ * @file EventNotifier.cpp
+ * @brief Implementation of the core::EventNotifier class
+ * @date 2025-06-18
+ */
+
+#include "core/EventNotifier.hpp"
+
+#include <cstdint>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace core {
+
+    EventNotifier::EventNotifier()
+        : _fd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {}
+
+    EventNotifier::~EventNotifier()
+    {
+        if (_fd >= 0)
+            ::close(_fd);
+    }
+
+    int EventNotifier::fd() const noexcept
+    {
+        return _fd;
+    }
+
+    void EventNotifier::notify() noexcept
+    {
+        std::uint64_t one = 1;
+
+        if (_fd >= 0)
+            (void)::write(_fd, &one, sizeof(one));
+    }
+
+    /**
+     * @brief Resets the counter, so the descriptor stops polling readable.
+     */
+    void EventNotifier::drain() noexcept
+    {
+        std::uint64_t count;
+
+        if (_fd >= 0)
+            (void)::read(_fd, &count, sizeof(count));
+    }
+
+} // namespace core
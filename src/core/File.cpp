@@ -6,22 +6,47 @@
  */
 
 #include "core/File.hpp"
-#include <chrono>
+#include "core/DirectoryScanner.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
 
 namespace core {
 
     File::File(const std::filesystem::directory_entry& entry)
-        : _name(entry.path().filename().string()),
-          _path(entry.path().string()),
-          _size(entry.is_regular_file() ? entry.file_size() : 0),
-          _isDirectory(entry.is_directory())
+        : File(entry.path().string(), entry.path().filename().string(), EntryType::UNKNOWN)
+    {}
+
+    File::File(std::string path, std::string name, EntryType type)
+        : _name(std::move(name)),
+          _path(std::move(path)),
+          _type(type),
+          _statLoaded(false),
+          _targetIsDirectory(type == EntryType::DIRECTORY),
+          _size(0),
+          _lastModified(0)
+    {}
+
+    /**
+     * @brief Fetches size, type and modification time with one statx call.
+     * Symlinks are followed, like std::filesystem::is_directory() did, so a link
+     * to a directory still opens as a directory.
+     */
+    void File::loadStat() const noexcept
     {
-        // Get last modification time and convert to time_t
-        auto ftime = entry.last_write_time();
-        auto systemTime = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-            ftime - std::filesystem::file_time_type::clock::now()
-            + std::chrono::system_clock::now());
-        _lastModified = std::chrono::system_clock::to_time_t(systemTime);
+        struct statx stx;
+
+        if (_statLoaded)
+            return;
+        _statLoaded = true;
+        if (::statx(AT_FDCWD, _path.c_str(), AT_STATX_SYNC_AS_STAT,
+                    STATX_TYPE | STATX_SIZE | STATX_MTIME, &stx) != 0)
+            return;
+
+        EntryType target = DirectoryScanner::typeFromMode(stx.stx_mode);
+        _targetIsDirectory = target == EntryType::DIRECTORY;
+        _size = target == EntryType::REGULAR ? stx.stx_size : 0;
+        _lastModified = static_cast<std::time_t>(stx.stx_mtime.tv_sec);
     }
 
     const std::string& File::getName() const noexcept { 
@@ -33,15 +58,26 @@ namespace core {
     }
 
     std::uintmax_t File::getSize() const noexcept { 
+        loadStat();
         return _size; 
     }
 
     bool File::isDirectory() const noexcept { 
-        return _isDirectory; 
+        if (_type == EntryType::DIRECTORY)
+            return true;
+        if (_type == EntryType::REGULAR || _type == EntryType::OTHER)
+            return false;
+        loadStat();
+        return _targetIsDirectory; 
     }
 
     std::time_t File::getLastModified() const noexcept { 
+        loadStat();
         return _lastModified; 
     }
 
+    EntryType File::getType() const noexcept {
+        return _type;
+    }
+
 }
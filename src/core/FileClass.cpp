@@ -0,0 +1,319 @@
+/**
+ * @file FileClass.cpp
+ * @brief Implementation of the core::classifyName function and of its extension table
+ * @date 2025-06-19
+ */
+
+#include "core/FileClass.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace core {
+
+    namespace {
+
+        struct Extension {
+            std::string_view name;
+            FileClass fileClass;
+        };
+
+        constexpr FileClass ARC = FileClass::ARCHIVE;
+        constexpr FileClass IMG = FileClass::IMAGE;
+        constexpr FileClass AUD = FileClass::AUDIO;
+        constexpr FileClass VID = FileClass::VIDEO;
+        constexpr FileClass DOC = FileClass::DOCUMENT;
+        constexpr FileClass SRC = FileClass::SOURCE;
+        constexpr FileClass SCR = FileClass::SCRIPT;
+        constexpr FileClass DAT = FileClass::DATA;
+        constexpr FileClass FNT = FileClass::FONT;
+        constexpr FileClass BIN = FileClass::BINARY;
+
+        // Lowercase, at most 8 characters. Lookups are case-insensitive.
+        constexpr Extension EXTENSIONS[] = {
+            // Archives and packages
+            {"zip", ARC}, {"zipx", ARC}, {"tar", ARC}, {"gz", ARC}, {"tgz", ARC}, {"bz2", ARC},
+            {"tbz", ARC}, {"tbz2", ARC}, {"xz", ARC}, {"txz", ARC}, {"lz", ARC}, {"lzma", ARC},
+            {"tlz", ARC}, {"lz4", ARC}, {"lzo", ARC}, {"zst", ARC}, {"tzst", ARC}, {"br", ARC},
+            {"z", ARC}, {"sz", ARC}, {"7z", ARC}, {"rar", ARC}, {"cab", ARC}, {"arj", ARC},
+            {"lzh", ARC}, {"lha", ARC}, {"ace", ARC}, {"arc", ARC}, {"zpaq", ARC}, {"cpio", ARC},
+            {"shar", ARC}, {"deb", ARC}, {"udeb", ARC}, {"rpm", ARC}, {"apk", ARC}, {"xapk", ARC},
+            {"jar", ARC}, {"war", ARC}, {"ear", ARC}, {"aar", ARC}, {"whl", ARC}, {"egg", ARC},
+            {"gem", ARC}, {"nupkg", ARC}, {"crate", ARC}, {"snap", ARC}, {"flatpak", ARC},
+            {"appimage", ARC}, {"xpi", ARC}, {"crx", ARC}, {"vsix", ARC}, {"pkg", ARC},
+            {"dmg", ARC}, {"iso", ARC}, {"squashfs", ARC}, {"wim", ARC}, {"vhd", ARC},
+            {"vhdx", ARC}, {"vmdk", ARC}, {"qcow2", ARC}, {"pak", ARC}, {"cbz", ARC},
+            {"cbr", ARC}, {"ipa", ARC},
+
+            // Images
+            {"png", IMG}, {"apng", IMG}, {"jpg", IMG}, {"jpeg", IMG}, {"jpe", IMG}, {"jfif", IMG},
+            {"gif", IMG}, {"bmp", IMG}, {"dib", IMG}, {"tif", IMG}, {"tiff", IMG}, {"webp", IMG},
+            {"ico", IMG}, {"icns", IMG}, {"cur", IMG}, {"svg", IMG}, {"svgz", IMG}, {"heic", IMG},
+            {"heif", IMG}, {"avif", IMG}, {"jxl", IMG}, {"jp2", IMG}, {"j2k", IMG}, {"qoi", IMG},
+            {"raw", IMG}, {"cr2", IMG}, {"cr3", IMG}, {"crw", IMG}, {"nef", IMG}, {"nrw", IMG},
+            {"arw", IMG}, {"srf", IMG}, {"sr2", IMG}, {"dng", IMG}, {"orf", IMG}, {"rw2", IMG},
+            {"pef", IMG}, {"raf", IMG}, {"x3f", IMG}, {"psd", IMG}, {"psb", IMG}, {"xcf", IMG},
+            {"kra", IMG}, {"ora", IMG}, {"tga", IMG}, {"dds", IMG}, {"exr", IMG}, {"hdr", IMG},
+            {"pbm", IMG}, {"pgm", IMG}, {"ppm", IMG}, {"pnm", IMG}, {"pam", IMG}, {"pcx", IMG},
+            {"xpm", IMG}, {"xbm", IMG}, {"eps", IMG}, {"ai", IMG}, {"wmf", IMG}, {"emf", IMG},
+            {"cdr", IMG}, {"blend", IMG}, {"fits", IMG},
+
+            // Audio
+            {"mp3", AUD}, {"mp2", AUD}, {"flac", AUD}, {"ogg", AUD}, {"oga", AUD}, {"opus", AUD},
+            {"spx", AUD}, {"wav", AUD}, {"wave", AUD}, {"aac", AUD}, {"m4a", AUD}, {"m4b", AUD},
+            {"m4r", AUD}, {"alac", AUD}, {"aif", AUD}, {"aiff", AUD}, {"aifc", AUD}, {"wma", AUD},
+            {"ape", AUD}, {"wv", AUD}, {"mka", AUD}, {"mid", AUD}, {"midi", AUD}, {"amr", AUD},
+            {"au", AUD}, {"snd", AUD}, {"ra", AUD}, {"dsf", AUD}, {"dff", AUD}, {"caf", AUD},
+            {"mpc", AUD}, {"tta", AUD}, {"voc", AUD}, {"mod", AUD}, {"xm", AUD}, {"s3m", AUD},
+            {"it", AUD}, {"ac3", AUD}, {"dts", AUD}, {"cue", AUD},
+
+            // Video
+            {"mp4", VID}, {"m4v", VID}, {"mkv", VID}, {"mk3d", VID}, {"webm", VID}, {"avi", VID},
+            {"mov", VID}, {"qt", VID}, {"wmv", VID}, {"flv", VID}, {"f4v", VID}, {"mpg", VID},
+            {"mpeg", VID}, {"mpe", VID}, {"m2v", VID}, {"m2ts", VID}, {"mts", VID}, {"vob", VID},
+            {"ogv", VID}, {"ogm", VID}, {"3gp", VID}, {"3g2", VID}, {"asf", VID}, {"rm", VID},
+            {"rmvb", VID}, {"divx", VID}, {"mxf", VID}, {"dv", VID}, {"y4m", VID}, {"h264", VID},
+            {"h265", VID}, {"hevc", VID}, {"srt", VID}, {"ass", VID}, {"ssa", VID}, {"vtt", VID},
+
+            // Documents
+            {"pdf", DOC}, {"txt", DOC}, {"text", DOC}, {"md", DOC}, {"markdown", DOC},
+            {"rst", DOC}, {"adoc", DOC}, {"asciidoc", DOC}, {"org", DOC}, {"tex", DOC},
+            {"ltx", DOC}, {"bib", DOC}, {"rtf", DOC}, {"doc", DOC}, {"docx", DOC}, {"docm", DOC},
+            {"dot", DOC}, {"dotx", DOC}, {"odt", DOC}, {"ott", DOC}, {"fodt", DOC}, {"pages", DOC},
+            {"wpd", DOC}, {"xls", DOC}, {"xlsx", DOC}, {"xlsm", DOC}, {"ods", DOC},
+            {"numbers", DOC}, {"ppt", DOC}, {"pptx", DOC}, {"pps", DOC}, {"ppsx", DOC},
+            {"odp", DOC}, {"key", DOC}, {"odg", DOC}, {"epub", DOC}, {"mobi", DOC}, {"azw", DOC},
+            {"azw3", DOC}, {"fb2", DOC}, {"djvu", DOC}, {"ps", DOC}, {"xps", DOC}, {"oxps", DOC},
+            {"chm", DOC}, {"man", DOC}, {"nfo", DOC}, {"info", DOC}, {"me", DOC},
+
+            // Source code
+            {"c", SRC}, {"h", SRC}, {"cc", SRC}, {"cpp", SRC}, {"cxx", SRC}, {"c++", SRC},
+            {"hh", SRC}, {"hpp", SRC}, {"hxx", SRC}, {"h++", SRC}, {"ipp", SRC}, {"tpp", SRC},
+            {"inl", SRC}, {"cu", SRC}, {"cuh", SRC}, {"m", SRC}, {"mm", SRC}, {"java", SRC},
+            {"kt", SRC}, {"kts", SRC}, {"scala", SRC}, {"sc", SRC}, {"groovy", SRC},
+            {"gradle", SRC}, {"go", SRC}, {"rs", SRC}, {"swift", SRC}, {"cs", SRC}, {"csx", SRC},
+            {"fs", SRC}, {"fsi", SRC}, {"fsx", SRC}, {"vb", SRC}, {"py", SRC}, {"pyi", SRC},
+            {"pyx", SRC}, {"pxd", SRC}, {"ipynb", SRC}, {"rb", SRC}, {"erb", SRC}, {"php", SRC},
+            {"pl", SRC}, {"pm", SRC}, {"pod", SRC}, {"lua", SRC}, {"js", SRC}, {"mjs", SRC},
+            {"cjs", SRC}, {"jsx", SRC}, {"ts", SRC}, {"tsx", SRC}, {"cts", SRC}, {"vue", SRC},
+            {"svelte", SRC}, {"dart", SRC}, {"elm", SRC}, {"ex", SRC}, {"exs", SRC}, {"erl", SRC},
+            {"hrl", SRC}, {"hs", SRC}, {"lhs", SRC}, {"ml", SRC}, {"mli", SRC}, {"clj", SRC},
+            {"cljs", SRC}, {"cljc", SRC}, {"lisp", SRC}, {"lsp", SRC}, {"el", SRC}, {"scm", SRC},
+            {"ss", SRC}, {"rkt", SRC}, {"jl", SRC}, {"r", SRC}, {"nim", SRC}, {"zig", SRC},
+            {"v", SRC}, {"sv", SRC}, {"svh", SRC}, {"vhdl", SRC}, {"asm", SRC}, {"s", SRC},
+            {"f", SRC}, {"f77", SRC}, {"f90", SRC}, {"f95", SRC}, {"f03", SRC}, {"for", SRC},
+            {"ada", SRC}, {"adb", SRC}, {"ads", SRC}, {"pas", SRC}, {"pp", SRC}, {"d", SRC},
+            {"cr", SRC}, {"sol", SRC}, {"hx", SRC}, {"gd", SRC}, {"glsl", SRC}, {"hlsl", SRC},
+            {"vert", SRC}, {"frag", SRC}, {"wgsl", SRC}, {"html", SRC}, {"htm", SRC},
+            {"xhtml", SRC}, {"css", SRC}, {"scss", SRC}, {"sass", SRC}, {"less", SRC},
+            {"cmake", SRC}, {"mk", SRC}, {"mak", SRC}, {"ninja", SRC}, {"bzl", SRC},
+            {"bazel", SRC}, {"proto", SRC}, {"thrift", SRC}, {"y", SRC}, {"yy", SRC}, {"l", SRC},
+            {"ll", SRC}, {"patch", SRC}, {"diff", SRC},
+
+            // Scripts
+            {"sh", SCR}, {"bash", SCR}, {"zsh", SCR}, {"fish", SCR}, {"ksh", SCR}, {"csh", SCR},
+            {"tcsh", SCR}, {"ps1", SCR}, {"psm1", SCR}, {"bat", SCR}, {"cmd", SCR}, {"awk", SCR},
+            {"sed", SCR}, {"tcl", SCR}, {"vim", SCR}, {"nu", SCR}, {"command", SCR},
+
+            // Data and configuration
+            {"json", DAT}, {"jsonc", DAT}, {"json5", DAT}, {"jsonl", DAT}, {"ndjson", DAT},
+            {"yaml", DAT}, {"yml", DAT}, {"toml", DAT}, {"ini", DAT}, {"cfg", DAT}, {"conf", DAT},
+            {"config", DAT}, {"env", DAT}, {"xml", DAT}, {"xsd", DAT}, {"xsl", DAT}, {"xslt", DAT},
+            {"plist", DAT}, {"csv", DAT}, {"tsv", DAT}, {"sql", DAT}, {"db", DAT}, {"sqlite", DAT},
+            {"sqlite3", DAT}, {"mdb", DAT}, {"graphql", DAT}, {"gql", DAT}, {"lock", DAT},
+            {"log", DAT}, {"parquet", DAT}, {"avro", DAT}, {"arrow", DAT}, {"feather", DAT},
+            {"orc", DAT}, {"h5", DAT}, {"hdf5", DAT}, {"nc", DAT}, {"npy", DAT}, {"npz", DAT},
+            {"pkl", DAT}, {"pickle", DAT}, {"mat", DAT}, {"rds", DAT}, {"rdata", DAT},
+            {"dat", DAT}, {"geojson", DAT}, {"kml", DAT}, {"gpx", DAT}, {"ics", DAT},
+            {"vcf", DAT}, {"pem", DAT}, {"crt", DAT}, {"cer", DAT}, {"csr", DAT}, {"der", DAT},
+            {"p12", DAT}, {"pfx", DAT}, {"pub", DAT}, {"gpg", DAT}, {"asc", DAT}, {"sig", DAT},
+            {"torrent", DAT}, {"desktop", DAT}, {"service", DAT}, {"rules", DAT},
+
+            // Fonts
+            {"ttf", FNT}, {"otf", FNT}, {"ttc", FNT}, {"woff", FNT}, {"woff2", FNT},
+            {"eot", FNT}, {"pfb", FNT}, {"pfm", FNT}, {"afm", FNT}, {"fon", FNT}, {"fnt", FNT},
+            {"bdf", FNT}, {"pcf", FNT},
+
+            // Compiled binaries and objects
+            {"o", BIN}, {"obj", BIN}, {"a", BIN}, {"so", BIN}, {"ko", BIN}, {"dylib", BIN},
+            {"dll", BIN}, {"exe", BIN}, {"msi", BIN}, {"lib", BIN}, {"pdb", BIN}, {"elf", BIN},
+            {"bin", BIN}, {"out", BIN}, {"class", BIN}, {"pyc", BIN}, {"pyo", BIN}, {"wasm", BIN},
+            {"dex", BIN}, {"efi", BIN}, {"sys", BIN}, {"gch", BIN}, {"pch", BIN}, {"rlib", BIN},
+            {"beam", BIN}, {"elc", BIN}, {"hi", BIN}, {"cmo", BIN}, {"cmx", BIN}, {"swp", BIN},
+        };
+
+        constexpr std::size_t EXTENSION_COUNT = std::size(EXTENSIONS);
+        constexpr std::size_t MAX_LENGTH = 8;
+        constexpr unsigned SLOT_BITS = 11;
+        constexpr std::size_t SLOTS = std::size_t(1) << SLOT_BITS;
+        constexpr std::size_t BUCKETS = 256;
+
+        /**
+         * @brief Packs a lowercase extension of up to 8 bytes into one integer. Never 0.
+         */
+        constexpr std::uint64_t packKey(std::string_view extension) noexcept
+        {
+            std::uint64_t key = 0;
+
+            for (std::size_t i = 0; i < extension.size(); ++i)
+                key |= std::uint64_t(static_cast<unsigned char>(extension[i])) << (8 * i);
+            return key;
+        }
+
+        constexpr std::uint64_t mix(std::uint64_t x) noexcept
+        {
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdull;
+            x ^= x >> 33;
+            x *= 0xc4ceb9fe1a85ec53ull;
+            x ^= x >> 33;
+            return x;
+        }
+
+        constexpr std::size_t bucketOf(std::uint64_t key) noexcept
+        {
+            return mix(key) & (BUCKETS - 1);
+        }
+
+        constexpr std::size_t slotOf(std::uint64_t key, std::uint16_t displacement) noexcept
+        {
+            return mix(key ^ (std::uint64_t(displacement) * 0x9e3779b97f4a7c15ull)) >> (64 - SLOT_BITS);
+        }
+
+        /**
+         * @struct ExtensionTable
+         * @brief A perfect hash of EXTENSIONS, built by hash-and-displace: keys are split into
+         * buckets, and each bucket gets the first displacement that sends all its keys to free
+         * slots. A lookup is two hashes and one compare, with no probing.
+         */
+        struct ExtensionTable {
+            std::array<std::uint64_t, SLOTS> keys {};
+            std::array<FileClass, SLOTS> classes {};
+            std::array<std::uint16_t, BUCKETS> displacements {};
+            bool valid = false;
+        };
+
+        constexpr ExtensionTable buildTable()
+        {
+            ExtensionTable table;
+            std::array<std::uint64_t, EXTENSION_COUNT> keys {};
+            std::array<std::size_t, BUCKETS> sizes {};
+            std::array<std::size_t, BUCKETS> order {};
+
+            for (std::size_t i = 0; i < EXTENSION_COUNT; ++i) {
+                if (EXTENSIONS[i].name.empty() || EXTENSIONS[i].name.size() > MAX_LENGTH)
+                    return table;
+                keys[i] = packKey(EXTENSIONS[i].name);
+                for (std::size_t j = 0; j < i; ++j)
+                    if (keys[j] == keys[i])
+                        return table; // duplicate extension
+                ++sizes[bucketOf(keys[i])];
+            }
+
+            // Largest buckets first: they are the hardest to place
+            for (std::size_t b = 0; b < BUCKETS; ++b)
+                order[b] = b;
+            for (std::size_t i = 1; i < BUCKETS; ++i)
+                for (std::size_t j = i; j > 0 && sizes[order[j]] > sizes[order[j - 1]]; --j) {
+                    std::size_t tmp = order[j];
+                    order[j] = order[j - 1];
+                    order[j - 1] = tmp;
+                }
+
+            for (std::size_t bucket : order) {
+                if (sizes[bucket] == 0)
+                    break;
+                bool placed = false;
+                for (std::uint32_t d = 0; d < 65536 && !placed; ++d) {
+                    auto displacement = static_cast<std::uint16_t>(d);
+                    std::array<std::size_t, EXTENSION_COUNT> taken {};
+                    std::size_t count = 0;
+                    placed = true;
+                    for (std::size_t i = 0; i < EXTENSION_COUNT && placed; ++i) {
+                        if (bucketOf(keys[i]) != bucket)
+                            continue;
+                        std::size_t slot = slotOf(keys[i], displacement);
+                        if (table.keys[slot] != 0)
+                            placed = false;
+                        for (std::size_t k = 0; k < count && placed; ++k)
+                            if (taken[k] == slot)
+                                placed = false;
+                        taken[count++] = slot;
+                    }
+                    if (!placed)
+                        continue;
+                    table.displacements[bucket] = displacement;
+                    for (std::size_t i = 0; i < EXTENSION_COUNT; ++i) {
+                        if (bucketOf(keys[i]) != bucket)
+                            continue;
+                        std::size_t slot = slotOf(keys[i], displacement);
+                        table.keys[slot] = keys[i];
+                        table.classes[slot] = EXTENSIONS[i].fileClass;
+                    }
+                }
+                if (!placed)
+                    return table;
+            }
+            table.valid = true;
+            return table;
+        }
+
+        constexpr ExtensionTable TABLE = buildTable();
+        static_assert(TABLE.valid, "extension list has a duplicate, an entry over 8 bytes, or no perfect hash");
+
+        constexpr FileClass lookup(std::uint64_t key) noexcept
+        {
+            std::size_t slot = slotOf(key, TABLE.displacements[bucketOf(key)]);
+            return TABLE.keys[slot] == key ? TABLE.classes[slot] : FileClass::NONE;
+        }
+
+        constexpr bool everyExtensionFound() noexcept
+        {
+            for (const Extension& extension : EXTENSIONS)
+                if (lookup(packKey(extension.name)) != extension.fileClass)
+                    return false;
+            return true;
+        }
+        static_assert(everyExtensionFound());
+
+    } // namespace
+
+    /**
+     * @brief The extension of a name, without the dot. Hidden files like ".bashrc" have none.
+     */
+    std::string_view extensionOf(std::string_view name) noexcept
+    {
+        std::size_t dot = name.rfind('.');
+
+        if (dot == std::string_view::npos || dot == 0)
+            return {};
+        return name.substr(dot + 1);
+    }
+
+    /**
+     * @brief Classifies an extension, ignoring ASCII case, with one perfect-hash lookup.
+     */
+    FileClass classifyExtension(std::string_view extension) noexcept
+    {
+        if (extension.empty() || extension.size() > MAX_LENGTH)
+            return FileClass::NONE;
+
+        std::uint64_t key = 0;
+        for (std::size_t i = 0; i < extension.size(); ++i) {
+            unsigned char c = static_cast<unsigned char>(extension[i]);
+            if (c >= 'A' && c <= 'Z')
+                c = static_cast<unsigned char>(c + ('a' - 'A'));
+            key |= std::uint64_t(c) << (8 * i);
+        }
+        return lookup(key);
+    }
+
+    /**
+     * @brief Classifies a file from its extension.
+     */
+    FileClass classifyName(std::string_view name) noexcept
+    {
+        return classifyExtension(extensionOf(name));
+    }
+
+} // namespace core
@@ -0,0 +1,57 @@
+/**
+ * @file FileIdentity.cpp
+ * @brief Implementation of the core::FileIdentity structure
+ * @date 2025-07-01
+ */
+
+#include "core/FileIdentity.hpp"
+
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace core {
+
+    namespace {
+
+        /**
+         * @brief Closes a descriptor when the walk leaves, whether it reaches the top or not.
+         */
+        struct FdGuard {
+            int fd = -1;
+            ~FdGuard() { if (fd >= 0) ::close(fd); }
+        };
+
+    } // namespace
+
+    FileIdentity FileIdentity::of(const struct stat& st) noexcept
+    {
+        return FileIdentity { static_cast<std::uint64_t>(st.st_dev), static_cast<std::uint64_t>(st.st_ino) };
+    }
+
+    /**
+     * @brief Whether a directory is this one or lies under it. Its ancestors are walked through
+     * "..", and compared by identity, so that neither links, nor "..", nor a bind mount of the
+     * directory under itself can hide it the way they hide it from the path.
+     * @return False as well if the directory does not exist.
+     */
+    bool FileIdentity::encloses(const std::string& path) const noexcept
+    {
+        struct stat st;
+        struct stat parentSt;
+
+        FdGuard dir{::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+        if (dir.fd < 0 || ::fstat(dir.fd, &st) != 0)
+            return false;
+        while (of(st) != *this) {
+            FdGuard parent{::openat(dir.fd, "..", O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+            // The root directory is its own parent
+            if (parent.fd < 0 || ::fstat(parent.fd, &parentSt) != 0 || of(parentSt) == of(st))
+                return false;
+            std::swap(dir.fd, parent.fd);
+            st = parentSt;
+        }
+        return true;
+    }
+
+} // namespace core
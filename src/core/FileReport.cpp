@@ -0,0 +1,190 @@
+/**
+ * @file FileReport.cpp
+ * @brief Implementation of the core::FileReport class
+ * @date 2025-06-28
+ */
+
+#include "core/FileReport.hpp"
+#include "core/DirectoryScanner.hpp"
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace core {
+
+    namespace {
+
+        constexpr std::size_t SCAN_BUFFER = 32 * 1024;
+
+        // Puts the weakest candidate on top of the heap
+        template <typename Candidate>
+        bool stronger(const Candidate& a, const Candidate& b) noexcept
+        {
+            return a.key > b.key;
+        }
+
+        std::int64_t monotonicNow() noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+    } // namespace
+
+    /**
+     * @brief Starts the walk right away.
+     * @param root The directory to walk; paths are reported relative to it.
+     * @param ranking What files are ranked by.
+     * @param limit How many files to keep.
+     * @param since For a RECENT report, files modified at or before this time are left out.
+     * @param notifier Optional notifier, signalled as files are seen and when the report is finished.
+     * @param pool The pool the walk runs on.
+     */
+    FileReport::FileReport(const std::string& root, Ranking ranking, std::size_t limit, std::time_t since,
+                           EventNotifier* notifier, ThreadPool& pool)
+        : _root(root), _rootFd(-1), _ranking(ranking), _limit(limit),
+          _since(static_cast<std::int64_t>(since) * 1'000'000'000), _notifier(notifier), _pool(pool), _pending(0),
+          _cancelled(false), _finished(false), _filesSeen(0), _lastNotify(0)
+    {
+        _rootFd = ::open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (_rootFd < 0 || _limit == 0) {
+            _finished = true;
+            return;
+        }
+        submit([this] { walk(""); });
+    }
+
+    FileReport::~FileReport()
+    {
+        _cancelled = true;
+        wait();
+        if (_rootFd >= 0)
+            ::close(_rootFd);
+    }
+
+    /**
+     * @brief Blocks until the report is finished or, once cancelled, stopped.
+     */
+    void FileReport::wait()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this] { return _pending == 0; });
+    }
+
+    void FileReport::submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_pending;
+        }
+        _pool.submit(std::move(task));
+    }
+
+    /**
+     * @brief Ends a task. The last one merges the heaps and marks the report finished.
+     */
+    void FileReport::done()
+    {
+        EventNotifier* notifier = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_pending == 0) {
+                merge();
+                _finished.store(true, std::memory_order_release);
+                notifier = _notifier;
+                // The destructor may run as soon as the lock is released: no member is used past it
+                _idle.notify_all();
+            }
+        }
+        if (notifier)
+            notifier->notify();
+    }
+
+    /**
+     * @brief The heap of the calling worker. Only that worker touches it until the merge.
+     */
+    std::vector<FileReport::Candidate>& FileReport::heapOfThisThread()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _heaps[std::this_thread::get_id()];
+    }
+
+    /**
+     * @brief Lists one directory, ranks its regular files and queues its subdirectories.
+     */
+    void FileReport::walk(const std::string& relative)
+    {
+        int fd = -1;
+        if (!_cancelled.load(std::memory_order_relaxed))
+            fd = ::openat(_rootFd, relative.empty() ? "." : relative.c_str(),
+                          O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        if (fd >= 0) {
+            std::vector<Candidate>& heap = heapOfThisThread();
+            DirectoryScanner scanner(fd, SCAN_BUFFER);
+            std::string prefix = relative.empty() ? relative : relative + "/";
+            struct stat st;
+            std::size_t seen = 0;
+
+            scanner.scan([&](std::string_view name, EntryType type) {
+                if (type == EntryType::DIRECTORY) {
+                    submit([this, path = prefix + std::string(name)] { walk(path); });
+                    return !_cancelled.load(std::memory_order_relaxed);
+                }
+                if (type != EntryType::REGULAR || ::fstatat(fd, name.data(), &st, AT_SYMLINK_NOFOLLOW) != 0)
+                    return !_cancelled.load(std::memory_order_relaxed);
+
+                ++seen;
+                std::int64_t key = static_cast<std::int64_t>(st.st_size);
+                if (_ranking == Ranking::RECENT) {
+                    key = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec;
+                    if (key <= _since)
+                        return !_cancelled.load(std::memory_order_relaxed);
+                }
+                if (heap.size() == _limit) {
+                    if (key <= heap.front().key)
+                        return !_cancelled.load(std::memory_order_relaxed);
+                    std::pop_heap(heap.begin(), heap.end(), stronger<Candidate>);
+                    heap.pop_back();
+                }
+                heap.push_back(Candidate { key, RankedFile { prefix + std::string(name),
+                                                             static_cast<std::uint64_t>(st.st_size),
+                                                             static_cast<std::time_t>(st.st_mtim.tv_sec) } });
+                std::push_heap(heap.begin(), heap.end(), stronger<Candidate>);
+                return !_cancelled.load(std::memory_order_relaxed);
+            });
+            ::close(fd);
+
+            _filesSeen.fetch_add(seen, std::memory_order_relaxed);
+            std::int64_t now = monotonicNow();
+            std::int64_t last = _lastNotify.load(std::memory_order_relaxed);
+            if (_notifier && now - last >= std::chrono::nanoseconds(NOTIFY_INTERVAL).count()
+                && _lastNotify.compare_exchange_strong(last, now, std::memory_order_relaxed))
+                _notifier->notify();
+        }
+        done();
+    }
+
+    /**
+     * @brief Gathers the heaps of every worker into the results, strongest first.
+     * Runs under the lock, once no task is left.
+     */
+    void FileReport::merge()
+    {
+        std::vector<Candidate> all;
+
+        for (auto& [thread, heap] : _heaps)
+            std::move(heap.begin(), heap.end(), std::back_inserter(all));
+        _heaps.clear();
+
+        std::size_t kept = std::min(all.size(), _limit);
+        std::partial_sort(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(kept), all.end(), stronger<Candidate>);
+        _results.clear();
+        _results.reserve(kept);
+        for (std::size_t i = 0; i < kept; ++i)
+            _results.push_back(std::move(all[i].file));
+    }
+
+} // namespace core
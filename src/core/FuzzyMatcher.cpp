@@ -0,0 +1,247 @@
+/**
+ * @file FuzzyMatcher.cpp
+ * @brief Implementation of the core::FuzzyMatcher class
+ * @date 2025-06-22
+ */
+
+#include "core/FuzzyMatcher.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace core {
+
+    namespace {
+
+        // fzf's weights
+        constexpr int SCORE_MATCH = 16;
+        constexpr int SCORE_GAP_START = -3;
+        constexpr int SCORE_GAP_EXTENSION = -1;
+        constexpr int BONUS_BOUNDARY = SCORE_MATCH / 2;
+        constexpr int BONUS_BOUNDARY_DELIMITER = BONUS_BOUNDARY + 1;
+        constexpr int BONUS_NON_WORD = SCORE_MATCH / 2;
+        constexpr int BONUS_CAMEL = BONUS_BOUNDARY + SCORE_GAP_EXTENSION;
+        constexpr int BONUS_CONSECUTIVE = -(SCORE_GAP_START + SCORE_GAP_EXTENSION);
+        constexpr int BONUS_FIRST_CHAR_MULTIPLIER = 2;
+        constexpr int BONUS_FILE_NAME = BONUS_BOUNDARY;
+
+        enum class CharClass { DELIMITER, NON_WORD, LOWER, UPPER, DIGIT };
+
+        CharClass classOf(char c) noexcept
+        {
+            if (c >= 'a' && c <= 'z')
+                return CharClass::LOWER;
+            if (c >= 'A' && c <= 'Z')
+                return CharClass::UPPER;
+            if (c >= '0' && c <= '9')
+                return CharClass::DIGIT;
+            if (c == '/')
+                return CharClass::DELIMITER;
+            // Other bytes of a UTF-8 sequence count as letters
+            if (static_cast<unsigned char>(c) >= 0x80)
+                return CharClass::LOWER;
+            return CharClass::NON_WORD;
+        }
+
+        int bonusFor(CharClass previous, CharClass current) noexcept
+        {
+            if (current == CharClass::DELIMITER || current == CharClass::NON_WORD)
+                return BONUS_NON_WORD;
+            if (previous == CharClass::DELIMITER)
+                return BONUS_BOUNDARY_DELIMITER;
+            if (previous == CharClass::NON_WORD)
+                return BONUS_BOUNDARY;
+            if ((previous == CharClass::LOWER && current == CharClass::UPPER)
+                || (previous != CharClass::DIGIT && current == CharClass::DIGIT))
+                return BONUS_CAMEL;
+            return 0;
+        }
+
+        char fold(char c) noexcept
+        {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+        }
+
+    } // namespace
+
+    FuzzyMatcher::FuzzyMatcher(std::string_view pattern)
+        : _pattern(pattern), _caseSensitive(false), _mask(PathIndex::charMask(pattern))
+    {
+        _caseSensitive = std::any_of(pattern.begin(), pattern.end(), [](char c) { return c >= 'A' && c <= 'Z'; });
+        for (char c : pattern)
+            _needle.push_back(_caseSensitive ? c : fold(c));
+    }
+
+    /**
+     * @brief The first position at or after from where c occurs, also as an uppercase letter
+     * when the pattern ignores case.
+     * @return The position, or length if there is none.
+     */
+    std::size_t FuzzyMatcher::find(const char* text, std::size_t from, std::size_t length, std::size_t readable,
+                                   char c) const noexcept
+    {
+        char other = (!_caseSensitive && c >= 'a' && c <= 'z') ? static_cast<char>(c - ('a' - 'A')) : c;
+
+    #if defined(__SSE2__)
+        const __m128i lower = _mm_set1_epi8(c);
+        const __m128i upper = _mm_set1_epi8(other);
+        for (; from < length && from + 16 <= readable; from += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + from));
+            auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, lower),
+                                                                             _mm_cmpeq_epi8(block, upper))));
+            if (mask != 0) {
+                std::size_t at = from + static_cast<std::size_t>(std::countr_zero(mask));
+                return std::min(at, length);
+            }
+        }
+    #endif
+        for (; from < length; ++from)
+            if (text[from] == c || text[from] == other)
+                return from;
+        return length;
+    }
+
+    /**
+     * @brief Scores one text against the pattern.
+     *
+     * A forward pass finds where the earliest match ends, a backward pass from there finds the
+     * latest start, and only that shortest window is scored.
+     * @param readable How many bytes may be loaded from text, at least length.
+     * @param nameStart Where the last path component starts.
+     * @return The score, or nothing if the text does not match.
+     */
+    std::optional<int> FuzzyMatcher::score(const char* text, std::size_t length, std::size_t readable,
+                                           std::size_t nameStart) const noexcept
+    {
+        if (_needle.empty())
+            return 0;
+
+        std::size_t end = 0;
+        for (char c : _needle) {
+            std::size_t at = find(text, end, length, readable, c);
+            if (at >= length)
+                return std::nullopt;
+            end = at + 1;
+        }
+
+        std::size_t start = end;
+        for (std::size_t p = _needle.size(); p > 0; --start)
+            if ((_caseSensitive ? text[start - 1] : fold(text[start - 1])) == _needle[p - 1])
+                --p;
+
+        int total = 0;
+        int firstBonus = 0;
+        std::size_t consecutive = 0;
+        bool inGap = false;
+        CharClass previous = start > 0 ? classOf(text[start - 1]) : CharClass::DELIMITER;
+        for (std::size_t i = start, p = 0; i < end; ++i) {
+            char c = _caseSensitive ? text[i] : fold(text[i]);
+            CharClass current = classOf(text[i]);
+            if (c == _needle[p]) {
+                int bonus = bonusFor(previous, current);
+                if (consecutive == 0) {
+                    firstBonus = bonus;
+                } else {
+                    // A run keeps the bonus of its first character, unless a better boundary comes up
+                    if (bonus >= BONUS_BOUNDARY && bonus > firstBonus)
+                        firstBonus = bonus;
+                    bonus = std::max({ bonus, firstBonus, BONUS_CONSECUTIVE });
+                }
+                total += SCORE_MATCH + (p == 0 ? bonus * BONUS_FIRST_CHAR_MULTIPLIER : bonus);
+                inGap = false;
+                ++consecutive;
+                ++p;
+            } else {
+                total += inGap ? SCORE_GAP_EXTENSION : SCORE_GAP_START;
+                inGap = true;
+                consecutive = 0;
+                firstBonus = 0;
+            }
+            previous = current;
+        }
+        if (start >= nameStart)
+            total += BONUS_FILE_NAME;
+        return total;
+    }
+
+    /**
+     * @brief Higher score first, then shorter path, then the order paths were found in.
+     */
+    bool FuzzyMatcher::better(const FuzzyMatch& a, const FuzzyMatch& b) noexcept
+    {
+        if (a.score != b.score)
+            return a.score > b.score;
+        if (a.length != b.length)
+            return a.length < b.length;
+        if (a.chunk != b.chunk)
+            return a.chunk < b.chunk;
+        return a.index < b.index;
+    }
+
+    /**
+     * @brief Scores the chunks from firstChunk on and merges the best of them into results,
+     * which keeps at most limit matches, best first.
+     * Chunks are scored in parallel, each into its own bounded heap.
+     */
+    void FuzzyMatcher::search(const PathIndex::Snapshot& chunks, std::size_t firstChunk, std::size_t limit,
+                              std::vector<FuzzyMatch>& results, ThreadPool& pool) const
+    {
+        if (firstChunk >= chunks.size() || limit == 0)
+            return;
+
+        std::vector<std::vector<FuzzyMatch>> found(chunks.size() - firstChunk);
+        pool.parallelFor(found.size(), [&](std::size_t c) {
+            const PathChunk& chunk = *chunks[firstChunk + c];
+            std::vector<FuzzyMatch>& top = found[c];
+            // A heap whose front is the worst match kept so far
+            auto worse = [](const FuzzyMatch& a, const FuzzyMatch& b) { return better(a, b); };
+
+            auto consider = [&](std::size_t j) {
+                std::size_t offset = chunk.offsets[j];
+                auto matched = score(chunk.bytes + offset, chunk.lengths[j], chunk.byteCount - offset,
+                                     chunk.nameStarts[j]);
+                if (!matched)
+                    return;
+                FuzzyMatch match { *matched, chunk.lengths[j], static_cast<std::uint32_t>(firstChunk + c),
+                                   static_cast<std::uint32_t>(j) };
+                if (top.size() < limit) {
+                    top.push_back(match);
+                    std::push_heap(top.begin(), top.end(), worse);
+                } else if (better(match, top.front())) {
+                    std::pop_heap(top.begin(), top.end(), worse);
+                    top.back() = match;
+                    std::push_heap(top.begin(), top.end(), worse);
+                }
+            };
+
+            std::size_t count = chunk.size();
+            const std::uint64_t* masks = chunk.masks;
+            std::size_t j = 0;
+        #if defined(__SSE2__)
+            const __m128i need = _mm_set1_epi64x(static_cast<long long>(_mask));
+            for (; j + 2 <= count; j += 2) {
+                __m128i present = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(masks + j)), need);
+                auto equal = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(present, need)));
+                if ((equal & 0x00FF) == 0x00FF)
+                    consider(j);
+                if ((equal & 0xFF00) == 0xFF00)
+                    consider(j + 1);
+            }
+        #endif
+            for (; j < count; ++j)
+                if ((masks[j] & _mask) == _mask)
+                    consider(j);
+        });
+
+        for (const auto& top : found)
+            results.insert(results.end(), top.begin(), top.end());
+        std::size_t kept = std::min(limit, results.size());
+        std::partial_sort(results.begin(), results.begin() + static_cast<std::ptrdiff_t>(kept), results.end(), better);
+        results.resize(kept);
+    }
+
+} // namespace core
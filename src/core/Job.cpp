@@ -0,0 +1,208 @@
+/**
+ * @file Job.cpp
+ * @brief Implementation of the core::Job class
+ * @date 2025-06-29
+ */
+
+#include "core/Job.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace core {
+
+    namespace {
+
+        std::int64_t monotonicNow() noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+    } // namespace
+
+    /**
+     * @brief How much of the job is done, from 0 to 1, or 0 while the totals are unknown.
+     */
+    double JobProgress::fraction() const noexcept
+    {
+        if (bytesTotal > 0)
+            return std::min(1.0, static_cast<double>(bytesDone) / static_cast<double>(bytesTotal));
+        if (filesTotal > 0)
+            return std::min(1.0, static_cast<double>(filesDone) / static_cast<double>(filesTotal));
+        return 0.0;
+    }
+
+    /**
+     * @brief Bytes per second so far, or 0 before anything is done.
+     */
+    double JobProgress::throughput() const noexcept
+    {
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        return seconds > 0 ? static_cast<double>(bytesDone) / seconds : 0.0;
+    }
+
+    /**
+     * @brief The time left at the pace so far, or 0 if it cannot be told yet.
+     */
+    std::chrono::seconds JobProgress::remaining() const noexcept
+    {
+        double done = fraction();
+        if (done <= 0 || done >= 1)
+            return std::chrono::seconds(0);
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        return std::chrono::seconds(static_cast<std::int64_t>(seconds * (1 - done) / done));
+    }
+
+    Job::Job(std::string description)
+        : _description(std::move(description)), _notifier(nullptr), _activeBefore(0), _state(State::QUEUED),
+          _paused(false), _cancelled(false), _bytesDone(0), _bytesTotal(0), _filesDone(0), _filesTotal(0),
+          _lastNotify(0)
+    {}
+
+    JobProgress Job::progress() const
+    {
+        JobProgress progress;
+
+        progress.bytesDone = _bytesDone.load(std::memory_order_relaxed);
+        progress.bytesTotal = _bytesTotal.load(std::memory_order_relaxed);
+        progress.filesDone = _filesDone.load(std::memory_order_relaxed);
+        progress.filesTotal = _filesTotal.load(std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        progress.elapsed = _activeBefore;
+        if (state() == State::RUNNING && !paused())
+            progress.elapsed += std::chrono::steady_clock::now() - _activeSince;
+        return progress;
+    }
+
+    std::string Job::error() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _error;
+    }
+
+    /**
+     * @brief Holds the job at its next checkpoint. The clock stops until it resumes.
+     */
+    void Job::pause()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_paused)
+                return;
+            _paused = true;
+            if (state() == State::RUNNING)
+                _activeBefore += std::chrono::steady_clock::now() - _activeSince;
+        }
+        notify(true);
+    }
+
+    void Job::resume()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_paused)
+                return;
+            _paused = false;
+            _activeSince = std::chrono::steady_clock::now();
+        }
+        _resumed.notify_all();
+        notify(true);
+    }
+
+    /**
+     * @brief Stops the job at its next checkpoint, or before it starts if it is still queued.
+     */
+    void Job::cancel()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cancelled = true;
+        }
+        _resumed.notify_all();
+        notify(true);
+    }
+
+    /**
+     * @brief Runs the job on the calling thread and settles its final state.
+     * @param notifier Optional notifier, signalled as the job progresses and when it ends.
+     */
+    void Job::execute(EventNotifier* notifier)
+    {
+        _notifier.store(notifier, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _activeSince = std::chrono::steady_clock::now();
+        }
+        _state.store(State::RUNNING, std::memory_order_release);
+        notify(true);
+
+        State outcome = State::DONE;
+        try {
+            if (!cancelled())
+                run();
+        } catch (const std::exception& e) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _error = e.what();
+            outcome = State::FAILED;
+        }
+        if (outcome == State::DONE && cancelled())
+            outcome = State::CANCELLED;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_paused)
+                _activeBefore += std::chrono::steady_clock::now() - _activeSince;
+        }
+        _state.store(outcome, std::memory_order_release);
+        notify(true);
+    }
+
+    void Job::setTotals(std::uint64_t bytes, std::uint64_t files) noexcept
+    {
+        _bytesTotal.store(bytes, std::memory_order_relaxed);
+        _filesTotal.store(files, std::memory_order_relaxed);
+        notify(true);
+    }
+
+    /**
+     * @brief Counts work done. May be called from any thread the job spreads its work on.
+     */
+    void Job::advance(std::uint64_t bytes, std::uint64_t files) noexcept
+    {
+        _bytesDone.fetch_add(bytes, std::memory_order_relaxed);
+        _filesDone.fetch_add(files, std::memory_order_relaxed);
+        notify(false);
+    }
+
+    /**
+     * @brief Waits while the job is paused.
+     * @return False once the job is cancelled: the work should stop.
+     */
+    bool Job::checkpoint()
+    {
+        if (paused()) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _resumed.wait(lock, [this] { return !_paused || _cancelled; });
+        }
+        return !cancelled();
+    }
+
+    /**
+     * @brief Signals the notifier, at most every NOTIFY_INTERVAL unless always is set.
+     */
+    void Job::notify(bool always) noexcept
+    {
+        EventNotifier* notifier = _notifier.load(std::memory_order_relaxed);
+        if (!notifier)
+            return;
+
+        std::int64_t now = monotonicNow();
+        std::int64_t last = _lastNotify.load(std::memory_order_relaxed);
+        if (always || (now - last >= std::chrono::nanoseconds(NOTIFY_INTERVAL).count()
+                       && _lastNotify.compare_exchange_strong(last, now, std::memory_order_relaxed)))
+            notifier->notify();
+    }
+
+} // namespace core
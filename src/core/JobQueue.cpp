@@ -0,0 +1,103 @@
+/**
+ * @file JobQueue.cpp
+ * @brief Implementation of the core::JobQueue class
+ * @date 2025-06-29
+ */
+
+#include "core/JobQueue.hpp"
+
+namespace core {
+
+    /**
+     * @param notifier Optional notifier, handed to each job as it starts.
+     */
+    JobQueue::JobQueue(EventNotifier* notifier)
+        : _notifier(notifier), _stopping(false)
+    {}
+
+    JobQueue::~JobQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+            for (auto& job : _queue)
+                job->cancel();
+            if (_running)
+                _running->cancel();
+        }
+        _ready.notify_all();
+        if (_worker.joinable())
+            _worker.join();
+    }
+
+    /**
+     * @brief Queues a job. The worker starts with the first one, so that it inherits the signal
+     * mask the application sets up when it starts.
+     */
+    void JobQueue::submit(std::shared_ptr<Job> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.push_back(std::move(job));
+            if (!_worker.joinable())
+                _worker = std::thread([this] { work(); });
+        }
+        _ready.notify_one();
+        if (_notifier)
+            _notifier->notify();
+    }
+
+    /**
+     * @brief The running job, or the first queued one if none is running yet.
+     */
+    std::shared_ptr<Job> JobQueue::current() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_running)
+            return _running;
+        return _queue.empty() ? nullptr : _queue.front();
+    }
+
+    /**
+     * @brief How many jobs wait behind the running one.
+     */
+    std::size_t JobQueue::queued() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _queue.size();
+    }
+
+    std::shared_ptr<Job> JobQueue::lastFinished() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _finished.empty() ? nullptr : _finished.back();
+    }
+
+    void JobQueue::work()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (true) {
+            _ready.wait(lock, [this] { return _stopping || !_queue.empty(); });
+            if (_stopping)
+                return;
+
+            _running = std::move(_queue.front());
+            _queue.pop_front();
+            std::shared_ptr<Job> job = _running;
+            lock.unlock();
+            job->execute(_notifier);
+            lock.lock();
+
+            _running.reset();
+            _finished.push_back(std::move(job));
+            if (_finished.size() > FINISHED_KEPT)
+                _finished.pop_front();
+            // The job signalled its end while it was still the running one
+            if (_notifier)
+                _notifier->notify();
+        }
+    }
+
+} // namespace core
@@ -0,0 +1,148 @@
+/**
+ * @file ListingCache.cpp
+ * @brief Implementation of the core::ListingCache class
+ * @date 2025-06-13
+ */
+
+#include "core/ListingCache.hpp"
+
+#include <filesystem>
+
+namespace core {
+
+    ListingCache::ListingCache(DirectoryWatcher& watcher, std::size_t byteBudget)
+        : _watcher(watcher), _byteBudget(byteBudget), _bytes(0), _hits(0), _misses(0)
+    {}
+
+    ListingCache::~ListingCache()
+    {
+        clear();
+    }
+
+    /**
+     * @brief Paths are keyed in lexical normal form, so "./src" and "src/../src" share an entry.
+     */
+    std::string ListingCache::keyOf(const std::string& path)
+    {
+        return std::filesystem::path(path).lexically_normal().string();
+    }
+
+    std::size_t ListingCache::sizeOf(const Node& node) noexcept
+    {
+        return sizeof(Node) + node.key.capacity()
+            + node.listing.entries.memoryUsage()
+            + node.listing.order.capacity() * sizeof(EntryTable::Index);
+    }
+
+    /**
+     * @brief Stores the listing of a directory being left. It becomes the most recently used one.
+     * The cache takes over the listing's watch. Older listings are evicted to stay within budget;
+     * a listing larger than the whole budget is not kept.
+     */
+    void ListingCache::store(const std::string& path, CachedListing listing)
+    {
+        std::string key = keyOf(path);
+
+        if (auto it = _index.find(key); it != _index.end())
+            erase(it->second, it->second->listing.wd == listing.wd);
+
+        _lru.push_front(Node { std::move(key), std::move(listing), 0 });
+        _lru.front().bytes = sizeOf(_lru.front());
+        _bytes += _lru.front().bytes;
+        _index.emplace(_lru.front().key, _lru.begin());
+        evictToBudget();
+    }
+
+    /**
+     * @brief Hands back the listing of a directory if it is still valid, and drops it from the cache.
+     * The caller takes over the watch. A stale listing is dropped and counted as a miss.
+     */
+    std::optional<CachedListing> ListingCache::take(const std::string& path)
+    {
+        auto found = _index.find(keyOf(path));
+
+        if (found == _index.end()) {
+            ++_misses;
+            return std::nullopt;
+        }
+
+        auto it = found->second;
+        auto stamp = DirectoryStamp::of(path);
+        if (!stamp || *stamp != it->listing.stamp || generation(it->listing.wd) != it->listing.generation) {
+            erase(it, false);
+            ++_misses;
+            return std::nullopt;
+        }
+
+        CachedListing listing = std::move(it->listing);
+        erase(it, true);
+        ++_hits;
+        return listing;
+    }
+
+    bool ListingCache::contains(const std::string& path) const
+    {
+        return _index.count(keyOf(path)) != 0;
+    }
+
+    bool ListingCache::ownsWatch(int wd) const noexcept
+    {
+        for (const auto& node : _lru)
+            if (node.listing.wd == wd)
+                return true;
+        return false;
+    }
+
+    std::uint64_t ListingCache::generation(int wd) const noexcept
+    {
+        auto it = _generations.find(wd);
+        return it == _generations.end() ? 0 : it->second;
+    }
+
+    /**
+     * @brief Records that something happened in a watched directory.
+     */
+    void ListingCache::noteEvent(int wd) noexcept
+    {
+        ++_generations[wd];
+    }
+
+    void ListingCache::clear()
+    {
+        while (!_lru.empty())
+            erase(std::prev(_lru.end()), false);
+        _generations.clear();
+    }
+
+    void ListingCache::setByteBudget(std::size_t bytes)
+    {
+        _byteBudget = bytes;
+        evictToBudget();
+    }
+
+    ListingCache::Stats ListingCache::stats() const noexcept
+    {
+        return Stats { _hits, _misses, _lru.size(), _bytes, _byteBudget };
+    }
+
+    /**
+     * @brief Removes a node; its watch goes with it unless the listing is being handed over.
+     */
+    void ListingCache::erase(std::list<Node>::iterator it, bool keepWatch)
+    {
+        if (!keepWatch && it->listing.wd >= 0) {
+            _watcher.unwatch(it->listing.wd);
+            _generations.erase(it->listing.wd);
+        }
+        _bytes -= it->bytes;
+        _index.erase(it->key);
+        _lru.erase(it);
+    }
+
+    void ListingCache::evictToBudget()
+    {
+        while (_bytes > _byteBudget && !_lru.empty())
+            erase(std::prev(_lru.end()), false);
+    }
+
+} // namespace core
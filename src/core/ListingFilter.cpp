@@ -0,0 +1,234 @@
+/**
+ * @file ListingFilter.cpp
+ * @brief Implementation of the core::ListingFilter class
+ * @date 2025-06-21
+ */
+
+#include "core/ListingFilter.hpp"
+
+#include <bit>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace core {
+
+    namespace {
+
+        unsigned char fold(char c) noexcept
+        {
+            auto u = static_cast<unsigned char>(c);
+            return (u >= 'A' && u <= 'Z') ? static_cast<unsigned char>(u + ('a' - 'A')) : u;
+        }
+
+        bool isGlob(std::string_view pattern) noexcept
+        {
+            return pattern.find_first_of("*?") != std::string_view::npos;
+        }
+
+        /**
+         * @brief The longest run of the pattern without wildcards, folded to lowercase.
+         * Every match contains it, so it is what gets searched for.
+         */
+        std::string longestLiteral(std::string_view pattern)
+        {
+            std::string_view best;
+
+            for (std::size_t start = 0; start < pattern.size();) {
+                std::size_t end = pattern.find_first_of("*?", start);
+                if (end == std::string_view::npos)
+                    end = pattern.size();
+                if (end - start > best.size())
+                    best = pattern.substr(start, end - start);
+                start = end + 1;
+            }
+
+            std::string literal;
+            for (char c : best)
+                literal.push_back(static_cast<char>(fold(c)));
+            return literal;
+        }
+
+        bool equalFolded(const char* text, const char* needle, std::size_t length) noexcept
+        {
+            for (std::size_t k = 0; k < length; ++k)
+                if (fold(text[k]) != static_cast<unsigned char>(needle[k]))
+                    return false;
+            return true;
+        }
+
+    #if defined(__SSE2__)
+        __m128i foldBlock(__m128i block) noexcept
+        {
+            __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)),
+                                          _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+            return _mm_or_si128(block, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+        }
+    #endif
+
+        /**
+         * @brief Calls onMatch with each position where a folded needle occurs in text, ignoring
+         * ASCII case, until it returns false.
+         *
+         * Sixteen candidate positions are tested at once by comparing the first and the last byte
+         * of the needle; only positions where both match are compared in full.
+         * @param readable How many bytes may be loaded from text, at least length. Loads past
+         * length are masked out, which lets short names be searched inside the name arena.
+         */
+        template <typename Fn>
+        void findFolded(const char* text, std::size_t length, std::size_t readable, std::string_view needle, Fn&& onMatch)
+        {
+            std::size_t k = needle.size();
+
+            if (k == 0 || k > length)
+                return;
+
+            std::size_t last = length - k;
+            std::size_t pos = 0;
+        #if defined(__SSE2__)
+            const __m128i first = _mm_set1_epi8(needle[0]);
+            const __m128i final = _mm_set1_epi8(needle[k - 1]);
+            for (; pos <= last && pos + k - 1 + 16 <= readable; pos += 16) {
+                __m128i head = foldBlock(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + pos)));
+                __m128i tail = foldBlock(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + pos + k - 1)));
+                auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first),
+                                                                                  _mm_cmpeq_epi8(tail, final))));
+                if (last - pos < 15)
+                    mask &= (1u << (last - pos + 1)) - 1;
+                for (; mask != 0; mask &= mask - 1) {
+                    std::size_t at = pos + static_cast<std::size_t>(std::countr_zero(mask));
+                    if ((k <= 2 || equalFolded(text + at + 1, needle.data() + 1, k - 2)) && !onMatch(at))
+                        return;
+                }
+            }
+        #endif
+            for (; pos <= last; ++pos)
+                if (fold(text[pos]) == static_cast<unsigned char>(needle[0])
+                    && equalFolded(text + pos, needle.data(), k) && !onMatch(pos))
+                    return;
+        }
+
+    } // namespace
+
+    /**
+     * @brief Appends a character to the pattern and narrows the current matches with it.
+     */
+    void ListingFilter::push(const EntryTable& table, const std::vector<EntryTable::Index>& order, char c)
+    {
+        const std::vector<EntryTable::Index>& candidates = _levels.empty() ? order : _levels.back().matches;
+
+        _pattern.push_back(c);
+        Level level { _pattern.size(), {} };
+        narrow(table, candidates, level.matches);
+        _levels.push_back(std::move(level));
+    }
+
+    /**
+     * @brief Removes the last character of the pattern and goes back to the matches it had.
+     * If they were dropped by a rebuild, they are searched for again in the whole listing.
+     */
+    void ListingFilter::pop(const EntryTable& table, const std::vector<EntryTable::Index>& order)
+    {
+        if (_pattern.empty())
+            return;
+
+        _pattern.pop_back();
+        _levels.pop_back();
+        if (_pattern.empty())
+            _levels.clear();
+        else if (_levels.empty() || _levels.back().length != _pattern.size())
+            rebuild(table, order);
+    }
+
+    /**
+     * @brief Searches the whole listing again for the current pattern, after the listing changed.
+     * The match sets of shorter patterns are dropped, since they no longer describe the listing.
+     */
+    void ListingFilter::rebuild(const EntryTable& table, const std::vector<EntryTable::Index>& order)
+    {
+        _levels.clear();
+        if (_pattern.empty())
+            return;
+
+        Level level { _pattern.size(), {} };
+        narrow(table, order, level.matches);
+        _levels.push_back(std::move(level));
+    }
+
+    void ListingFilter::clear() noexcept
+    {
+        _pattern.clear();
+        _levels.clear();
+    }
+
+    /**
+     * @brief Keeps the candidates whose name matches the pattern, in the same order.
+     */
+    void ListingFilter::narrow(const EntryTable& table, const std::vector<EntryTable::Index>& candidates,
+                               std::vector<EntryTable::Index>& out)
+    {
+        std::string literal = longestLiteral(_pattern);
+        bool glob = isGlob(_pattern);
+
+        out.clear();
+        if (!literal.empty() && candidates.size() >= table.size() / 8) {
+            // One pass over the whole arena, then a lookup per candidate
+            _hits.assign(table.size(), 0);
+            EntryTable::Index entry = 0;
+            findFolded(table.nameData(), table.nameBytes(), table.nameBytes(), literal, [&](std::size_t offset) {
+                while (entry + 1 < table.size() && table.nameOffset(entry + 1) <= offset)
+                    ++entry;
+                _hits[entry] = 1;
+                return true;
+            });
+            for (EntryTable::Index i : candidates)
+                if (_hits[i] && (!glob || matchName(table.name(i), _pattern)))
+                    out.push_back(i);
+            return;
+        }
+
+        for (EntryTable::Index i : candidates) {
+            bool found = literal.empty();
+            findFolded(table.cname(i), table.name(i).size(), table.nameBytes() - table.nameOffset(i), literal,
+                       [&](std::size_t) {
+                           found = true;
+                           return false;
+                       });
+            if (found && (!glob || matchName(table.name(i), _pattern)))
+                out.push_back(i);
+        }
+    }
+
+    /**
+     * @brief Whether a name matches a pattern anywhere, ignoring ASCII case.
+     * '*' stands for any run of characters and '?' for any one character.
+     */
+    bool ListingFilter::matchName(std::string_view name, std::string_view pattern) noexcept
+    {
+        // The pattern is matched as if wrapped in '*', backtracking to the last star on a mismatch
+        std::size_t n = 0;
+        std::size_t p = 0;
+        std::size_t starP = 0;
+        std::size_t starN = 0;
+
+        while (n < name.size()) {
+            if (p == pattern.size())
+                return true;
+            if (pattern[p] == '*') {
+                starP = ++p;
+                starN = n;
+            } else if (pattern[p] == '?' || fold(pattern[p]) == fold(name[n])) {
+                ++p;
+                ++n;
+            } else {
+                p = starP;
+                n = ++starN;
+            }
+        }
+        while (p < pattern.size() && pattern[p] == '*')
+            ++p;
+        return p == pattern.size();
+    }
+
+} // namespace core
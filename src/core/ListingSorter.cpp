@@ -0,0 +1,229 @@
+/**
+ * @file ListingSorter.cpp
+ * @brief Implementation of the core::ListingSorter class
+ * @date 2025-06-20
+ */
+
+#include "core/ListingSorter.hpp"
+#include "core/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace core {
+
+    namespace {
+
+        constexpr std::uint64_t GROUP_BIT = std::uint64_t(1) << 63;
+        constexpr std::uint64_t VALUE_MASK = GROUP_BIT - 1;
+        constexpr std::size_t MIN_CHUNK = 32 * 1024;
+
+        /**
+         * @brief Writes the natural form of a name, up to capacity bytes: ASCII letters are folded
+         * to lowercase, and each run of digits becomes '0', the number of significant digits, then
+         * those digits. Comparing natural forms bytewise compares digit runs by value.
+         * @return The number of bytes written.
+         */
+        std::size_t naturalForm(std::string_view name, unsigned char* out, std::size_t capacity) noexcept
+        {
+            std::size_t n = 0;
+
+            for (std::size_t i = 0; i < name.size() && n < capacity;) {
+                auto c = static_cast<unsigned char>(name[i]);
+                if (c < '0' || c > '9') {
+                    out[n++] = (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+                    ++i;
+                    continue;
+                }
+
+                std::size_t end = i;
+                while (end < name.size() && name[end] >= '0' && name[end] <= '9')
+                    ++end;
+                while (i + 1 < end && name[i] == '0')
+                    ++i;
+                std::size_t digits = std::min<std::size_t>(end - i, 255);
+                out[n++] = '0';
+                if (n < capacity)
+                    out[n++] = static_cast<unsigned char>(digits);
+                for (std::size_t k = i; k < i + digits && n < capacity; ++k)
+                    out[n++] = static_cast<unsigned char>(name[k]);
+                i = end;
+            }
+            return n;
+        }
+
+        std::uint64_t loadBigEndian(const unsigned char* bytes) noexcept
+        {
+            std::uint64_t value = 0;
+
+            for (int k = 0; k < 8; ++k)
+                value = (value << 8) | bytes[k];
+            return value;
+        }
+
+        /**
+         * @brief The lowercase extension of a name in the top bytes of an integer, so that
+         * extensions compare alphabetically. Only the first 8 bytes count.
+         */
+        std::uint64_t packExtension(std::string_view name) noexcept
+        {
+            std::string_view extension = extensionOf(name);
+            unsigned char bytes[8] = {};
+
+            for (std::size_t k = 0; k < extension.size() && k < sizeof(bytes); ++k) {
+                auto c = static_cast<unsigned char>(extension[k]);
+                bytes[k] = (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+            }
+            return loadBigEndian(bytes);
+        }
+
+    } // namespace
+
+    /**
+     * @brief Sorts a display order in place.
+     * Above PARALLEL_THRESHOLD entries, keys are built and sorted in chunks on the shared thread
+     * pool, and the chunks are merged pairwise, also in parallel.
+     */
+    void ListingSorter::sort(const EntryTable& table, std::vector<EntryTable::Index>& order, SortOrder sortOrder)
+    {
+        std::size_t count = order.size();
+        std::vector<Key> keys(count);
+        Less less(table, sortOrder);
+
+        ThreadPool& pool = ThreadPool::shared();
+        std::size_t chunks = 1;
+        if (count >= PARALLEL_THRESHOLD) {
+            while (chunks * 2 <= pool.size() && count / (chunks * 2) >= MIN_CHUNK)
+                chunks *= 2;
+        }
+
+        std::vector<std::size_t> bounds(chunks + 1);
+        for (std::size_t c = 0; c <= chunks; ++c)
+            bounds[c] = count * c / chunks;
+
+        pool.parallelFor(chunks, [&](std::size_t c) {
+            for (std::size_t j = bounds[c]; j < bounds[c + 1]; ++j)
+                keys[j] = makeKey(table, order[j], sortOrder);
+            std::sort(keys.begin() + bounds[c], keys.begin() + bounds[c + 1], less);
+        });
+
+        // Chunks come in a power of two, so they always pair up
+        std::vector<Key> merged(chunks > 1 ? count : 0);
+        for (std::size_t width = 1; width < chunks; width *= 2) {
+            pool.parallelFor(chunks / (width * 2), [&](std::size_t pair) {
+                std::size_t lo = bounds[pair * width * 2];
+                std::size_t mid = bounds[pair * width * 2 + width];
+                std::size_t hi = bounds[pair * width * 2 + width * 2];
+                std::merge(keys.begin() + lo, keys.begin() + mid, keys.begin() + mid, keys.begin() + hi,
+                           merged.begin() + lo, less);
+            });
+            keys.swap(merged);
+        }
+
+        for (std::size_t j = 0; j < count; ++j)
+            order[j] = keys[j].index;
+    }
+
+    /**
+     * @brief Where an entry goes in an order that is already sorted, found by binary search.
+     * Keys are built on the fly, so this costs O(log n) key builds and no allocation.
+     */
+    std::size_t ListingSorter::position(const EntryTable& table, const std::vector<EntryTable::Index>& order,
+                                        EntryTable::Index i, SortOrder sortOrder)
+    {
+        Key key = makeKey(table, i, sortOrder);
+        Less less(table, sortOrder);
+
+        auto it = std::partition_point(order.begin(), order.end(), [&](EntryTable::Index j) {
+            return less(makeKey(table, j, sortOrder), key);
+        });
+        return static_cast<std::size_t>(it - order.begin());
+    }
+
+    /**
+     * @brief Whether an entry can move when its metadata changes.
+     */
+    bool ListingSorter::dependsOnStat(SortOrder sortOrder) noexcept
+    {
+        return sortOrder.key == SortKey::SIZE || sortOrder.key == SortKey::MTIME;
+    }
+
+    /**
+     * @brief Packs the primary criterion of an entry below a group bit, which puts directories
+     * first when asked to, and the natural form of its name in two integers.
+     */
+    ListingSorter::Key ListingSorter::makeKey(const EntryTable& table, EntryTable::Index i, SortOrder sortOrder) noexcept
+    {
+        Key key { 0, { 0, 0 }, i };
+
+        if (sortOrder.directoriesFirst && !(table.attributes(i) & EntryTable::ATTR_DIRECTORY))
+            key.primary = GROUP_BIT;
+
+        switch (sortOrder.key) {
+            case SortKey::SCAN:
+                key.primary |= i;
+                return key;
+            case SortKey::NAME:
+                break;
+            case SortKey::EXTENSION:
+                key.primary |= packExtension(table.name(i)) >> 8;
+                break;
+            case SortKey::TYPE:
+                key.primary |= static_cast<std::uint64_t>(table.fileClass(i)) << 56;
+                key.primary |= packExtension(table.name(i)) >> 16;
+                break;
+            case SortKey::SIZE:
+                key.primary |= VALUE_MASK - std::min<std::uint64_t>(table.fileSize(i), VALUE_MASK);
+                break;
+            case SortKey::MTIME: {
+                constexpr std::int64_t BIAS = std::int64_t(1) << 62;
+                std::int64_t mtime = std::clamp<std::int64_t>(table.mtime(i), -BIAS, BIAS - 1);
+                key.primary |= VALUE_MASK - static_cast<std::uint64_t>(mtime + BIAS);
+                break;
+            }
+        }
+
+        unsigned char prefix[16] = {};
+        naturalForm(table.name(i), prefix, sizeof(prefix));
+        key.prefix[0] = loadBigEndian(prefix);
+        key.prefix[1] = loadBigEndian(prefix + 8);
+        return key;
+    }
+
+    /**
+     * @brief Compares two names in natural order, then bytewise so that no two names tie.
+     */
+    int ListingSorter::compareNames(std::string_view a, std::string_view b) noexcept
+    {
+        // A name is at most 255 bytes, so its natural form is at most 511
+        unsigned char formA[512];
+        unsigned char formB[512];
+        std::size_t lengthA = naturalForm(a, formA, sizeof(formA));
+        std::size_t lengthB = naturalForm(b, formB, sizeof(formB));
+
+        if (int c = std::memcmp(formA, formB, std::min(lengthA, lengthB)); c != 0)
+            return c;
+        if (lengthA != lengthB)
+            return lengthA < lengthB ? -1 : 1;
+        return a.compare(b);
+    }
+
+    /**
+     * @brief Orders by primary criterion, then name prefix, then full name, then table index.
+     */
+    bool ListingSorter::Less::operator()(const Key& a, const Key& b) const noexcept
+    {
+        if (a.primary != b.primary)
+            return a.primary < b.primary;
+        if (_byName) {
+            if (a.prefix[0] != b.prefix[0])
+                return a.prefix[0] < b.prefix[0];
+            if (a.prefix[1] != b.prefix[1])
+                return a.prefix[1] < b.prefix[1];
+            if (int c = compareNames(_table.name(a.index), _table.name(b.index)); c != 0)
+                return c < 0;
+        }
+        return a.index < b.index;
+    }
+
+} // namespace core
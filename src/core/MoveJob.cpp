@@ -0,0 +1,362 @@
+/**
+ * @file MoveJob.cpp
+ * @brief Implementation of the core::MoveJob class
+ * @date 2025-07-01
+ */
+
+#include "core/MoveJob.hpp"
+#include "core/DirectoryScanner.hpp"
+#include "core/DiskUsage.hpp"
+#include "core/FileIdentity.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <sys/xattr.h>
+#include <unistd.h>
+
+namespace core {
+
+    namespace {
+
+        constexpr std::size_t SCAN_BUFFER = 32 * 1024;
+
+        [[noreturn]] void fail(const std::string& path)
+        {
+            throw std::system_error(errno, std::generic_category(), path);
+        }
+
+        std::string filenameOf(const std::string& path)
+        {
+            std::string trimmed = path;
+            while (trimmed.size() > 1 && trimmed.back() == '/')
+                trimmed.pop_back();
+            std::size_t slash = trimmed.rfind('/');
+            return slash == std::string::npos ? trimmed : trimmed.substr(slash + 1);
+        }
+
+        /**
+         * @brief Whether copy_file_range failed because it cannot copy between these files.
+         */
+        bool unsupported(int error) noexcept
+        {
+            return error == EXDEV || error == EINVAL || error == ENOSYS || error == EOPNOTSUPP || error == EBADF;
+        }
+
+        /**
+         * @brief Renames without replacing anything. A file system that does not know the flag
+         * gets a check before a plain rename, which leaves a window the flag does not.
+         * @return 0, or -1 with errno set.
+         */
+        int renameNoReplace(const char* from, const char* to) noexcept
+        {
+            if (::renameat2(AT_FDCWD, from, AT_FDCWD, to, RENAME_NOREPLACE) == 0)
+                return 0;
+            if (errno != EINVAL && errno != ENOSYS)
+                return -1;
+
+            struct stat st;
+            if (::lstat(to, &st) == 0) {
+                errno = EEXIST;
+                return -1;
+            }
+            return ::rename(from, to);
+        }
+
+        /**
+         * @brief What identifies a source file and its content, as its copy records it.
+         */
+        std::string originOf(const struct stat& st)
+        {
+            return std::to_string(st.st_dev) + ":" + std::to_string(st.st_ino) + ":" + std::to_string(st.st_size)
+                + ":" + std::to_string(st.st_mtim.tv_sec) + "." + std::to_string(st.st_mtim.tv_nsec);
+        }
+
+        /**
+         * @brief Whether a partial copy was made from the source as it is now.
+         */
+        bool hasOrigin(int fd, const std::string& origin) noexcept
+        {
+            char recorded[128];
+            ssize_t length = ::fgetxattr(fd, MoveJob::ORIGIN_ATTRIBUTE, recorded, sizeof(recorded));
+            return length == static_cast<ssize_t>(origin.size()) && std::memcmp(recorded, origin.data(), origin.size()) == 0;
+        }
+
+        /**
+         * @brief Closes a descriptor when the move leaves, whether it ends or throws.
+         */
+        struct FdGuard {
+            int fd = -1;
+            ~FdGuard() { if (fd >= 0) ::close(fd); }
+        };
+
+    } // namespace
+
+    /**
+     * @param description What the job is shown as.
+     * @param source The file or directory to move.
+     * @param destinationDirectory The directory to move it into, under its own name.
+     */
+    MoveJob::MoveJob(std::string description, std::string source, const std::string& destinationDirectory)
+        : Job(std::move(description)), _source(std::move(source)),
+          _destination(destinationDirectory + "/" + filenameOf(_source)),
+          _partial(destinationDirectory + "/" + PARTIAL_PREFIX + filenameOf(_source)), _rangeUnsupported(false)
+    {}
+
+    void MoveJob::run()
+    {
+        struct stat st;
+        if (::lstat(_source.c_str(), &st) != 0) {
+            // Interrupted after the last of the source went, before the copy was put in place
+            if (errno == ENOENT && ::lstat(_partial.c_str(), &st) == 0) {
+                setTotals(0, 1);
+                if (renameNoReplace(_partial.c_str(), _destination.c_str()) != 0)
+                    fail(_destination);
+                advance(0, 1);
+                return;
+            }
+            fail(_source);
+        }
+
+        // Streamed into itself, the tree would grow as it is walked and go as it is copied
+        std::string destinationDirectory = _destination.substr(0, _destination.rfind('/'));
+        FileIdentity source = FileIdentity::of(st);
+        if (S_ISDIR(st.st_mode) && (source.encloses(_destination) || source.encloses(destinationDirectory)))
+            throw std::system_error(std::make_error_code(std::errc::invalid_argument), _destination);
+
+        if (renameNoReplace(_source.c_str(), _destination.c_str()) == 0) {
+            setTotals(0, 1);
+            advance(0, 1);
+            return;
+        }
+        if (errno != EXDEV)
+            fail(_destination);
+        // Checked here too, so that an interrupted move does not stream everything again to fail at the end
+        struct stat existing;
+        if (::lstat(_destination.c_str(), &existing) == 0)
+            throw std::system_error(std::make_error_code(std::errc::file_exists), _destination);
+
+        if (S_ISDIR(st.st_mode)) {
+            // The walk leaves the root out of the directories it counts
+            DiskUsage usage(_source);
+            usage.wait();
+            UsageTotals totals = usage.progress();
+            setTotals(totals.bytes, totals.files + totals.directories + 1);
+        } else {
+            setTotals(static_cast<std::uint64_t>(st.st_size), 1);
+        }
+
+        moveEntry(AT_FDCWD, AT_FDCWD, _source.c_str(), _partial.c_str(), _source);
+        if (cancelled())
+            return;
+        if (renameNoReplace(_partial.c_str(), _destination.c_str()) != 0)
+            fail(_destination);
+    }
+
+    /**
+     * @brief Moves what a directory holds into its copy, which exists already.
+     * @param path The source directory's path, for error messages.
+     */
+    void MoveJob::moveDirectory(int sourceDir, int destinationDir, const std::string& path)
+    {
+        std::vector<std::string> names;
+        DirectoryScanner scanner(sourceDir, SCAN_BUFFER);
+        scanner.scan([&](std::string_view name, EntryType) {
+            names.emplace_back(name);
+            return true;
+        });
+
+        for (const auto& name : names) {
+            moveEntry(sourceDir, destinationDir, name.c_str(), name.c_str(), path + "/" + name);
+            if (cancelled())
+                return;
+        }
+    }
+
+    /**
+     * @brief Moves one entry of any type across file systems, and removes it from the source
+     * once its copy is complete. What a previous move left of the copy is carried on.
+     * @param destination The name of the copy in destinationDir.
+     * @param path The entry's path, for error messages.
+     */
+    void MoveJob::moveEntry(int sourceDir, int destinationDir, const char* name, const char* destination,
+                            const std::string& path)
+    {
+        struct stat st;
+
+        if (!checkpoint())
+            return;
+        if (::fstatat(sourceDir, name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+            fail(path);
+
+        if (S_ISREG(st.st_mode)) {
+            moveFile(sourceDir, destinationDir, name, destination, path);
+            return;
+        }
+
+        if (S_ISDIR(st.st_mode)) {
+            if (::mkdirat(destinationDir, destination, st.st_mode & 07777) != 0 && errno != EEXIST)
+                fail(path);
+            FdGuard in{::openat(sourceDir, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC)};
+            FdGuard out{::openat(destinationDir, destination, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC)};
+            if (in.fd < 0 || out.fd < 0)
+                fail(path);
+            advance(static_cast<std::uint64_t>(st.st_size));
+            moveDirectory(in.fd, out.fd, path);
+            if (cancelled())
+                return;
+            // Filling the copy changed its times: they are set once it is complete
+            struct timespec times[2] = { st.st_atim, st.st_mtim };
+            ::futimens(out.fd, times);
+        } else if (S_ISLNK(st.st_mode)) {
+            std::string target(static_cast<std::size_t>(st.st_size) + 1, '\0');
+            ssize_t length = ::readlinkat(sourceDir, name, target.data(), target.size());
+            if (length < 0)
+                fail(path);
+            target.resize(static_cast<std::size_t>(length));
+            ::unlinkat(destinationDir, destination, 0);
+            if (::symlinkat(target.c_str(), destinationDir, destination) != 0)
+                fail(path);
+            advance(static_cast<std::uint64_t>(st.st_size));
+        } else if (::mknodat(destinationDir, destination, st.st_mode, st.st_rdev) != 0 && errno != EEXIST) {
+            // Pipes, sockets and devices are made anew; they hold nothing to copy
+            fail(path);
+        }
+
+        if (::unlinkat(sourceDir, name, S_ISDIR(st.st_mode) ? AT_REMOVEDIR : 0) != 0)
+            fail(path);
+        advance(0, 1);
+    }
+
+    /**
+     * @brief Copies a file from where its copy stopped, if that copy was made from the file as it
+     * is now, gives the copy the file's mode and times, and unlinks the file.
+     * @param path The source file's path, for error messages.
+     */
+    void MoveJob::moveFile(int sourceDir, int destinationDir, const char* name, const char* destination,
+                           const std::string& path)
+    {
+        struct stat st;
+        struct stat copied;
+
+        FdGuard in{::openat(sourceDir, name, O_RDONLY | O_NOFOLLOW | O_CLOEXEC)};
+        if (in.fd < 0 || ::fstat(in.fd, &st) != 0)
+            fail(path);
+        FdGuard out{::openat(destinationDir, destination, O_WRONLY | O_CREAT | O_NOFOLLOW | O_CLOEXEC, 0600)};
+        if (out.fd < 0 || ::fstat(out.fd, &copied) != 0)
+            fail(path);
+
+        auto size = static_cast<std::uint64_t>(st.st_size);
+        std::string origin = originOf(st);
+        std::uint64_t offset = 0;
+        if (copied.st_size > 0 && hasOrigin(out.fd, origin))
+            offset = std::min(static_cast<std::uint64_t>(copied.st_size), size);
+        if (static_cast<std::uint64_t>(copied.st_size) != offset && ::ftruncate(out.fd, static_cast<off_t>(offset)) != 0)
+            fail(path);
+        // Without the attribute, an interrupted copy is only started over
+        if (offset == 0)
+            ::fsetxattr(out.fd, ORIGIN_ATTRIBUTE, origin.data(), origin.size(), 0);
+        advance(offset);
+
+        try {
+            if (!copyRange(in.fd, out.fd, offset, size))
+                copyBuffered(in.fd, out.fd, offset, size);
+        } catch (const std::system_error& e) {
+            // The helpers only know the descriptors: name the file
+            throw std::system_error(e.code(), path);
+        }
+        if (cancelled())
+            return;
+
+        // The source is the only good copy until this one is known to be whole
+        struct stat now;
+        if (::fstat(in.fd, &now) != 0 || ::fstat(out.fd, &copied) != 0)
+            fail(path);
+        if (originOf(now) != origin)
+            throw std::runtime_error(path + ": changed while being moved");
+        if (static_cast<std::uint64_t>(copied.st_size) != size)
+            throw std::runtime_error(path + ": copy is " + std::to_string(copied.st_size) + " bytes, not "
+                                     + std::to_string(size));
+
+        struct timespec times[2] = { st.st_atim, st.st_mtim };
+        if (::fremovexattr(out.fd, ORIGIN_ATTRIBUTE) != 0 && errno != ENODATA && errno != ENOTSUP)
+            fail(path);
+        if (::fchmod(out.fd, st.st_mode & 07777) != 0 || ::futimens(out.fd, times) != 0)
+            fail(path);
+        if (::unlinkat(sourceDir, name, 0) != 0)
+            fail(path);
+        advance(0, 1);
+    }
+
+    /**
+     * @brief Copies from an offset to the end with copy_file_range, moving the offset as it goes.
+     * @return False if copy_file_range cannot copy between these files; it may have copied a part.
+     */
+    bool MoveJob::copyRange(int in, int out, std::uint64_t& offset, std::uint64_t size)
+    {
+        if (_rangeUnsupported)
+            return false;
+
+        while (offset < size && checkpoint()) {
+            auto inOffset = static_cast<loff_t>(offset);
+            auto outOffset = static_cast<loff_t>(offset);
+            std::size_t chunk = static_cast<std::size_t>(std::min<std::uint64_t>(RANGE_CHUNK_SIZE, size - offset));
+            ssize_t n = ::copy_file_range(in, &inOffset, out, &outOffset, chunk, 0);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                if (unsupported(errno)) {
+                    _rangeUnsupported = true;
+                    return false;
+                }
+                throw std::system_error(errno, std::generic_category());
+            }
+            if (n == 0)
+                break;
+            offset += static_cast<std::uint64_t>(n);
+            advance(static_cast<std::uint64_t>(n));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Copies from an offset to the end through a buffer, moving the offset as it goes.
+     */
+    void MoveJob::copyBuffered(int in, int out, std::uint64_t& offset, std::uint64_t size)
+    {
+        std::unique_ptr<char[]> buffer(new char[CHUNK_SIZE]);
+        while (offset < size && checkpoint()) {
+            std::size_t chunk = static_cast<std::size_t>(std::min<std::uint64_t>(CHUNK_SIZE, size - offset));
+            ssize_t n = ::pread(in, buffer.get(), chunk, static_cast<off_t>(offset));
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::generic_category());
+            }
+            if (n == 0)
+                return;
+            for (ssize_t written = 0; written < n;) {
+                ssize_t w = ::pwrite(out, buffer.get() + written, static_cast<std::size_t>(n - written),
+                                     static_cast<off_t>(offset) + written);
+                if (w < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::system_error(errno, std::generic_category());
+                }
+                written += w;
+            }
+            offset += static_cast<std::uint64_t>(n);
+            advance(static_cast<std::uint64_t>(n));
+        }
+    }
+
+} // namespace core
@@ -0,0 +1,284 @@
+/**
+ * @file PathIndex.cpp
+ * @brief Implementation of the core::PathIndex class
+ * @date 2025-06-22
+ */
+
+#include "core/PathIndex.hpp"
+#include "core/DirectoryScanner.hpp"
+
+#include <ctime>
+#include <limits>
+#include <optional>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace core {
+
+    namespace {
+
+        // Small enough to come from the heap rather than a fresh mapping for each directory
+        constexpr std::size_t SCAN_BUFFER = 32 * 1024;
+
+        unsigned charBit(unsigned char c) noexcept
+        {
+            if ((c | 0x20) >= 'a' && (c | 0x20) <= 'z')
+                return (c | 0x20) - 'a';
+            if (c >= '0' && c <= '9')
+                return 26 + (c - '0');
+            return 36 + c % 28;
+        }
+
+    } // namespace
+
+    void PathChunkBuilder::add(std::string_view path, bool directory)
+    {
+        std::size_t slash = path.rfind('/');
+
+        offsets.push_back(static_cast<std::uint32_t>(bytes.size()));
+        lengths.push_back(static_cast<std::uint16_t>(path.size()));
+        nameStarts.push_back(static_cast<std::uint16_t>(slash == std::string_view::npos ? 0 : slash + 1));
+        masks.push_back(PathIndex::charMask(path));
+        directories.push_back(directory ? 1 : 0);
+        bytes.insert(bytes.end(), path.begin(), path.end());
+        bytes.push_back('\0');
+    }
+
+    /**
+     * @brief Moves the columns into a chunk of their own, leaving the builder empty.
+     */
+    std::shared_ptr<const PathChunk> PathChunkBuilder::publish()
+    {
+        auto owned = std::make_shared<PathChunkBuilder>(std::move(*this));
+        auto chunk = std::make_shared<PathChunk>();
+
+        chunk->bytes = owned->bytes.data();
+        chunk->byteCount = owned->bytes.size();
+        chunk->offsets = owned->offsets.data();
+        chunk->lengths = owned->lengths.data();
+        chunk->nameStarts = owned->nameStarts.data();
+        chunk->masks = owned->masks.data();
+        chunk->directories = owned->directories.data();
+        chunk->count = owned->size();
+        chunk->storage = std::move(owned);
+        *this = PathChunkBuilder();
+        return chunk;
+    }
+
+    /**
+     * @brief Opens the stored index of root, if any, and starts walking right away.
+     * @param root The directory to walk; paths are reported relative to it.
+     * @param notifier Optional notifier, signalled whenever a chunk is published.
+     * @param pool The pool the walk runs on.
+     */
+    PathIndex::PathIndex(const std::string& root, EventNotifier* notifier, ThreadPool& pool)
+        : _root(root), _rootFd(::open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)), _notifier(notifier),
+          _pool(pool), _started(std::time(nullptr)), _committed(0), _generation(0), _pending(0), _cancelled(false), _finished(false), _paths(0)
+    {
+        if (_rootFd < 0) {
+            _finished = true;
+            return;
+        }
+        _stored = PathIndexFile::open(root, CHUNK_PATHS);
+        if (_stored) {
+            _chunks = _stored->chunks();
+            _paths = _stored->pathCount();
+        }
+        start("");
+    }
+
+    PathIndex::~PathIndex()
+    {
+        _cancelled = true;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _idle.wait(lock, [this] { return _pending == 0; });
+        }
+        if (_rootFd >= 0)
+            ::close(_rootFd);
+    }
+
+    PathIndex::Snapshot PathIndex::snapshot() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _chunks;
+    }
+
+    std::size_t PathIndex::chunkCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _chunks.size();
+    }
+
+    /**
+     * @brief How many times the snapshot was replaced rather than extended. A search must start
+     * over when it changes.
+     */
+    std::size_t PathIndex::generation() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _generation;
+    }
+
+    /**
+     * @brief One bit per letter, ignoring case, one per digit, and the other bytes folded onto
+     * the remaining 28 bits. A text can only contain another if its mask covers the other's.
+     */
+    std::uint64_t PathIndex::charMask(std::string_view text) noexcept
+    {
+        std::uint64_t mask = 0;
+
+        for (char c : text)
+            mask |= std::uint64_t(1) << charBit(static_cast<unsigned char>(c));
+        return mask;
+    }
+
+    void PathIndex::start(std::string relative)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_pending;
+        }
+        _pool.submit([this, relative = std::move(relative)] { walk(relative); });
+    }
+
+    /**
+     * @brief Lists one directory and queues its subdirectories. Paths are gathered locally and
+     * handed over in one go, so the lock is taken once per directory.
+     * A directory that has not changed since the stored walk is not read: its stored entries
+     * are used instead.
+     */
+    void PathIndex::walk(const std::string& relative)
+    {
+        PathChunkBuilder local;
+        IndexedDirectory walked { relative, {}, 0, 0 };
+        std::optional<DirectoryStamp> stamp;
+        bool listed = false;
+
+        if (!_cancelled.load(std::memory_order_relaxed))
+            stamp = DirectoryStamp::of(_rootFd, relative.empty() ? "." : relative.c_str());
+        if (stamp) {
+            // A change in the same clock tick as the listing would leave the stamp as it is:
+            // a directory touched around the start of the walk is stored to be listed again
+            if (stamp->mtimeSec < _started - 1 && stamp->ctimeSec < _started - 1)
+                walked.stamp = *stamp;
+            const PathIndexFile::DirectoryRecord* known = _stored ? _stored->findDirectory(relative) : nullptr;
+
+            if (known && _stored->unchanged(*known, *stamp)) {
+                _stored->forEachEntry(*known, [&](std::string_view path, bool directory) {
+                    local.add(path, directory);
+                    if (directory)
+                        start(std::string(path));
+                });
+                listed = true;
+            } else {
+                int fd = ::openat(_rootFd, relative.empty() ? "." : relative.c_str(),
+                                  O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+                if (fd >= 0) {
+                    DirectoryScanner scanner(fd, SCAN_BUFFER);
+                    std::string path = relative.empty() ? relative : relative + "/";
+                    std::size_t base = path.size();
+
+                    scanner.scan([&](std::string_view name, EntryType type) {
+                        path.resize(base);
+                        path.append(name);
+                        if (path.size() <= std::numeric_limits<std::uint16_t>::max()) {
+                            bool directory = type == EntryType::DIRECTORY;
+                            local.add(path, directory);
+                            if (directory)
+                                start(path);
+                        }
+                        return !_cancelled.load(std::memory_order_relaxed);
+                    });
+                    ::close(fd);
+                    listed = true;
+                }
+            }
+        }
+        commit(local, listed ? &walked : nullptr);
+    }
+
+    /**
+     * @brief Moves a directory's paths into the open chunk, publishing it each time it fills up.
+     * The last directory to finish publishes what is left and marks the walk finished.
+     * @param walked The directory, or nullptr if it could not be listed.
+     */
+    void PathIndex::commit(PathChunkBuilder& local, IndexedDirectory* walked)
+    {
+        EventNotifier* notifier = nullptr;
+        bool last = false;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (walked) {
+                walked->firstPath = _committed;
+                walked->entryCount = local.size();
+                _walked.push_back(std::move(*walked));
+            }
+            _committed += local.size();
+
+            for (std::size_t i = 0; i < local.size(); ++i) {
+                std::string_view path = local.path(i);
+                _open.offsets.push_back(static_cast<std::uint32_t>(_open.bytes.size()));
+                _open.lengths.push_back(local.lengths[i]);
+                _open.nameStarts.push_back(local.nameStarts[i]);
+                _open.masks.push_back(local.masks[i]);
+                _open.directories.push_back(local.directories[i]);
+                _open.bytes.insert(_open.bytes.end(), path.begin(), path.end());
+                _open.bytes.push_back('\0');
+                if (_open.size() >= CHUNK_PATHS) {
+                    publishOpen();
+                    if (!_stored)
+                        notifier = _notifier;
+                }
+            }
+            if (!_stored)
+                _paths.fetch_add(local.size(), std::memory_order_relaxed);
+
+            last = _pending == 1;
+            if (last) {
+                if (_open.size() > 0)
+                    publishOpen();
+                if (_stored && !_cancelled.load(std::memory_order_relaxed)) {
+                    _chunks = _fresh;
+                    _paths.store(_committed, std::memory_order_relaxed);
+                    ++_generation;
+                }
+                _finished.store(true, std::memory_order_release);
+                notifier = _notifier;
+            } else {
+                // The destructor may run as soon as the lock is released: no member is used past it
+                --_pending;
+            }
+        }
+        if (notifier)
+            notifier->notify();
+        if (last)
+            finish();
+    }
+
+    /**
+     * @brief Saves a complete walk, then lets the destructor through.
+     */
+    void PathIndex::finish()
+    {
+        if (!_cancelled.load(std::memory_order_relaxed) && !_walked.empty())
+            PathIndexFile::write(_root, _fresh, CHUNK_PATHS, std::move(_walked));
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending = 0;
+        _idle.notify_all();
+    }
+
+    /**
+     * @brief Publishes the open chunk. While a stored index is shown, fresh chunks are held back
+     * until the walk completes.
+     */
+    void PathIndex::publishOpen()
+    {
+        _fresh.push_back(_open.publish());
+        if (!_stored)
+            _chunks.push_back(_fresh.back());
+    }
+
+} // namespace core
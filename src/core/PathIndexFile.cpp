@@ -0,0 +1,411 @@
+/**
+ * @file PathIndexFile.cpp
+ * @brief Implementation of the core::PathIndexFile class
+ * @date 2025-06-24
+ */
+
+#include "core/PathIndexFile.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace core {
+
+    struct PathIndexFile::Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint64_t fileSize;
+        std::uint64_t pathCount;
+        std::uint64_t chunkPaths;
+        std::uint64_t chunkCount;
+        std::uint64_t chunksOffset;
+        std::uint64_t directoryCount;
+        std::uint64_t directoriesOffset;
+        std::uint64_t namesOffset;
+        std::uint64_t namesSize;
+        std::uint64_t rootOffset;
+        std::uint64_t rootLength;
+    };
+
+    /**
+     * @brief Where each column of a chunk lies in the file.
+     */
+    struct PathIndexFile::ChunkRecord {
+        std::uint64_t count;
+        std::uint64_t byteCount;
+        std::uint64_t bytes;
+        std::uint64_t offsets;
+        std::uint64_t lengths;
+        std::uint64_t nameStarts;
+        std::uint64_t masks;
+        std::uint64_t directories;
+    };
+
+    /**
+     * @brief An IndexedDirectory, with its path stored in the names section.
+     */
+    struct PathIndexFile::DirectoryRecord {
+        std::uint64_t nameOffset;
+        std::uint64_t nameLength;
+        std::int64_t mtimeSec;
+        std::int64_t ctimeSec;
+        std::uint32_t mtimeNsec;
+        std::uint32_t ctimeNsec;
+        std::uint64_t firstPath;
+        std::uint64_t entryCount;
+    };
+
+    namespace {
+
+        constexpr char MAGIC[8] = { 'F', 'M', 'A', 'N', 'I', 'D', 'X', '\0' };
+        // Reads back differently on a machine of the other byte order
+        constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+        std::uint64_t alignUp(std::uint64_t value, std::uint64_t alignment) noexcept
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        /**
+         * @brief Whether count items of size bytes, starting at offset, lie within the file and are
+         * aligned for their type. Sections are aligned on 8 bytes at most.
+         */
+        bool fits(std::uint64_t offset, std::uint64_t count, std::uint64_t size, std::uint64_t fileSize) noexcept
+        {
+            if (offset % std::min<std::uint64_t>(size, 8) != 0 || offset > fileSize)
+                return false;
+            return count <= (fileSize - offset) / size;
+        }
+
+        std::string canonical(const std::string& root)
+        {
+            char resolved[PATH_MAX];
+
+            if (::realpath(root.c_str(), resolved) == nullptr)
+                return root;
+            return resolved;
+        }
+
+        std::uint64_t hashPath(std::string_view path) noexcept
+        {
+            std::uint64_t hash = 0xcbf29ce484222325ULL;
+
+            for (char c : path) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 0x100000001b3ULL;
+            }
+            return hash;
+        }
+
+    } // namespace
+
+    PathIndexFile::PathIndexFile(const char* data, std::size_t size, std::size_t chunkPaths)
+        : _data(data), _size(size), _chunkPaths(chunkPaths), _header(reinterpret_cast<const Header*>(data)),
+          _chunks(nullptr), _directories(nullptr)
+    {}
+
+    PathIndexFile::~PathIndexFile()
+    {
+        ::munmap(const_cast<char*>(_data), _size);
+    }
+
+    /**
+     * @brief Where the index of root is kept: $XDG_CACHE_HOME/fman, or ~/.cache/fman, under a
+     * name derived from the root's canonical path.
+     * @return The path of the file, or an empty string if there is no cache directory.
+     */
+    std::string PathIndexFile::location(const std::string& root)
+    {
+        std::string directory;
+        const char* cache = std::getenv("XDG_CACHE_HOME");
+        const char* home = std::getenv("HOME");
+
+        if (cache != nullptr && cache[0] == '/')
+            directory = cache;
+        else if (home != nullptr && home[0] == '/')
+            directory = std::string(home) + "/.cache";
+        else
+            return {};
+
+        char name[17];
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hashPath(canonical(root))));
+        return directory + "/fman/" + name + ".idx";
+    }
+
+    /**
+     * @brief Maps the stored index of root.
+     * @param chunkPaths How many paths every chunk but the last holds.
+     * @return The index, or nullptr if there is none or it does not match this build or root.
+     */
+    std::shared_ptr<const PathIndexFile> PathIndexFile::open(const std::string& root, std::size_t chunkPaths)
+    {
+        std::string path = location(root);
+        if (path.empty())
+            return nullptr;
+
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return nullptr;
+
+        struct stat st;
+        void* data = MAP_FAILED;
+        if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(Header))
+            data = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+            return nullptr;
+
+        // Searches read every chunk: start paging the file in while the view opens
+        ::madvise(data, static_cast<std::size_t>(st.st_size), MADV_WILLNEED);
+        std::shared_ptr<PathIndexFile> file(new PathIndexFile(static_cast<const char*>(data),
+                                                              static_cast<std::size_t>(st.st_size), chunkPaths));
+        if (!file->validate(canonical(root)))
+            return nullptr;
+        return file;
+    }
+
+    /**
+     * @brief Checks the header and the chunk table, so that chunks() and the lookups stay within
+     * the mapping. Directory records are checked as they are read.
+     */
+    bool PathIndexFile::validate(const std::string& root) noexcept
+    {
+        const Header& header = *_header;
+
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != FORMAT_VERSION
+            || header.byteOrder != BYTE_ORDER_MARK || header.fileSize != _size || header.chunkPaths != _chunkPaths)
+            return false;
+        if (!fits(header.rootOffset, header.rootLength, 1, _size)
+            || std::string_view(_data + header.rootOffset, header.rootLength) != root)
+            return false;
+        if (!fits(header.chunksOffset, header.chunkCount, sizeof(ChunkRecord), _size)
+            || !fits(header.directoriesOffset, header.directoryCount, sizeof(DirectoryRecord), _size)
+            || !fits(header.namesOffset, header.namesSize, 1, _size))
+            return false;
+
+        _chunks = reinterpret_cast<const ChunkRecord*>(_data + header.chunksOffset);
+        _directories = reinterpret_cast<const DirectoryRecord*>(_data + header.directoriesOffset);
+
+        std::uint64_t total = 0;
+        for (std::uint64_t c = 0; c < header.chunkCount; ++c) {
+            const ChunkRecord& chunk = _chunks[c];
+            bool last = c + 1 == header.chunkCount;
+            if (chunk.count == 0 || chunk.count > _chunkPaths || (!last && chunk.count != _chunkPaths))
+                return false;
+            if (!fits(chunk.bytes, chunk.byteCount, 1, _size)
+                || !fits(chunk.offsets, chunk.count, sizeof(std::uint32_t), _size)
+                || !fits(chunk.lengths, chunk.count, sizeof(std::uint16_t), _size)
+                || !fits(chunk.nameStarts, chunk.count, sizeof(std::uint16_t), _size)
+                || !fits(chunk.masks, chunk.count, sizeof(std::uint64_t), _size)
+                || !fits(chunk.directories, chunk.count, 1, _size))
+                return false;
+            total += chunk.count;
+        }
+        return total == header.pathCount;
+    }
+
+    std::size_t PathIndexFile::pathCount() const noexcept
+    {
+        return static_cast<std::size_t>(_header->pathCount);
+    }
+
+    /**
+     * @brief The stored chunks, pointing into the mapping. Each of them keeps the file mapped.
+     */
+    std::vector<std::shared_ptr<const PathChunk>> PathIndexFile::chunks() const
+    {
+        std::vector<std::shared_ptr<const PathChunk>> chunks;
+        std::shared_ptr<const void> storage = shared_from_this();
+
+        chunks.reserve(_header->chunkCount);
+        for (std::uint64_t c = 0; c < _header->chunkCount; ++c) {
+            const ChunkRecord& record = _chunks[c];
+            auto chunk = std::make_shared<PathChunk>();
+            chunk->bytes = _data + record.bytes;
+            chunk->byteCount = record.byteCount;
+            chunk->offsets = reinterpret_cast<const std::uint32_t*>(_data + record.offsets);
+            chunk->lengths = reinterpret_cast<const std::uint16_t*>(_data + record.lengths);
+            chunk->nameStarts = reinterpret_cast<const std::uint16_t*>(_data + record.nameStarts);
+            chunk->masks = reinterpret_cast<const std::uint64_t*>(_data + record.masks);
+            chunk->directories = reinterpret_cast<const std::uint8_t*>(_data + record.directories);
+            chunk->count = record.count;
+            chunk->storage = storage;
+            chunks.push_back(std::move(chunk));
+        }
+        return chunks;
+    }
+
+    std::string_view PathIndexFile::directoryPath(const DirectoryRecord& directory) const noexcept
+    {
+        if (directory.nameOffset > _header->namesSize || directory.nameLength > _header->namesSize - directory.nameOffset)
+            return {};
+        return { _data + _header->namesOffset + directory.nameOffset, directory.nameLength };
+    }
+
+    /**
+     * @brief Finds a stored directory by its path relative to the root, by binary search on the mapping.
+     * @return The record, or nullptr if the directory was not walked.
+     */
+    const PathIndexFile::DirectoryRecord* PathIndexFile::findDirectory(std::string_view path) const noexcept
+    {
+        const DirectoryRecord* first = _directories;
+        const DirectoryRecord* last = _directories + _header->directoryCount;
+        const DirectoryRecord* found = std::partition_point(first, last, [&](const DirectoryRecord& record) {
+            return directoryPath(record) < path;
+        });
+
+        if (found == last || directoryPath(*found) != path)
+            return nullptr;
+        return found;
+    }
+
+    /**
+     * @brief Whether a directory is the one that was walked, unmodified since.
+     */
+    bool PathIndexFile::unchanged(const DirectoryRecord& directory, const DirectoryStamp& stamp) const noexcept
+    {
+        return directory.mtimeSec == stamp.mtimeSec && directory.mtimeNsec == stamp.mtimeNsec
+            && directory.ctimeSec == stamp.ctimeSec && directory.ctimeNsec == stamp.ctimeNsec;
+    }
+
+    std::pair<std::uint64_t, std::uint64_t> PathIndexFile::entryRange(const DirectoryRecord& directory) const noexcept
+    {
+        std::uint64_t first = std::min(directory.firstPath, _header->pathCount);
+        std::uint64_t last = first + std::min(directory.entryCount, _header->pathCount - first);
+        return { first, last };
+    }
+
+    std::string_view PathIndexFile::entryPath(std::uint64_t ordinal, bool& directory) const noexcept
+    {
+        const ChunkRecord& chunk = _chunks[ordinal / _chunkPaths];
+        std::size_t index = ordinal % _chunkPaths;
+        std::uint32_t offset = reinterpret_cast<const std::uint32_t*>(_data + chunk.offsets)[index];
+        std::uint16_t length = reinterpret_cast<const std::uint16_t*>(_data + chunk.lengths)[index];
+
+        directory = reinterpret_cast<const std::uint8_t*>(_data + chunk.directories)[index] != 0;
+        if (offset > chunk.byteCount || length > chunk.byteCount - offset)
+            return {};
+        return { _data + chunk.bytes + offset, length };
+    }
+
+    /**
+     * @brief Saves an index of root, replacing the stored one.
+     * @param chunks The paths, every chunk but the last full.
+     * @param chunkPaths How many paths a full chunk holds.
+     * @param directories The directories walked, their entries numbered across chunks.
+     * @return False if the file could not be written.
+     */
+    bool PathIndexFile::write(const std::string& root, const std::vector<std::shared_ptr<const PathChunk>>& chunks,
+                              std::size_t chunkPaths, std::vector<IndexedDirectory> directories)
+    {
+        std::string path = location(root);
+        if (path.empty())
+            return false;
+
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+        std::string rootPath = canonical(root);
+        std::sort(directories.begin(), directories.end(),
+                  [](const IndexedDirectory& a, const IndexedDirectory& b) { return a.path < b.path; });
+
+        // Lay the sections out first, each aligned for its widest field
+        Header header {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = FORMAT_VERSION;
+        header.byteOrder = BYTE_ORDER_MARK;
+        header.chunkCount = chunks.size();
+        header.chunkPaths = chunkPaths;
+        header.directoryCount = directories.size();
+
+        std::uint64_t cursor = sizeof(Header);
+        auto reserve = [&cursor](std::uint64_t bytes) {
+            std::uint64_t at = alignUp(cursor, 8);
+            cursor = at + bytes;
+            return at;
+        };
+        header.rootOffset = reserve(rootPath.size());
+        header.rootLength = rootPath.size();
+        header.chunksOffset = reserve(chunks.size() * sizeof(ChunkRecord));
+        header.directoriesOffset = reserve(directories.size() * sizeof(DirectoryRecord));
+        for (const auto& directory : directories)
+            header.namesSize += directory.path.size();
+        header.namesOffset = reserve(header.namesSize);
+
+        std::vector<ChunkRecord> records(chunks.size());
+        for (std::size_t c = 0; c < chunks.size(); ++c) {
+            const PathChunk& chunk = *chunks[c];
+            ChunkRecord& record = records[c];
+            record.count = chunk.size();
+            record.byteCount = chunk.byteCount;
+            record.masks = reserve(chunk.size() * sizeof(std::uint64_t));
+            record.offsets = reserve(chunk.size() * sizeof(std::uint32_t));
+            record.lengths = reserve(chunk.size() * sizeof(std::uint16_t));
+            record.nameStarts = reserve(chunk.size() * sizeof(std::uint16_t));
+            record.directories = reserve(chunk.size());
+            record.bytes = reserve(chunk.byteCount);
+            header.pathCount += chunk.size();
+        }
+        header.fileSize = alignUp(cursor, 8);
+
+        std::string temporary = path + ".tmp." + std::to_string(::getpid());
+        int fd = ::open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (fd < 0)
+            return false;
+        void* mapping = MAP_FAILED;
+        if (::ftruncate(fd, static_cast<off_t>(header.fileSize)) == 0)
+            mapping = ::mmap(nullptr, header.fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            ::unlink(temporary.c_str());
+            return false;
+        }
+
+        auto* data = static_cast<char*>(mapping);
+        std::memcpy(data, &header, sizeof(header));
+        std::memcpy(data + header.rootOffset, rootPath.data(), rootPath.size());
+        if (!records.empty())
+            std::memcpy(data + header.chunksOffset, records.data(), records.size() * sizeof(ChunkRecord));
+
+        auto* directoryRecords = reinterpret_cast<DirectoryRecord*>(data + header.directoriesOffset);
+        std::uint64_t nameOffset = 0;
+        for (std::size_t d = 0; d < directories.size(); ++d) {
+            const IndexedDirectory& directory = directories[d];
+            const DirectoryStamp& stamp = directory.stamp;
+            directoryRecords[d] = DirectoryRecord { nameOffset, directory.path.size(), stamp.mtimeSec, stamp.ctimeSec,
+                                                    stamp.mtimeNsec, stamp.ctimeNsec, directory.firstPath,
+                                                    directory.entryCount };
+            std::memcpy(data + header.namesOffset + nameOffset, directory.path.data(), directory.path.size());
+            nameOffset += directory.path.size();
+        }
+
+        for (std::size_t c = 0; c < chunks.size(); ++c) {
+            const PathChunk& chunk = *chunks[c];
+            const ChunkRecord& record = records[c];
+            std::memcpy(data + record.masks, chunk.masks, chunk.size() * sizeof(std::uint64_t));
+            std::memcpy(data + record.offsets, chunk.offsets, chunk.size() * sizeof(std::uint32_t));
+            std::memcpy(data + record.lengths, chunk.lengths, chunk.size() * sizeof(std::uint16_t));
+            std::memcpy(data + record.nameStarts, chunk.nameStarts, chunk.size() * sizeof(std::uint16_t));
+            std::memcpy(data + record.directories, chunk.directories, chunk.size());
+            std::memcpy(data + record.bytes, chunk.bytes, chunk.byteCount);
+        }
+        ::munmap(mapping, header.fileSize);
+
+        if (::rename(temporary.c_str(), path.c_str()) != 0) {
+            ::unlink(temporary.c_str());
+            return false;
+        }
+        return true;
+    }
+
+} // namespace core
@@ -0,0 +1,193 @@
+/**
+ * @file Prefetcher.cpp
+ * @brief Implementation of the core::Prefetcher class
+ * @date 2025-06-16
+ */
+
+#include "core/Prefetcher.hpp"
+#include "core/DirectoryScanner.hpp"
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace core {
+
+    Prefetcher::Prefetcher(DirectoryWatcher& watcher, EventNotifier* notifier,
+                           std::chrono::milliseconds settleDelay, std::chrono::milliseconds minInterval)
+        : _watcher(watcher), _notifier(notifier), _settleDelay(settleDelay), _minInterval(minInterval),
+          _kind(Kind::NONE), _generation(0), _stopping(false)
+    {
+        _thread = std::thread(&Prefetcher::run, this);
+    }
+
+    Prefetcher::~Prefetcher()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+            ++_generation;
+        }
+        _cv.notify_all();
+        _thread.join();
+    }
+
+    void Prefetcher::prefetchDirectory(const std::string& path)
+    {
+        request(Kind::DIRECTORY, path);
+    }
+
+    void Prefetcher::prefetchFile(const std::string& path)
+    {
+        request(Kind::FILE, path);
+    }
+
+    /**
+     * @brief Drops the pending request and cancels the scan in flight, if any.
+     */
+    void Prefetcher::cancel()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_target.empty())
+            return;
+        _kind = Kind::NONE;
+        _target.clear();
+        ++_generation;
+    }
+
+    /**
+     * @brief Takes the listings finished since the last call.
+     */
+    std::vector<PrefetchResult> Prefetcher::collect()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<PrefetchResult> results;
+
+        results.swap(_results);
+        return results;
+    }
+
+    /**
+     * @brief Replaces the current request. Asking again for the target already pending or
+     * being worked on is a no-op, so this can be called on every frame.
+     */
+    void Prefetcher::request(Kind kind, const std::string& path)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (path == _target)
+                return;
+            _kind = kind;
+            _target = path;
+            ++_generation;
+        }
+        _cv.notify_all();
+    }
+
+    bool Prefetcher::stale(std::uint64_t generation) const noexcept
+    {
+        return _generation.load(std::memory_order_relaxed) != generation;
+    }
+
+    void Prefetcher::run()
+    {
+        auto lastScan = std::chrono::steady_clock::time_point();
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        // On Linux this only lowers the calling thread, not the whole process
+        ::setpriority(PRIO_PROCESS, 0, 19);
+
+        for (;;) {
+            _cv.wait(lock, [this] { return _stopping || _kind != Kind::NONE; });
+            if (_stopping)
+                return;
+
+            std::uint64_t generation = _generation;
+            auto changed = [this, generation] { return _stopping || stale(generation); };
+            if (_cv.wait_for(lock, _settleDelay, changed))
+                continue;
+            if (_cv.wait_until(lock, lastScan + _minInterval, changed))
+                continue;
+
+            Kind kind = _kind;
+            std::string target = _target;
+            _kind = Kind::NONE;
+            lock.unlock();
+
+            if (kind == Kind::DIRECTORY)
+                scanDirectory(target, generation);
+            else
+                readAhead(target);
+            lastScan = std::chrono::steady_clock::now();
+            lock.lock();
+        }
+    }
+
+    /**
+     * @brief Scans a directory into a listing ready for the cache.
+     * The watch is placed and the stamp taken before reading, so any change made during the
+     * scan makes the listing stale rather than silently wrong.
+     */
+    void Prefetcher::scanDirectory(const std::string& path, std::uint64_t generation)
+    {
+        PrefetchResult result;
+
+        result.path = path;
+        result.listing.wd = _watcher.watch(path);
+        auto stamp = DirectoryStamp::of(path);
+        DirectoryScanner scanner(path);
+
+        bool complete = result.listing.wd >= 0 && stamp && scanner.isOpen();
+        if (complete) {
+            EntryTable& entries = result.listing.entries;
+            scanner.scan([&](std::string_view name, EntryType type) {
+                if (stale(generation) || entries.size() >= MAX_ENTRIES) {
+                    complete = false;
+                    return false;
+                }
+                EntryDetails details = DirectoryScanner::inspect(scanner.fd(), name.data(), type);
+                EntryTable::Index i = entries.append(name, details.type);
+                entries.setDetails(i, details);
+                return true;
+            });
+            complete = complete && !stale(generation);
+        }
+        if (complete) {
+            result.listing.entries.shrinkToFit();
+            result.listing.order.resize(result.listing.entries.size());
+            for (EntryTable::Index i = 0; i < result.listing.order.size(); ++i)
+                result.listing.order[i] = i;
+            result.listing.stamp = *stamp;
+        } else {
+            result.listing.entries.clear();
+        }
+        result.complete = complete;
+        if (result.listing.wd < 0)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _results.push_back(std::move(result));
+        }
+        if (_notifier)
+            _notifier->notify();
+    }
+
+    /**
+     * @brief Asks the kernel to start reading a small file into the page cache.
+     */
+    void Prefetcher::readAhead(const std::string& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+        struct stat st;
+
+        if (fd < 0)
+            return;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && static_cast<std::uint64_t>(st.st_size) <= SMALL_FILE_LIMIT)
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        ::close(fd);
+    }
+
+} // namespace core
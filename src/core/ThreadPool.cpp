@@ -0,0 +1,198 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implementation of the core::ThreadPool class
+ * @date 2025-06-22
+ */
+
+#include "core/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace core {
+
+    namespace {
+
+        // The pool the calling thread works for, if any, and its place in it
+        thread_local ThreadPool* currentPool = nullptr;
+        thread_local std::size_t currentIndex = 0;
+
+    } // namespace
+
+    /**
+     * @param threads Number of workers; 0 means one per core.
+     */
+    ThreadPool::ThreadPool(std::size_t threads) : _queued(0), _shared(0), _sleeping(0), _stopping(false)
+    {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t t = 0; t < threads; ++t)
+            _deques.push_back(std::make_unique<Deque>());
+        for (std::size_t t = 0; t < threads; ++t)
+            _workers.emplace_back(&ThreadPool::work, this, t);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+            _tasks.clear();
+        }
+        _ready.notify_all();
+        for (auto& worker : _workers)
+            worker.join();
+    }
+
+    /**
+     * @brief The pool background jobs share, created on first use.
+     */
+    ThreadPool& ThreadPool::shared()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    void ThreadPool::submit(std::function<void()> task)
+    {
+        if (currentPool == this) {
+            Deque& own = *_deques[currentIndex];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            own.tasks.push_back(std::move(task));
+        } else {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push_back(std::move(task));
+            _shared.fetch_add(1);
+        }
+        _queued.fetch_add(1);
+        wake();
+    }
+
+    /**
+     * @brief Wakes a sleeping worker, if any, for a task just queued.
+     * A worker counts itself asleep before it looks at _queued for the last time, and the task
+     * is counted before _sleeping is looked at here: one of the two sees the other.
+     */
+    void ThreadPool::wake()
+    {
+        if (_sleeping.load() == 0)
+            return;
+        {
+            // Taken so that the notification cannot fall between a worker's last look and its wait
+            std::lock_guard<std::mutex> lock(_mutex);
+        }
+        _ready.notify_one();
+    }
+
+    /**
+     * @brief Runs body(0) .. body(count - 1) and returns once all of them have.
+     * The calling thread takes part, so the loop completes even if every worker is busy.
+     */
+    void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body)
+    {
+        struct Loop {
+            std::function<void(std::size_t)> body;
+            std::size_t count;
+            std::atomic<std::size_t> next { 0 };
+            std::atomic<std::size_t> done { 0 };
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+
+        if (count == 0)
+            return;
+        if (count == 1 || _workers.size() < 2) {
+            for (std::size_t i = 0; i < count; ++i)
+                body(i);
+            return;
+        }
+
+        // Helpers that start after the loop is over find nothing left and only drop their reference
+        auto loop = std::make_shared<Loop>();
+        loop->body = body;
+        loop->count = count;
+        auto run = [loop] {
+            for (std::size_t i; (i = loop->next.fetch_add(1)) < loop->count;) {
+                loop->body(i);
+                if (loop->done.fetch_add(1) + 1 == loop->count) {
+                    std::lock_guard<std::mutex> lock(loop->mutex);
+                    loop->finished.notify_all();
+                }
+            }
+        };
+
+        std::size_t helpers = std::min(_workers.size(), count - 1);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (std::size_t h = 0; h < helpers; ++h)
+                _tasks.push_front(run);
+            _shared.fetch_add(helpers);
+        }
+        _queued.fetch_add(helpers);
+        _ready.notify_all();
+
+        run();
+        std::unique_lock<std::mutex> lock(loop->mutex);
+        loop->finished.wait(lock, [&] { return loop->done.load() == count; });
+    }
+
+    /**
+     * @brief Takes a task for a worker: from the shared queue first, then from the back of its
+     * own deque, then from the front of another's.
+     */
+    bool ThreadPool::take(std::size_t index, std::function<void()>& task)
+    {
+        if (_shared.load() > 0) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_tasks.empty()) {
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+                _shared.fetch_sub(1);
+                _queued.fetch_sub(1);
+                return true;
+            }
+        }
+
+        {
+            Deque& own = *_deques[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                _queued.fetch_sub(1);
+                return true;
+            }
+        }
+
+        for (std::size_t k = 1; k < _deques.size(); ++k) {
+            Deque& other = *_deques[(index + k) % _deques.size()];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            if (!other.tasks.empty()) {
+                task = std::move(other.tasks.front());
+                other.tasks.pop_front();
+                _queued.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::work(std::size_t index)
+    {
+        currentPool = this;
+        currentIndex = index;
+
+        while (!_stopping.load()) {
+            std::function<void()> task;
+            if (take(index, task)) {
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _sleeping.fetch_add(1);
+            _ready.wait(lock, [this] { return _stopping.load() || _queued.load() > 0; });
+            _sleeping.fetch_sub(1);
+        }
+    }
+
+} // namespace core
@@ -0,0 +1,59 @@
+/**
+ * @file UsageCache.cpp
+ * @brief Implementation of the core::UsageCache class
+ * @date 2025-06-26
+ */
+
+#include "core/UsageCache.hpp"
+
+#include <climits>
+#include <cstdlib>
+
+namespace core {
+
+    void UsageCache::store(const std::string& key, const UsageTotals& totals)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (auto it = _entries.find(key); it != _entries.end())
+            it->second = totals;
+        else if (_entries.size() < ENTRY_LIMIT)
+            _entries.emplace(key, totals);
+    }
+
+    std::optional<UsageTotals> UsageCache::find(const std::string& key) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _entries.find(key);
+        if (it == _entries.end())
+            return std::nullopt;
+        return it->second;
+    }
+
+    std::size_t UsageCache::size() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.size();
+    }
+
+    void UsageCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.clear();
+    }
+
+    /**
+     * @brief The key a directory is stored under: its canonical path, so that "./a" and
+     * the absolute path of a are the same directory.
+     */
+    std::string UsageCache::keyOf(const std::string& path)
+    {
+        char resolved[PATH_MAX];
+
+        if (::realpath(path.c_str(), resolved) == nullptr)
+            return path;
+        return resolved;
+    }
+
+} // namespace core
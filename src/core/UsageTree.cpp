@@ -0,0 +1,369 @@
+/**
+ * @file UsageTree.cpp
+ * @brief Implementation of the core::UsageTree class
+ * @date 2025-06-27
+ */
+
+#include "core/UsageTree.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace core {
+
+    namespace {
+
+        constexpr char MAGIC[8] = { 'F', 'M', 'A', 'N', 'D', 'U', '\0', '\0' };
+        // Reads back differently on a machine of the other byte order
+        constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byteOrder;
+            std::uint64_t entryCount;
+            std::uint64_t namesSize;
+            std::uint64_t rootLength;
+        };
+
+        // bytes, allocated, items, childCount, nameLength, flags: packed, with no padding
+        constexpr std::size_t RECORD_SIZE = 8 + 8 + 4 + 4 + 2 + 2;
+
+        template <typename T>
+        void put(char*& out, T value) noexcept
+        {
+            std::memcpy(out, &value, sizeof(value));
+            out += sizeof(value);
+        }
+
+        template <typename T>
+        T take(const char*& in) noexcept
+        {
+            T value;
+            std::memcpy(&value, in, sizeof(value));
+            in += sizeof(value);
+            return value;
+        }
+
+        std::uint32_t itemCount(const UsageTotals& totals) noexcept
+        {
+            return static_cast<std::uint32_t>(std::min<std::uint64_t>(totals.files + totals.directories, UINT32_MAX));
+        }
+
+        bool writeAll(int fd, const char* data, std::size_t size) noexcept
+        {
+            while (size > 0) {
+                ssize_t n = ::write(fd, data, size);
+                if (n <= 0)
+                    return false;
+                data += n;
+                size -= static_cast<std::size_t>(n);
+            }
+            return true;
+        }
+
+        bool readAll(const std::string& path, std::string& contents)
+        {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            struct stat st;
+
+            if (fd < 0)
+                return false;
+            if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+                ::close(fd);
+                return false;
+            }
+            contents.resize(static_cast<std::size_t>(st.st_size));
+            std::size_t done = 0;
+            while (done < contents.size()) {
+                ssize_t n = ::read(fd, contents.data() + done, contents.size() - done);
+                if (n <= 0)
+                    break;
+                done += static_cast<std::size_t>(n);
+            }
+            ::close(fd);
+            return done == contents.size();
+        }
+
+    } // namespace
+
+    /**
+     * @brief Lays out the tree of a finished walk that kept its files. Each directory's children
+     * are stored largest first.
+     * @param usage The walk; it must be finished and not cancelled.
+     */
+    UsageTree::UsageTree(const DiskUsage& usage)
+        : _root(usage.root())
+    {
+        struct Child {
+            std::uint64_t bytes;
+            const UsageNode* directory;
+            const UsageFile* file;
+        };
+
+        const UsageNode& top = usage.tree();
+        _entries.push_back(Entry { top.total.bytes, top.total.allocated, itemCount(top.total), npos, 0, 0, 0, 0,
+                                   static_cast<std::uint16_t>(DIRECTORY | (top.unreadable ? UNREADABLE : 0)) });
+
+        std::vector<std::pair<Index, const UsageNode*>> queue { { ROOT, &top } };
+        std::vector<Child> children;
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            auto [index, node] = queue[head];
+
+            children.clear();
+            for (const auto& directory : node->children)
+                children.push_back(Child { directory->total.bytes, directory.get(), nullptr });
+            for (const auto& file : node->files)
+                children.push_back(Child { file.bytes, nullptr, &file });
+            std::stable_sort(children.begin(), children.end(),
+                             [](const Child& a, const Child& b) { return a.bytes > b.bytes; });
+
+            _entries[index].firstChild = static_cast<Index>(_entries.size());
+            _entries[index].childCount = static_cast<std::uint32_t>(children.size());
+            for (const Child& child : children) {
+                Entry entry {};
+                std::string_view name;
+                entry.parent = index;
+                if (child.directory) {
+                    const UsageNode& directory = *child.directory;
+                    name = directory.name;
+                    entry.bytes = directory.total.bytes;
+                    entry.allocated = directory.total.allocated;
+                    entry.items = itemCount(directory.total);
+                    entry.flags = DIRECTORY | (directory.unreadable ? UNREADABLE : 0);
+                    queue.emplace_back(static_cast<Index>(_entries.size()), &directory);
+                } else {
+                    const UsageFile& file = *child.file;
+                    name = std::string_view(node->fileNames).substr(file.nameOffset, file.nameLength);
+                    entry.bytes = file.bytes;
+                    entry.allocated = file.allocated;
+                    entry.flags = file.duplicate ? DUPLICATE : 0;
+                }
+                entry.nameOffset = static_cast<std::uint32_t>(_names.size());
+                entry.nameLength = static_cast<std::uint16_t>(name.size());
+                _names.append(name);
+                _entries.push_back(entry);
+            }
+        }
+    }
+
+    std::string_view UsageTree::name(Index index) const noexcept
+    {
+        const Entry& entry = _entries[index];
+        return std::string_view(_names).substr(entry.nameOffset, entry.nameLength);
+    }
+
+    /**
+     * @brief The path of an entry, under the root the tree was taken of.
+     */
+    std::string UsageTree::path(Index index) const
+    {
+        std::vector<Index> chain;
+        for (; index != ROOT; index = _entries[index].parent)
+            chain.push_back(index);
+
+        std::string path = _root;
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            if (path.empty() || path.back() != '/')
+                path += '/';
+            path += name(*it);
+        }
+        return path;
+    }
+
+    /**
+     * @brief The children of a directory still there, largest first, then by name.
+     */
+    std::vector<UsageTree::Index> UsageTree::children(Index directory) const
+    {
+        const Entry& parent = _entries[directory];
+        std::vector<Index> children;
+
+        children.reserve(parent.childCount);
+        for (Index i = parent.firstChild; i < parent.firstChild + parent.childCount; ++i)
+            if (!(_entries[i].flags & REMOVED))
+                children.push_back(i);
+        std::sort(children.begin(), children.end(), [this](Index a, Index b) {
+            if (_entries[a].bytes != _entries[b].bytes)
+                return _entries[a].bytes > _entries[b].bytes;
+            return name(a) < name(b);
+        });
+        return children;
+    }
+
+    std::size_t UsageTree::memoryUsage() const noexcept
+    {
+        return _entries.capacity() * sizeof(Entry) + _names.capacity() + _root.capacity();
+    }
+
+    /**
+     * @brief Drops an entry and its subtree, and takes their size off every ancestor.
+     */
+    void UsageTree::remove(Index index)
+    {
+        Entry& entry = _entries[index];
+
+        if (index == ROOT || (entry.flags & REMOVED))
+            return;
+        entry.flags |= REMOVED;
+        // Unsigned arithmetic wraps: adding the negation subtracts
+        addToAncestors(index, 0 - entry.bytes, 0 - entry.allocated, 0 - (entry.items + 1));
+    }
+
+    /**
+     * @brief Replaces the subtree of a directory with a fresh walk of it.
+     * @param directory The directory walked again.
+     * @param scan The tree of the walk, rooted at that directory.
+     */
+    void UsageTree::graft(Index directory, const UsageTree& scan)
+    {
+        const Entry& top = scan._entries[ROOT];
+        Index offset = static_cast<Index>(_entries.size() - 1);
+        auto nameBase = static_cast<std::uint32_t>(_names.size());
+
+        _names += scan._names;
+        _entries.reserve(_entries.size() + scan._entries.size() - 1);
+        for (std::size_t i = 1; i < scan._entries.size(); ++i) {
+            Entry entry = scan._entries[i];
+            entry.parent = entry.parent == ROOT ? directory : entry.parent + offset;
+            entry.firstChild += offset;
+            entry.nameOffset += nameBase;
+            _entries.push_back(entry);
+        }
+
+        Entry& target = _entries[directory];
+        std::uint64_t bytes = top.bytes - target.bytes;
+        std::uint64_t allocated = top.allocated - target.allocated;
+        std::uint32_t items = top.items - target.items;
+        target.bytes = top.bytes;
+        target.allocated = top.allocated;
+        target.items = top.items;
+        target.firstChild = top.firstChild + offset;
+        target.childCount = top.childCount;
+        target.flags = static_cast<std::uint16_t>(DIRECTORY | (top.flags & UNREADABLE));
+        addToAncestors(directory, bytes, allocated, items);
+    }
+
+    void UsageTree::addToAncestors(Index index, std::uint64_t bytes, std::uint64_t allocated, std::uint32_t items)
+    {
+        for (Index parent = _entries[index].parent; parent != npos; parent = _entries[parent].parent) {
+            _entries[parent].bytes += bytes;
+            _entries[parent].allocated += allocated;
+            _entries[parent].items += items;
+        }
+    }
+
+    /**
+     * @brief Writes what is reachable of the tree to a file, replacing it if it exists.
+     * @return False if the file could not be written.
+     */
+    bool UsageTree::save(const std::string& path) const
+    {
+        std::string records;
+        std::string names;
+        std::vector<Index> queue { ROOT };
+
+        records.reserve(_entries.size() * RECORD_SIZE);
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            Index index = queue[head];
+            const Entry& entry = _entries[index];
+            std::vector<Index> children = isDirectory(index) ? this->children(index) : std::vector<Index>();
+
+            char record[RECORD_SIZE];
+            char* out = record;
+            put(out, entry.bytes);
+            put(out, entry.allocated);
+            put(out, entry.items);
+            put(out, static_cast<std::uint32_t>(children.size()));
+            put(out, entry.nameLength);
+            put(out, static_cast<std::uint16_t>(entry.flags & ~REMOVED));
+            records.append(record, RECORD_SIZE);
+            names.append(name(index));
+            queue.insert(queue.end(), children.begin(), children.end());
+        }
+
+        Header header {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = FORMAT_VERSION;
+        header.byteOrder = BYTE_ORDER_MARK;
+        header.entryCount = queue.size();
+        header.namesSize = names.size();
+        header.rootLength = _root.size();
+
+        std::string temporary = path + ".tmp." + std::to_string(::getpid());
+        int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+            return false;
+        bool written = writeAll(fd, reinterpret_cast<const char*>(&header), sizeof(header))
+            && writeAll(fd, _root.data(), _root.size())
+            && writeAll(fd, records.data(), records.size())
+            && writeAll(fd, names.data(), names.size());
+        if (::close(fd) != 0 || !written || ::rename(temporary.c_str(), path.c_str()) != 0) {
+            ::unlink(temporary.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reads a tree saved by save().
+     * @return The tree, or nullptr if the file cannot be read or is not a valid tree.
+     */
+    std::unique_ptr<UsageTree> UsageTree::load(const std::string& path)
+    {
+        std::string contents;
+        Header header;
+
+        if (!readAll(path, contents) || contents.size() < sizeof(Header))
+            return nullptr;
+        std::memcpy(&header, contents.data(), sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != FORMAT_VERSION
+            || header.byteOrder != BYTE_ORDER_MARK || header.entryCount == 0 || header.entryCount >= npos
+            || header.namesSize > UINT32_MAX)
+            return nullptr;
+        std::uint64_t available = contents.size() - sizeof(Header);
+        if (header.rootLength > available || header.namesSize > available - header.rootLength
+            || header.entryCount > (available - header.rootLength - header.namesSize) / RECORD_SIZE
+            || header.entryCount * RECORD_SIZE != available - header.rootLength - header.namesSize)
+            return nullptr;
+
+        std::unique_ptr<UsageTree> tree(new UsageTree());
+        const char* in = contents.data() + sizeof(Header);
+        tree->_root.assign(in, header.rootLength);
+        in += header.rootLength;
+        tree->_names.assign(in + header.entryCount * RECORD_SIZE, header.namesSize);
+        tree->_entries.resize(header.entryCount);
+
+        // Breadth first, the children of each entry follow those of the entries before it
+        std::uint64_t nextChild = 1;
+        std::uint64_t nameOffset = 0;
+        tree->_entries[ROOT].parent = npos;
+        for (std::size_t i = 0; i < tree->_entries.size(); ++i) {
+            Entry& entry = tree->_entries[i];
+            entry.bytes = take<std::uint64_t>(in);
+            entry.allocated = take<std::uint64_t>(in);
+            entry.items = take<std::uint32_t>(in);
+            entry.childCount = take<std::uint32_t>(in);
+            entry.nameLength = take<std::uint16_t>(in);
+            entry.flags = take<std::uint16_t>(in);
+            entry.firstChild = static_cast<Index>(nextChild);
+            entry.nameOffset = static_cast<std::uint32_t>(nameOffset);
+            nameOffset += entry.nameLength;
+            nextChild += entry.childCount;
+            if (nextChild > header.entryCount || (entry.childCount > 0 && !(entry.flags & DIRECTORY))
+                || (entry.flags & REMOVED) || nameOffset > header.namesSize)
+                return nullptr;
+            for (Index child = entry.firstChild; child < nextChild; ++child)
+                tree->_entries[child].parent = static_cast<Index>(i);
+        }
+        if (nextChild != header.entryCount || nameOffset != header.namesSize
+            || !(tree->_entries[ROOT].flags & DIRECTORY))
+            return nullptr;
+        return tree;
+    }
+
+} // namespace core
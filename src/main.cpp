@@ -5,12 +5,40 @@
  * @date 2025-05-06
  */
 
-#include "core/Directory.hpp"
 #include "ui/NcursesApp.hpp"
+#include "core/DiskUsage.hpp"
+#include "core/UsageTree.hpp"
 
-int main()
+#include <cstdio>
+#include <string_view>
+
+/**
+ * @brief Sizes a directory and saves its tree for the disk usage view, without starting the interface,
+ * so that a scan can be taken on a host and looked at elsewhere.
+ * @param root The directory to size.
+ * @param path The file to write.
+ * @return The exit status.
+ */
+static int exportUsage(const char* root, const char* path)
 {
-    core::Directory dir(".");
+    core::DiskUsage usage(root, nullptr, nullptr, true);
+
+    usage.wait();
+    core::UsageTree tree(usage);
+    if (!tree.save(path)) {
+        std::fprintf(stderr, "fman: cannot write %s\n", path);
+        return 1;
+    }
+    if (usage.errors() > 0)
+        std::fprintf(stderr, "fman: %zu entries could not be read\n", usage.errors());
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc == 4 && std::string_view(argv[1]) == "--export-usage")
+        return exportUsage(argv[2], argv[3]);
+
     ui::NcursesApp app;
 
     app.run();
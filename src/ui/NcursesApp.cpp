@@ -6,8 +6,14 @@
  */
 
 #include "ui/NcursesApp.hpp"
+#include <cerrno>
+#include <csignal>
 #include <mutex>
 
+#include <poll.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+
 namespace ui {
 
 #include <mutex>
@@ -16,9 +22,19 @@ namespace ui {
      * @brief Constructor for the NcursesApp class.
      * Initializes the ncurses library and creates the main window.
      */
-    NcursesApp::NcursesApp() : _manager(_wrapper), _running(true) {
+    NcursesApp::NcursesApp() : _manager(_wrapper), _jobs(&_notifier), _resizeFd(-1), _currentView(nullptr), _running(true) {
         _wrapper.init();
+
+        // SIGWINCH is read from a signalfd instead of a handler. Blocking it here, before any
+        // worker thread exists, makes every thread inherit the mask.
+        sigset_t mask;
+        sigemptyset(&mask);
+        sigaddset(&mask, SIGWINCH);
+        pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+        _resizeFd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+
         initLayout();
+        _statusBar = std::make_unique<StatusBarView>(_manager, _jobs);
         switchView(ViewType::MAIN_MENU);
     }
 
@@ -27,6 +43,8 @@ namespace ui {
      * Cleans up the ncurses library and any allocated resources.
      */
     NcursesApp::~NcursesApp() {
+        if (_resizeFd >= 0)
+            close(_resizeFd);
         _wrapper.end();
     }
 
@@ -41,45 +59,118 @@ namespace ui {
         int explorerWidth = maxX - sidebarWidth;
         int explorerHeight = maxY - infoHeight - statusHeight;
 
-        _manager.createAndRegisterWindow(WindowRole::SIDEBAR, explorerHeight, sidebarWidth, 0, 0);
-        _manager.createAndRegisterWindow(WindowRole::EXPLORER, explorerHeight, explorerWidth, 0, sidebarWidth);
-        _manager.createAndRegisterWindow(WindowRole::INFO, infoHeight, maxX / 2, explorerHeight, 0);
-        _manager.createAndRegisterWindow(WindowRole::STATUS, statusHeight, maxX / 2, explorerHeight + infoHeight, maxX / 2);
+        _manager.placeWindow(WindowRole::SIDEBAR, explorerHeight, sidebarWidth, 0, 0);
+        _manager.placeWindow(WindowRole::EXPLORER, explorerHeight, explorerWidth, 0, sidebarWidth);
+        _manager.placeWindow(WindowRole::INFO, infoHeight, maxX / 2, explorerHeight, 0);
+        _manager.placeWindow(WindowRole::STATUS, statusHeight, maxX / 2, explorerHeight + infoHeight, maxX / 2);
     }
 
     /**
      * @brief Runs the main application loop.
-     * Continuously updates the UI and handles user input until the application is terminated.
+     * Draws a frame, then sleeps until something happens, until the application is terminated.
+     * Nothing runs while idle: there is no timeout.
      */
     void NcursesApp::run() {
         while (_running) {
             update();
+            _manager.refreshAll();
+            waitForEvents();
             handleUserInput();
         }
     }
 
+    /**
+     * @brief Blocks until a key, a resize, a worker notification or a view descriptor is ready.
+     */
+    void NcursesApp::waitForEvents() {
+        std::vector<pollfd> fds = {
+            { STDIN_FILENO, POLLIN, 0 },
+            { _notifier.fd(), POLLIN, 0 },
+            { _resizeFd, POLLIN, 0 },
+        };
+        std::vector<int> viewFds;
+
+        if (_currentView)
+            _currentView->pollFds(viewFds);
+        for (int fd : viewFds)
+            fds.push_back({ fd, POLLIN, 0 });
+
+        while (poll(fds.data(), fds.size(), -1) < 0 && errno == EINTR)
+            ;
+        if (fds[1].revents & POLLIN)
+            _notifier.drain();
+        if (fds[2].revents & POLLIN)
+            handleResize();
+    }
+
+    /**
+     * @brief Lays the windows out again for the new terminal size.
+     */
+    void NcursesApp::handleResize() {
+        signalfd_siginfo info;
+
+        while (read(_resizeFd, &info, sizeof(info)) == static_cast<ssize_t>(sizeof(info)))
+            ;
+        _wrapper.resize();
+        initLayout();
+    }
+
     /**
      * @brief Switches the current view to the specified view type.
+     * The menu and explorer views are built once and kept, so switching back to the
+     * explorer keeps its directory, listing and cursor. The file information view, the
+     * finder, the content search, the disk usage view and the report are rebuilt, since they
+     * show a different file or tree each time.
      * @param type The type of view to switch to.
      */
     void NcursesApp::switchView(ViewType type) {
         auto switchViewCallback = [this](ViewType next) {
             this->switchView(next);
         };
+        // The finder, the content search and the report look under the explorer's directory and bring it to what is picked
+        auto jumpCallback = [this](const std::string& path) {
+            this->switchView(ViewType::EXPLORER);
+            _explorerView->jumpTo(path);
+        };
+        std::string searchRoot = _explorerView ? _explorerView->currentPath() : ".";
 
         switch (type) {
             case ViewType::MAIN_MENU:
-                _currentView = std::make_unique<SidebarView>(_manager, switchViewCallback);
+                if (!_menuView)
+                    _menuView = std::make_unique<SidebarView>(_manager, switchViewCallback);
+                _currentView = _menuView.get();
                 break;
             case ViewType::EXPLORER:
-                _currentView = std::make_unique<ExplorerView>(_manager, *this, switchViewCallback);
+                if (!_explorerView)
+                    _explorerView = std::make_unique<ExplorerView>(_manager, *this, switchViewCallback);
+                _currentView = _explorerView.get();
                 break;
             case ViewType::FILE_INFO:
                 if (!_selectedFile) {
-                    _currentView = std::make_unique<SidebarView>(_manager, switchViewCallback);
+                    switchView(ViewType::MAIN_MENU);
                     return;
                 }
-                _currentView = std::make_unique<FileInfoView>(_manager, *_selectedFile, switchViewCallback);
+                _fileInfoView = std::make_unique<FileInfoView>(_manager, *_selectedFile, _usageCache, &_notifier,
+                                                               switchViewCallback);
+                _currentView = _fileInfoView.get();
+                break;
+            case ViewType::FINDER:
+                _finderView = std::make_unique<FinderView>(_manager, searchRoot, &_notifier, jumpCallback, switchViewCallback);
+                _currentView = _finderView.get();
+                break;
+            case ViewType::GREP:
+                _grepView = std::make_unique<GrepView>(_manager, searchRoot, &_notifier, jumpCallback, switchViewCallback);
+                _currentView = _grepView.get();
+                break;
+            case ViewType::USAGE:
+                _usageView = std::make_unique<UsageView>(_manager, searchRoot, _usageCache, &_notifier,
+                                                         switchViewCallback);
+                _currentView = _usageView.get();
+                break;
+            case ViewType::REPORT:
+                _reportView = std::make_unique<ReportView>(_manager, searchRoot, &_notifier, jumpCallback,
+                                                           switchViewCallback);
+                _currentView = _reportView.get();
                 break;
             case ViewType::QUIT:
                 _running = false;
@@ -88,21 +179,28 @@ namespace ui {
     }
 
     /**
-     * @brief Handles user input and passes it to the current view.
+     * @brief Passes every pending key to the current view, so a burst of keys costs one frame.
      */
     void NcursesApp::handleUserInput() {
-        int ch = _wrapper.getChar();
-        if (_currentView)
-            _currentView->handleInput(ch);
+        int ch;
+
+        while (_running && (ch = _wrapper.getChar()) != ERR) {
+            if (ch == KEY_RESIZE)
+                continue;
+            if (_currentView)
+                _currentView->handleInput(ch);
+        }
     }
 
     /**
      * @brief Updates the current view.
-     * Calls the update method of the current view to refresh the UI.
+     * Calls the update method of the current view, which describes its next frame, then the
+     * status bar's.
      */
     void NcursesApp::update() {
         if (_currentView)
             _currentView->update();
+        _statusBar->update();
     }
 
     /**
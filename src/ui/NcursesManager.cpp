@@ -31,13 +31,29 @@ namespace ui {
             _wrapper.clearWindow(_windows[winIndex]);
     }
 
+    /**
+     * @brief Presents the frame of every canvas, then updates the terminal once for all windows.
+     */
     void NcursesManager::refreshAll() {
+        for (auto& [role, canvas] : _canvases)
+            canvas.present();
         for (auto win : _windows)
-            _wrapper.refreshWindow(win);
+            _wrapper.stageWindow(win);
+        _wrapper.updateScreen();
+    }
+
+    /**
+     * @brief Marks every window as changed, so the next refresh repaints what a popup covered.
+     */
+    void NcursesManager::touchAll() {
+        for (auto win : _windows)
+            if (win)
+                touchwin(win);
     }
 
     void NcursesManager::registerWindow(WindowRole role, WINDOW* window) {
         _roleMap[role] = window;
+        _canvases.insert_or_assign(role, WindowCanvas(window));
     }
 
     WINDOW* NcursesManager::getWindow(WindowRole role) {
@@ -45,6 +61,27 @@ namespace ui {
         return (it != _roleMap.end()) ? it->second : nullptr;
     }
     
+    /**
+     * @brief Returns the canvas of a registered window.
+     */
+    WindowCanvas& NcursesManager::getCanvas(WindowRole role) {
+        return _canvases.at(role);
+    }
+
+    /**
+     * @brief Creates the window for a role, or moves and resizes it if it already exists.
+     */
+    WINDOW* NcursesManager::placeWindow(WindowRole role, int height, int width, int startY, int startX) {
+        WINDOW* window = getWindow(role);
+
+        if (!window)
+            return createAndRegisterWindow(role, height, width, startY, startX);
+        wresize(window, height, width);
+        mvwin(window, startY, startX);
+        _canvases.at(role).invalidate();
+        return window;
+    }
+
     WINDOW* NcursesManager::createAndRegisterWindow(WindowRole role, int height, int width, int startY, int startX) {
         WINDOW* window = _wrapper.createWindow(height, width, startY, startX);
         registerWindow(role, window);
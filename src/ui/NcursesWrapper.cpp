@@ -7,6 +7,9 @@
 
 #include "ui/NcursesWrapper.hpp"
 
+#include <sys/ioctl.h>
+#include <unistd.h>
+
 namespace ui {
 
     NcursesWrapper::NcursesWrapper() {}
@@ -21,7 +24,10 @@ namespace ui {
         noecho();
         keypad(stdscr, TRUE);
         curs_set(0);
-        halfdelay(10);
+        // getChar() never blocks: the main loop polls stdin and only reads once a key is there
+        nodelay(stdscr, TRUE);
+        // Escape closes prompts; do not wait a whole second to tell it from an escape sequence
+        set_escdelay(25);
         start_color();
         use_default_colors();
         
@@ -30,6 +36,8 @@ namespace ui {
         init_pair(3, COLOR_GREEN, -1);
         init_pair(4, COLOR_CYAN, -1);
         init_pair(5, COLOR_YELLOW, -1);
+        init_pair(6, COLOR_MAGENTA, -1);
+        init_pair(7, COLOR_RED, -1);
         
         refresh();
     }
@@ -54,14 +62,25 @@ namespace ui {
         return newwin(height, width, startY, startX);
     }
 
+    /**
+     * @brief Deletes a window and blanks the area it covered on the next screen update,
+     * so a closed popup does not linger where no other window repaints.
+     */
     void NcursesWrapper::destroyWindow(WINDOW* window) {
-        if (window)
-            delwin(window);
+        if (!window)
+            return;
+        werase(window);
+        wnoutrefresh(window);
+        delwin(window);
     }
 
+    /**
+     * @brief Blanks a window. Uses werase rather than wclear, which would force the
+     * whole terminal to be repainted on the next refresh.
+     */
     void NcursesWrapper::clearWindow(WINDOW* window) {
         if (window)
-            wclear(window);
+            werase(window);
     }
 
     void NcursesWrapper::refreshWindow(WINDOW* window) {
@@ -69,6 +88,21 @@ namespace ui {
             wrefresh(window);
     }
 
+    /**
+     * @brief Copies a window to the virtual screen without sending anything to the terminal.
+     */
+    void NcursesWrapper::stageWindow(WINDOW* window) {
+        if (window)
+            wnoutrefresh(window);
+    }
+
+    /**
+     * @brief Sends the virtual screen to the terminal, once for all staged windows.
+     */
+    void NcursesWrapper::updateScreen() {
+        doupdate();
+    }
+
     void NcursesWrapper::drawTextInWindow(WINDOW* window, int y, int x, const std::string& text) {
         if (window)
             mvwprintw(window, y, x, "%s", text.c_str());
@@ -78,4 +112,15 @@ namespace ui {
         return getch();
     }
 
+    /**
+     * @brief Resizes curses to the current terminal size and repaints everything on the next update.
+     */
+    void NcursesWrapper::resize() {
+        struct winsize size;
+
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0)
+            resizeterm(size.ws_row, size.ws_col);
+        clearok(curscr, TRUE);
+    }
+
 } // namespace ui
@@ -0,0 +1,106 @@
+/**
+ * @file WindowCanvas.cpp
+ * @brief Implementation of the ui::WindowCanvas class
+ * @date 2025-06-17
+ */
+
+#include "ui/WindowCanvas.hpp"
+
+#include <algorithm>
+
+namespace ui {
+
+    WindowCanvas::WindowCanvas(WINDOW* window) : _window(window) {}
+
+    /**
+     * @brief Starts describing a new frame. Rows not written to before present() come out blank.
+     */
+    void WindowCanvas::begin() {
+        int height = getmaxy(_window);
+
+        _pending.assign(static_cast<std::size_t>(std::max(0, height)), Row());
+        _boxed = false;
+        _framed = true;
+    }
+
+    void WindowCanvas::box() {
+        _boxed = true;
+    }
+
+    /**
+     * @brief Adds text to the frame. Text is clipped to the window, or to its inner edge when boxed,
+     * so it never wraps onto the next row.
+     */
+    void WindowCanvas::text(int y, int x, std::string_view text, attr_t attrs) {
+        if (y < 0 || x < 0 || y >= static_cast<int>(_pending.size()) || text.empty())
+            return;
+        _pending[y].push_back(Span { x, attrs, std::string(text) });
+    }
+
+    /**
+     * @brief Forgets what was shown, so the next present() rewrites every row.
+     */
+    void WindowCanvas::invalidate() {
+        _invalid = true;
+    }
+
+    /**
+     * @brief Rewrites the rows that changed since the last frame. The window still has to be staged.
+     * Does nothing if no frame was described since the last call.
+     */
+    void WindowCanvas::present() {
+        if (!_framed)
+            return;
+
+        int height, width;
+        getmaxyx(_window, height, width);
+        if (_shown.size() != _pending.size()) {
+            _shown.assign(_pending.size(), Row());
+            _invalid = true;
+        }
+
+        bool borderChanged = _boxed != _shownBoxed;
+        for (int y = 0; y < height; ++y) {
+            if (_invalid || borderChanged || is_linetouched(_window, y) || _pending[y] != _shown[y])
+                drawRow(y, height, width);
+        }
+
+        _shown.swap(_pending);
+        _shownBoxed = _boxed;
+        _invalid = false;
+        _framed = false;
+    }
+
+    void WindowCanvas::drawRow(int y, int height, int width) {
+        int right = _boxed ? width - 1 : width;
+
+        wattrset(_window, A_NORMAL);
+        wmove(_window, y, 0);
+        wclrtoeol(_window);
+        if (_boxed) {
+            if (y == 0 || y == height - 1) {
+                mvwaddch(_window, y, 0, y == 0 ? ACS_ULCORNER : ACS_LLCORNER);
+                mvwhline(_window, y, 1, ACS_HLINE, width - 2);
+                mvwaddch(_window, y, width - 1, y == 0 ? ACS_URCORNER : ACS_LRCORNER);
+            } else {
+                mvwaddch(_window, y, 0, ACS_VLINE);
+                mvwaddch(_window, y, width - 1, ACS_VLINE);
+            }
+        }
+
+        for (const Span& span : _pending[y]) {
+            int room = right - span.x;
+            if (room <= 0)
+                continue;
+
+            std::size_t length = std::min(span.text.size(), static_cast<std::size_t>(room));
+            // Do not cut a UTF-8 sequence in half
+            while (length > 0 && length < span.text.size() && (span.text[length] & 0xC0) == 0x80)
+                --length;
+            wattrset(_window, span.attrs);
+            mvwaddnstr(_window, y, span.x, span.text.data(), static_cast<int>(length));
+        }
+        wattrset(_window, A_NORMAL);
+    }
+
+} // namespace ui
@@ -7,12 +7,60 @@
 
 #include "ui/views/ExplorerView.hpp"
 #include "ui/NcursesApp.hpp"
+#include <algorithm>
 #include <memory>
 #include <fstream>
+#include <cstdlib>
 #include <ncurses.h>
 
 namespace ui {
 
+    /**
+     * @brief Reads the listing cache budget from FMAN_CACHE_MB, if set.
+     * @return The budget in bytes.
+     */
+    static std::size_t listingCacheBudget() {
+        const char* value = std::getenv("FMAN_CACHE_MB");
+        if (value == nullptr || *value == '\0')
+            return core::ListingCache::DEFAULT_BYTE_BUDGET;
+        return static_cast<std::size_t>(std::strtoull(value, nullptr, 10)) * 1024 * 1024;
+    }
+
+    /**
+     * @brief Color pair of a plain file, by file class.
+     */
+    static int classColorPair(core::FileClass fileClass) {
+        static constexpr int pairs[] = {
+            2, // NONE
+            7, // DOCUMENT
+            2, // SOURCE
+            3, // SCRIPT
+            2, // DATA
+            6, // IMAGE
+            6, // AUDIO
+            6, // VIDEO
+            2, // FONT
+            5, // ARCHIVE
+            2  // BINARY
+        };
+        auto index = static_cast<std::size_t>(fileClass);
+        return index < std::size(pairs) ? pairs[index] : 2;
+    }
+
+    /**
+     * @brief Label of a sort key, as shown in the title bar.
+     */
+    static const char* sortLabel(core::SortKey key) {
+        switch (key) {
+            case core::SortKey::NAME: return "nom";
+            case core::SortKey::EXTENSION: return "extension";
+            case core::SortKey::TYPE: return "type";
+            case core::SortKey::SIZE: return "taille";
+            case core::SortKey::MTIME: return "date";
+            default: return "aucun";
+        }
+    }
+
     /**
      * @brief Constructor for the ExplorerView class.
      * Initializes the explorer view with the given manager, parent application, and switch callback.
@@ -21,7 +69,7 @@ namespace ui {
      * @param switchCallback The callback function to switch views.
      */
     ExplorerView::ExplorerView(NcursesManager& manager, NcursesApp& parent, std::function<void(ViewType)> switchCallback)
-        : _directory("."), _selectedIndex(0), _manager(manager), _parent(parent), _switchCallback(switchCallback)
+        : _directory(".", listingCacheBudget(), &parent.getNotifier()), _cutPending(false), _selectedIndex(0), _scrollOffset(0), _pageSize(1), _filtering(false), _manager(manager), _parent(parent), _switchCallback(switchCallback)
     {
         try {
             _context = std::make_unique<ExplorerContext>(ExplorerContext {
@@ -31,12 +79,14 @@ namespace ui {
                 _fileNames,
                 _selectedIndex,
                 _switchCallback,
-                _copiedPath
+                _copiedPath,
+                _cutPending
             });
             _actionHandler = std::make_unique<FileActionHandler>(*_context);
-            _fileNames = _directory.listFiles();
+            _directory.setSortOrder(core::SortOrder { core::SortKey::NAME, true });
+            _fileNames = _directory.names();
         } catch (const std::exception& e) {
-            _fileNames.clear();
+            _fileNames = core::NameSpan();
             _manager.drawText(0, 0, 2, "Error: Unable to list files in the directory.");
         }
     }
@@ -47,12 +97,30 @@ namespace ui {
      * @param ch The input character.
      */
     void ExplorerView::handleInput(int ch) {
+        if (_filtering && handleFilterInput(ch))
+            return;
+
         switch (ch) {
             case KEY_UP:
-                _selectedIndex = (_selectedIndex - 1 + _fileNames.size()) % _fileNames.size();
+                if (!_fileNames.empty())
+                    _selectedIndex = (_selectedIndex - 1 + _fileNames.size()) % _fileNames.size();
                 break;
             case KEY_DOWN:
-                _selectedIndex = (_selectedIndex + 1) % _fileNames.size();
+                if (!_fileNames.empty())
+                    _selectedIndex = (_selectedIndex + 1) % _fileNames.size();
+                break;
+            case KEY_PPAGE:
+                moveSelection(-_pageSize);
+                break;
+            case KEY_NPAGE:
+                moveSelection(_pageSize);
+                break;
+            case KEY_HOME:
+                _selectedIndex = 0;
+                break;
+            case KEY_END:
+                if (!_fileNames.empty())
+                    _selectedIndex = static_cast<int>(_fileNames.size()) - 1;
                 break;
             case '\n':
             case KEY_ENTER:
@@ -85,90 +153,285 @@ namespace ui {
             case 'c':
                 _actionHandler->copySelected();
                 break;
+            case 'm':
+                _actionHandler->cutSelected();
+                break;
             case 'v':
                 _actionHandler->pasteCopied();
-                break;            
+                break;
+            case 'V':
+                _actionHandler->pasteCopied(true);
+                break;
+            case 'p':
+                _actionHandler->toggleJobPause();
+                break;
+            case 'X':
+                _actionHandler->cancelJob();
+                break;
+            case 's': {
+                core::SortOrder order = _directory.sortOrder();
+                order.key = static_cast<core::SortKey>((static_cast<int>(order.key) + 1) % core::SORT_KEY_COUNT);
+                changeSortOrder(order);
+                break;
+            }
+            case 'S': {
+                core::SortOrder order = _directory.sortOrder();
+                order.directoriesFirst = !order.directoriesFirst;
+                changeSortOrder(order);
+                break;
+            }
+            case '/':
+                _filtering = true;
+                break;
+            case 'f':
+                _switchCallback(ViewType::FINDER);
+                break;
+            case 'g':
+                _switchCallback(ViewType::GREP);
+                break;
+            case 'i':
+                showInfo();
+                break;
+            case 'a':
+                _switchCallback(ViewType::USAGE);
+                break;
+            case 't':
+                _switchCallback(ViewType::REPORT);
+                break;
+            case 27: // Escape
+                if (_directory.isFiltered())
+                    keepSelection([this] { _directory.clearFilter(); });
+                break;
         }
     }
 
     /**
      * @brief Updates the ExplorerView.
-     * Clears the window, draws the text, and refreshes the UI.
+     * Describes the frame on the explorer canvas.
+     * Only the visible slice of the listing is drawn, so a frame costs the same for any directory size,
+     * and only the rows that changed since the last frame reach the terminal.
      */
     void ExplorerView::update() {
-        WINDOW* win = _manager.getWindow(WindowRole::EXPLORER);
-        NcursesWrapper& wrapper = _manager.getWrapper();
-    
-        wrapper.clearWindow(win);
-        box(win, 0, 0);
-        wrapper.drawTextInWindow(win, 0, 2, " Explorateur ");
+        if (_directory.isLoading() || _directory.isWatching())
+            _actionHandler->refreshListing();
+        if (_pendingSelection && !_directory.isLoading()) {
+            std::size_t pos = _directory.indexOf(*_pendingSelection);
+            if (pos != core::Directory::npos)
+                _selectedIndex = static_cast<int>(pos);
+            _pendingSelection.reset();
+        }
+        if (!_directory.isLoading())
+            _directory.prefetch(_selectedIndex);
+
+        WindowCanvas& canvas = _manager.getCanvas(WindowRole::EXPLORER);
+
+        int max_y, max_x;
+        getmaxyx(canvas.window(), max_y, max_x);
+
+        // Rows 0-2 hold the border and header, the last three the key help and border
+        int rows = std::max(1, max_y - 6);
+        _pageSize = rows;
+        scrollToSelection(rows);
+
+        canvas.begin();
+        canvas.box();
+        core::SortOrder order = _directory.sortOrder();
+        std::string title = std::string(" Explorateur - tri: ") + sortLabel(order.key) + (order.directoriesFirst ? ", dossiers d'abord " : " ");
+        canvas.text(0, 2, title);
+        if (!_fileNames.empty()) {
+            std::string position(" ");
+            position.append(std::to_string(_selectedIndex + 1)).append("/").append(std::to_string(_fileNames.size())).append(" ");
+            canvas.text(0, max_x - static_cast<int>(position.length()) - 2, position);
+        }
     
-        wrapper.drawTextInWindow(win, 1, 2, "Dossier courant: " + _directory.getPath());
+        std::string header = "Dossier courant: " + _directory.getPath();
+        if (_directory.isLoading())
+            header += "  (chargement de " + std::to_string(_directory.scannedCount()) + " entrées...)";
+        canvas.text(1, 2, header);
+
+        if (_filtering || _directory.isFiltered()) {
+            std::string prompt = "/" + _directory.filter() + (_filtering ? "_" : "")
+                + "  (" + std::to_string(_fileNames.size()) + " correspondances)";
+            canvas.text(2, 2, prompt, COLOR_PAIR(5));
+        }
     
-        for (std::size_t i = 0; i < _fileNames.size(); ++i) {
-            std::string name = _fileNames[i];
-            std::string fullPath = _directory.getPath() + "/" + name;
+        std::size_t first = static_cast<std::size_t>(_scrollOffset);
+        std::size_t last = std::min(_fileNames.size(), first + static_cast<std::size_t>(rows));
+        for (std::size_t i = first; i < last; ++i) {
+            std::string_view name = _fileNames[i];
+            std::uint8_t attributes = _directory.attributesAt(i);
     
-            int colorPair = 2;
+            int colorPair;
     
-            try {
-                std::filesystem::directory_entry entry(fullPath);
-                if (entry.is_directory()) {
-                    colorPair = 1;
-                } else if ((entry.status().permissions() & std::filesystem::perms::owner_exec) != std::filesystem::perms::none) {
-                    colorPair = 3;
-                } else if (entry.is_symlink()) {
-                    colorPair = 4;
-                } else if (_actionHandler->isArchive(name)) {
-                    colorPair = 5;
-                }
-            } catch (...) {
-                colorPair = 2;
+            // Classified when the entry was scanned: drawing a row makes no syscall
+            if (attributes & core::EntryTable::ATTR_DIRECTORY) {
+                colorPair = 1;
+            } else if (attributes & core::EntryTable::ATTR_EXECUTABLE) {
+                colorPair = 3;
+            } else if (attributes & core::EntryTable::ATTR_SYMLINK) {
+                colorPair = 4;
+            } else {
+                colorPair = classColorPair(core::EntryTable::fileClassOf(attributes));
             }
     
-            if (_selectedIndex == static_cast<int>(i)) wattron(win, A_REVERSE);
-            wattron(win, COLOR_PAIR(colorPair));
-            wrapper.drawTextInWindow(win, 3 + i, 2, (_selectedIndex == static_cast<int>(i) ? "> " : "  ") + name);
-            wattroff(win, COLOR_PAIR(colorPair));
-            if (_selectedIndex == static_cast<int>(i)) wattroff(win, A_REVERSE);
+            bool selected = _selectedIndex == static_cast<int>(i);
+            attr_t attrs = COLOR_PAIR(colorPair) | (selected ? A_REVERSE : A_NORMAL);
+            canvas.text(3 + static_cast<int>(i - first), 2, (selected ? "> " : "  ") + std::string(name), attrs);
         }
-    
-        int max_y, max_x;
-        getmaxyx(win, max_y, max_x);
 
-        wrapper.drawTextInWindow(win, max_y - 3, 2, "[Entrée] Ouvrir  [q] Menu");
+        canvas.text(max_y - 3, 2, "[Entrée] Ouvrir  [q] Menu  [s/S] Tri  [/] Filtrer  [f] Chercher  [g] Contenu  [i] Infos  [a] Espace  [t] Rapport");
 
         std::string rightLine1 = "[x] Supprimer  [b] Retour  [r] Renommer";
         int right1_x = max_x - static_cast<int>(rightLine1.length()) - 2;
-        wrapper.drawTextInWindow(win, max_y - 3, right1_x, rightLine1);
+        canvas.text(max_y - 3, right1_x, rightLine1);
 
-        wrapper.drawTextInWindow(win, max_y - 2, 2, "[n] Nouveau fichier  [d] Nouveau dossier");
-        std::string rightLine2 = "[z] Zip  [u] Unzip [c] Copier  [v] Coller";
+        canvas.text(max_y - 2, 2, "[n] Nouveau fichier  [d] Nouveau dossier  [p] Pause  [X] Annuler");
+        std::string rightLine2 = "[z] Zip  [u] Unzip [c] Copier  [m] Couper  [v/V] Coller";
         int right2_x = max_x - static_cast<int>(rightLine2.length()) - 2;
-        wrapper.drawTextInWindow(win, max_y - 2, right2_x, rightLine2);
-    
-        wrapper.refreshWindow(win);
+        canvas.text(max_y - 2, right2_x, rightLine2);
     }    
 
+    /**
+     * @brief Lists the inotify descriptor while the listing is watched, so the main loop wakes up
+     * for changes. It is left out otherwise, since update() only drains it while watching.
+     * @param fds The descriptors to append to.
+     */
+    void ExplorerView::pollFds(std::vector<int>& fds) const {
+        if (_directory.isWatching())
+            fds.push_back(_directory.watchFd());
+    }
+
+    /**
+     * @brief Opens the directory holding path, and selects path once the listing is loaded.
+     * @param path The path picked in the finder.
+     */
+    void ExplorerView::jumpTo(const std::string& path) {
+        std::string::size_type slash = path.find_last_of('/');
+        if (slash == std::string::npos)
+            return;
+
+        _directory.setPath(path.substr(0, slash));
+        _fileNames = _directory.names();
+        _pendingSelection = path.substr(slash + 1);
+        _selectedIndex = 0;
+        _scrollOffset = 0;
+    }
+
     /**
      * @brief Enters the selected file or directory.
      * If the selected item is a directory, it updates the current directory and lists its files.
      * If it's a file, it switches to the file information view.
      */
     void ExplorerView::enterSelected() {
-        const std::string& selectedName = _fileNames[_selectedIndex];
-        std::string newPath = _directory.getPath() + "/" + selectedName;
+        if (_fileNames.empty())
+            return;
 
-        std::filesystem::directory_entry entry(newPath);
-        if (entry.is_directory()) {
-            _directory.setPath(newPath);
-            _fileNames = _directory.listFiles();
+        auto file = std::make_shared<core::File>(_directory.fileAt(_selectedIndex));
+        if (file->isDirectory()) {
+            _directory.setPath(file->getPath());
+            _fileNames = _directory.names();
             _selectedIndex = 0;
+            _scrollOffset = 0;
         } else {
-            auto file = std::make_shared<core::File>(entry);
             _parent.setSelectedFile(file);
             _switchCallback(ViewType::FILE_INFO);
         }
     }
 
+    /**
+     * @brief Shows the information view for the selected entry, directories included.
+     */
+    void ExplorerView::showInfo() {
+        if (_fileNames.empty())
+            return;
+
+        _parent.setSelectedFile(std::make_shared<core::File>(_directory.fileAt(_selectedIndex)));
+        _switchCallback(ViewType::FILE_INFO);
+    }
+
+    /**
+     * @brief Re-sorts the listing and keeps the cursor on the same entry.
+     * @param order The new sort order.
+     */
+    void ExplorerView::changeSortOrder(core::SortOrder order) {
+        keepSelection([this, order] { _directory.setSortOrder(order); });
+    }
+
+    /**
+     * @brief Handles a key while the filter prompt is open.
+     * Printable characters narrow the listing, Backspace widens it back, Enter closes the prompt
+     * and keeps the filter, Escape drops it.
+     * @param ch The input character.
+     * @return False if the key is not for the prompt, e.g. a cursor key.
+     */
+    bool ExplorerView::handleFilterInput(int ch) {
+        switch (ch) {
+            case 27: // Escape
+                _filtering = false;
+                keepSelection([this] { _directory.clearFilter(); });
+                return true;
+            case '\n':
+            case KEY_ENTER:
+                _filtering = false;
+                return true;
+            case KEY_BACKSPACE:
+            case 127:
+            case '\b':
+                if (!_directory.isFiltered())
+                    _filtering = false;
+                else
+                    keepSelection([this] { _directory.popFilter(); });
+                return true;
+            default:
+                if (ch < ' ' || ch > 0xFF || ch == 127)
+                    return false;
+                keepSelection([this, ch] { _directory.pushFilter(static_cast<char>(ch)); });
+                return true;
+        }
+    }
+
+    /**
+     * @brief Applies a change that reorders or hides entries, and keeps the cursor on the same
+     * entry if it is still listed.
+     * @param change The change to apply to the directory.
+     */
+    void ExplorerView::keepSelection(const std::function<void()>& change) {
+        std::string selected;
+        if (_selectedIndex < static_cast<int>(_fileNames.size()))
+            selected = std::string(_fileNames[_selectedIndex]);
+
+        change();
+        _fileNames = _directory.names();
+
+        std::size_t pos = selected.empty() ? core::Directory::npos : _directory.indexOf(selected);
+        if (pos != core::Directory::npos)
+            _selectedIndex = static_cast<int>(pos);
+        else
+            _selectedIndex = 0;
+    }
+
+    /**
+     * @brief Moves the selection by a number of rows, stopping at either end of the listing.
+     * @param delta The number of rows to move, negative to go up.
+     */
+    void ExplorerView::moveSelection(int delta) {
+        if (_fileNames.empty())
+            return;
+        _selectedIndex = std::clamp(_selectedIndex + delta, 0, static_cast<int>(_fileNames.size()) - 1);
+    }
+
+    /**
+     * @brief Adjusts the scroll offset so the selection is on screen, scrolling as little as possible.
+     * @param rows The number of rows available for entries.
+     */
+    void ExplorerView::scrollToSelection(int rows) {
+        int count = static_cast<int>(_fileNames.size());
+
+        if (_selectedIndex < _scrollOffset)
+            _scrollOffset = _selectedIndex;
+        else if (_selectedIndex >= _scrollOffset + rows)
+            _scrollOffset = _selectedIndex - rows + 1;
+        _scrollOffset = std::clamp(_scrollOffset, 0, std::max(0, count - rows));
+    }
+
 } // namespace ui
@@ -1,8 +1,16 @@
 #include "ui/views/FileActionHandler.hpp"
+#include "ui/NcursesApp.hpp"
+#include "core/CommandJob.hpp"
+#include "core/CopyJob.hpp"
+#include "core/DeleteJob.hpp"
+#include "core/FileClass.hpp"
+#include "core/MoveJob.hpp"
 #include <fstream>
 #include <filesystem>
 #include <ncurses.h>
 #include <cstdlib>
+#include <memory>
+#include <vector>
 
 namespace ui {
 
@@ -11,7 +19,7 @@ namespace ui {
      * @param suffix The suffix to check for.
      * @return True if the string ends with the suffix, false otherwise.
      */
-    static bool endsWith(const std::string& str, const std::string& suffix) {
+    static bool endsWith(std::string_view str, std::string_view suffix) {
         return str.size() >= suffix.size() &&
                str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
     }
@@ -26,9 +34,32 @@ namespace ui {
      * @param name The name of the file to check.
      * @return True if the file is an archive, false otherwise.
      */
-    bool FileActionHandler::isArchive(const std::string& name) {
-        return endsWith(name, ".zip") || endsWith(name, ".tar") ||
-               endsWith(name, ".gz")  || endsWith(name, ".rar");
+    bool FileActionHandler::isArchive(std::string_view name) {
+        return core::classifyName(name) == core::FileClass::ARCHIVE;
+    }
+
+    /** @brief Brings the listing up to date after a file action, without a full rescan.
+     * The cursor stays on the entry it was on, or moves to selectName when given.
+     * If that entry is gone, the cursor keeps its position, clamped to the new size.
+     * @param selectName The entry to select afterwards, or empty to keep the current one.
+     */
+    void FileActionHandler::refreshListing(const std::string& selectName) {
+        std::string keep = selectName;
+        if (keep.empty() && _ctx.selectedIndex < static_cast<int>(_ctx.fileNames.size()))
+            keep = std::string(_ctx.fileNames[_ctx.selectedIndex]);
+
+        bool loading = _ctx.directory.isLoading();
+        if (!_ctx.directory.sync())
+            return;
+        _ctx.fileNames = _ctx.directory.names();
+        if (loading && _ctx.directory.isLoading())
+            return; // a scan only appends, positions are unchanged until it completes and is sorted
+
+        std::size_t pos = _ctx.directory.indexOf(keep);
+        if (pos != core::Directory::npos)
+            _ctx.selectedIndex = static_cast<int>(pos);
+        else if (_ctx.selectedIndex >= static_cast<int>(_ctx.fileNames.size()))
+            _ctx.selectedIndex = std::max(0, static_cast<int>(_ctx.fileNames.size()) - 1);
     }
 
     /** @brief Creates a new file in the current directory.
@@ -46,6 +77,7 @@ namespace ui {
         char filename[256];
         echo(); wgetnstr(inputWin, filename, 255); noecho();
         wrapper.destroyWindow(inputWin);
+        _ctx.manager.touchAll();
 
         std::string path = _ctx.directory.getPath() + "/" + filename;
         if (std::filesystem::exists(path)) {
@@ -56,8 +88,7 @@ namespace ui {
         std::ofstream file(path);
         file.close();
 
-        _ctx.fileNames = _ctx.directory.listFiles();
-        _ctx.switchCallback(ViewType::EXPLORER);
+        refreshListing(filename);
     }
 
     /** @brief Creates a new directory in the current directory.
@@ -75,6 +106,7 @@ namespace ui {
         char dirname[256];
         echo(); wgetnstr(inputWin, dirname, 255); noecho();
         wrapper.destroyWindow(inputWin);
+        _ctx.manager.touchAll();
 
         std::string path = _ctx.directory.getPath() + "/" + dirname;
         if (std::filesystem::exists(path)) {
@@ -83,34 +115,19 @@ namespace ui {
         }
 
         std::filesystem::create_directory(path);
-        _ctx.fileNames = _ctx.directory.listFiles();
-        _ctx.switchCallback(ViewType::EXPLORER);
+        refreshListing(dirname);
     }
 
     /** @brief Deletes the currently selected file or directory.
      * If the selected item is a directory, it will be removed recursively.
-     * Updates the file list and switches back to the explorer view.
+     * The deletion runs on the job queue; the watched listing follows it as entries go.
      */
     void FileActionHandler::deleteSelected() {
         if (_ctx.fileNames.empty()) return;
-        std::string name = _ctx.fileNames[_ctx.selectedIndex];
+        std::string name(_ctx.fileNames[_ctx.selectedIndex]);
         std::string path = _ctx.directory.getPath() + "/" + name;
 
-        try {
-            std::filesystem::directory_entry entry(path);
-            if (entry.is_directory())
-                std::filesystem::remove_all(path);
-            else
-                std::filesystem::remove(path);
-
-            _ctx.fileNames = _ctx.directory.listFiles();
-            if (_ctx.selectedIndex >= static_cast<int>(_ctx.fileNames.size()))
-                _ctx.selectedIndex = std::max(0, static_cast<int>(_ctx.fileNames.size()) - 1);
-        } catch (...) {
-            _ctx.manager.drawText(0, 0, 0, "Erreur: suppression échouée");
-        }
-
-        _ctx.switchCallback(ViewType::EXPLORER);
+        _ctx.app.getJobs().submit(std::make_shared<core::DeleteJob>("Suppression de " + name, path));
     }
 
     /** @brief Renames the currently selected file or directory.
@@ -120,7 +137,7 @@ namespace ui {
     void FileActionHandler::renameSelected() {
         if (_ctx.fileNames.empty()) return;
 
-        std::string oldName = _ctx.fileNames[_ctx.selectedIndex];
+        std::string oldName(_ctx.fileNames[_ctx.selectedIndex]);
         std::string oldPath = _ctx.directory.getPath() + "/" + oldName;
 
         int max_y, max_x;
@@ -132,7 +149,8 @@ namespace ui {
 
         char newName[256];
         echo(); wgetnstr(inputWin, newName, 255); noecho();
-        delwin(inputWin);
+        _ctx.manager.getWrapper().destroyWindow(inputWin);
+        _ctx.manager.touchAll();
 
         std::string newPath = _ctx.directory.getPath() + "/" + newName;
         if (std::filesystem::exists(newPath)) {
@@ -141,36 +159,30 @@ namespace ui {
         }
 
         std::filesystem::rename(oldPath, newPath);
-        _ctx.fileNames = _ctx.directory.listFiles();
-        _ctx.switchCallback(ViewType::EXPLORER);
+        refreshListing(newName);
     }
 
     /** @brief Zips the currently selected file or directory.
      * If the selected item is a directory, it will be zipped recursively.
-     * Updates the file list and switches back to the explorer view.
+     * zip runs on the job queue.
      */
     void FileActionHandler::zipSelected() {
         if (_ctx.fileNames.empty()) return;
-        std::string name = _ctx.fileNames[_ctx.selectedIndex];
+        std::string name(_ctx.fileNames[_ctx.selectedIndex]);
         std::string src = _ctx.directory.getPath() + "/" + name;
         std::string dest = src + ".zip";
 
-        std::string command = "zip -r \"" + dest + "\" \"" + src + "\"";
-        if (system(command.c_str()) == 0)
-            _ctx.fileNames = _ctx.directory.listFiles();
-        else
-            _ctx.manager.drawText(0, 0, 0, "Erreur lors du zip");
-
-        _ctx.switchCallback(ViewType::EXPLORER);
+        _ctx.app.getJobs().submit(std::make_shared<core::CommandJob>(
+            "Compression de " + name, std::vector<std::string>{ "zip", "-r", dest, src }));
     }
 
     /** @brief Unzips the currently selected zip archive.
      * If the selected item is not a zip file, an error message is displayed.
-     * Updates the file list and switches back to the explorer view.
+     * unzip runs on the job queue.
      */
     void FileActionHandler::unzipSelected() {
         if (_ctx.fileNames.empty()) return;
-        std::string name = _ctx.fileNames[_ctx.selectedIndex];
+        std::string name(_ctx.fileNames[_ctx.selectedIndex]);
         if (!endsWith(name, ".zip")) {
             _ctx.manager.drawText(0, 0, 0, "Pas une archive zip !");
             return;
@@ -178,31 +190,32 @@ namespace ui {
 
         std::string src = _ctx.directory.getPath() + "/" + name;
         std::string dest = _ctx.directory.getPath() + "/unzipped_" + name.substr(0, name.size() - 4);
-        std::string command = "unzip \"" + src + "\" -d \"" + dest + "\"";
-
-        if (system(command.c_str()) == 0)
-            _ctx.fileNames = _ctx.directory.listFiles();
-        else
-            _ctx.manager.drawText(0, 0, 0, "Erreur lors du unzip");
 
-        _ctx.switchCallback(ViewType::EXPLORER);
+        _ctx.app.getJobs().submit(std::make_shared<core::CommandJob>(
+            "Extraction de " + name, std::vector<std::string>{ "unzip", src, "-d", dest }));
     }
 
     /** @brief Navigates back to the parent directory.
      * If already at the root, an error message is displayed.
-     * Updates the file list and switches back to the explorer view.
+     * Updates the file list.
      */
     void FileActionHandler::goBackToParent() {
         auto current = std::filesystem::path(_ctx.directory.getPath());
         if (current.has_parent_path()) {
+            std::string child = current.filename().string();
             _ctx.directory.setPath(current.parent_path().string());
-            _ctx.fileNames = _ctx.directory.listFiles();
+            _ctx.fileNames = _ctx.directory.names();
             _ctx.selectedIndex = 0;
+
+            // A cached listing is complete right away: put the cursor back on where we came from
+            if (!_ctx.directory.isLoading()) {
+                std::size_t pos = _ctx.directory.indexOf(child);
+                if (pos != core::Directory::npos)
+                    _ctx.selectedIndex = static_cast<int>(pos);
+            }
         } else {
             _ctx.manager.drawText(0, 0, 0, "Déjà à la racine.");
         }
-
-        _ctx.switchCallback(ViewType::EXPLORER);
     }
 
     /** @brief Copies the currently selected file or directory.
@@ -210,32 +223,61 @@ namespace ui {
      */
     void FileActionHandler::copySelected() {
         if (_ctx.fileNames.empty()) return;
-        std::string selected = _ctx.fileNames[_ctx.selectedIndex];
-        _ctx.copiedPath = _ctx.directory.getPath() + "/" + selected;
+        _ctx.copiedPath = _ctx.directory.pathOf(_ctx.selectedIndex);
+        _ctx.cutPending = false;
+    }
+
+    /** @brief Cuts the currently selected file or directory.
+     * It is moved, rather than copied, by the next paste.
+     */
+    void FileActionHandler::cutSelected() {
+        if (_ctx.fileNames.empty()) return;
+        _ctx.copiedPath = _ctx.directory.pathOf(_ctx.selectedIndex);
+        _ctx.cutPending = true;
     }
 
     /** @brief Pastes the previously copied file or directory into the current directory.
      * If a file with the same name already exists, it will be overwritten.
-     * Updates the file list and switches back to the explorer view.
+     * A cut file or directory is moved instead, once, and never over an existing one.
+     * The copy runs on the job queue; the watched listing follows it as entries appear.
+     * @param checksum Hash every file as it is read, with direct I/O for the large ones.
      */
-    void FileActionHandler::pasteCopied() {
+    void FileActionHandler::pasteCopied(bool checksum) {
         if (!_ctx.copiedPath.has_value()) return;
 
         std::filesystem::path source(_ctx.copiedPath.value());
-        std::filesystem::path dest = std::filesystem::path(_ctx.directory.getPath()) / source.filename();
-
-        try {
-            if (std::filesystem::is_directory(source)) {
-                std::filesystem::copy(source, dest, std::filesystem::copy_options::recursive | std::filesystem::copy_options::overwrite_existing);
-            } else {
-                std::filesystem::copy_file(source, dest, std::filesystem::copy_options::overwrite_existing);
-            }
-            _ctx.fileNames = _ctx.directory.listFiles();
-        } catch (...) {
-            _ctx.manager.drawText(0, 0, 0, "Erreur: collage échoué");
+        if (_ctx.cutPending) {
+            _ctx.app.getJobs().submit(std::make_shared<core::MoveJob>(
+                "Déplacement de " + source.filename().string(), source.string(), _ctx.directory.getPath()));
+            _ctx.copiedPath.reset();
+            _ctx.cutPending = false;
+            return;
         }
+        std::string description = (checksum ? "Copie avec somme de contrôle de " : "Copie de ") + source.filename().string();
+        core::CopyOptions options;
+        options.checksum = checksum;
+        options.direct = checksum;
+        _ctx.app.getJobs().submit(std::make_shared<core::CopyJob>(
+            description, source.string(), _ctx.directory.getPath(), options));
+    }
+
+    /** @brief Pauses the running file operation, or resumes it if it is paused.
+     */
+    void FileActionHandler::toggleJobPause() {
+        std::shared_ptr<core::Job> job = _ctx.app.getJobs().current();
+        if (!job) return;
 
-        _ctx.switchCallback(ViewType::EXPLORER);
+        if (job->paused())
+            job->resume();
+        else
+            job->pause();
+    }
+
+    /** @brief Cancels the running file operation. What it has done so far stays.
+     */
+    void FileActionHandler::cancelJob() {
+        if (std::shared_ptr<core::Job> job = _ctx.app.getJobs().current())
+            job->cancel();
     }
 
 } // namespace ui
@@ -17,13 +17,22 @@ namespace ui {
     /**
      * @brief Constructor for the FileInfoView class.
      * Initializes the file information view with the given file and switch callback.
+     * A directory starts being sized right away.
      * @param manager The NcursesManager instance to manage the UI.
      * @param file The file to display information about.
+     * @param usageCache The totals of the directories sized before, filled in by this one.
+     * @param notifier Signalled by the sizing as its totals grow.
      * @param switchCallback The callback function to switch views.
      */
-    FileInfoView::FileInfoView(NcursesManager& manager, const core::File& file, std::function<void(ViewType)> switchCallback)
+    FileInfoView::FileInfoView(NcursesManager& manager, const core::File& file, core::UsageCache& usageCache,
+                               core::EventNotifier* notifier, std::function<void(ViewType)> switchCallback)
         : _manager(manager), _switchCallback(switchCallback), _file(file)
-    {}
+    {
+        if (_file.isDirectory()) {
+            _lastUsage = usageCache.find(core::UsageCache::keyOf(_file.getPath()));
+            _usage = std::make_unique<core::DiskUsage>(_file.getPath(), &usageCache, notifier);
+        }
+    }
 
     /**
      * @brief Handles user input for the FileInfoView.
@@ -32,34 +41,58 @@ namespace ui {
      */
     void FileInfoView::handleInput(int ch) {
         if (ch == 'q' || ch == '\n' || ch == 10) {
+            _usage.reset();
             _switchCallback(ViewType::MAIN_MENU);
         }
     }
 
     /**
      * @brief Updates the FileInfoView.
-     * Clears the window, draws the text, and refreshes the UI.
+     * Describes the frame on the sidebar canvas; only rows that changed reach the terminal.
      */
     void FileInfoView::update() {
-        WINDOW* win = _manager.getWindow(WindowRole::SIDEBAR);
-        auto& wrapper = _manager.getWrapper();
-    
-        wrapper.clearWindow(win);
-        box(win, 0, 0);
-        wrapper.drawTextInWindow(win, 0, 2, " Informations ");
+        WindowCanvas& canvas = _manager.getCanvas(WindowRole::SIDEBAR);
     
-        int max_y, max_x;
-        getmaxyx(win, max_y, max_x);
+        canvas.begin();
+        canvas.box();
+        canvas.text(0, 2, " Informations ");
     
-        wrapper.drawTextInWindow(win, 2, 2, "Nom: " + _file.getName());
-        wrapper.drawTextInWindow(win, 3, 2, "Chemin: " + _file.getPath());
-        wrapper.drawTextInWindow(win, 4, 2, "Type: " + std::string(_file.isDirectory() ? "Dossier" : "Fichier"));
-        wrapper.drawTextInWindow(win, 5, 2, "Taille: " + formatSize(_file.getSize()));
-        wrapper.drawTextInWindow(win, 6, 2, "Modifié: " + formatTime(_file.getLastModified()));
+        int max_y = getmaxy(canvas.window());
     
-        wrapper.drawTextInWindow(win, max_y - 2, 2, "[Entrée] ou [q] pour retourner");
+        canvas.text(2, 2, "Nom: " + _file.getName());
+        canvas.text(3, 2, "Chemin: " + _file.getPath());
+        canvas.text(4, 2, "Type: " + std::string(_file.isDirectory() ? "Dossier" : "Fichier"));
+        if (_usage) {
+            drawUsage(canvas);
+        } else {
+            canvas.text(5, 2, "Taille: " + formatSize(_file.getSize()));
+            canvas.text(6, 2, "Modifié: " + formatTime(_file.getLastModified()));
+        }
     
-        wrapper.refreshWindow(win);
+        canvas.text(max_y - 2, 2, "[Entrée] ou [q] pour retourner");
+    }
+
+    /**
+     * @brief Draws the size of a directory: the running totals of the walk until it ends,
+     * then those of the whole tree.
+     * @param canvas The canvas of the view.
+     */
+    void FileInfoView::drawUsage(WindowCanvas& canvas) const {
+        const core::UsageNode& tree = _usage->tree();
+        bool running = !_usage->finished();
+        core::UsageTotals totals = tree.complete.load(std::memory_order_acquire) ? tree.total : _usage->progress();
+
+        canvas.text(5, 2, "Taille: " + formatSize(totals.bytes) + (running ? " (calcul...)" : ""));
+        canvas.text(6, 2, "Sur disque: " + formatSize(totals.allocated));
+        canvas.text(7, 2, "Contenu: " + std::to_string(totals.files) + " fichiers, "
+            + std::to_string(totals.directories) + " dossiers");
+        canvas.text(8, 2, "Modifié: " + formatTime(_file.getLastModified()));
+
+        int row = 9;
+        if (running && _lastUsage)
+            canvas.text(row++, 2, "Dernier calcul: " + formatSize(_lastUsage->bytes), COLOR_PAIR(5));
+        if (std::size_t errors = _usage->errors(); errors > 0)
+            canvas.text(row, 2, std::to_string(errors) + " éléments illisibles", COLOR_PAIR(5));
     }
 
     /**
@@ -0,0 +1,163 @@
+/**
+ * @file FinderView.cpp
+ * @brief Implementation of the ui::FinderView class
+ * @date 2025-06-22
+ */
+
+#include "ui/views/FinderView.hpp"
+#include <algorithm>
+#include <ncurses.h>
+
+namespace ui {
+
+    /**
+     * @brief Constructor for the FinderView class. Starts indexing the tree under root.
+     * @param manager The NcursesManager instance to manage the UI.
+     * @param root The directory to search under.
+     * @param notifier Signalled by the indexer whenever new paths are ready.
+     * @param pickCallback Called with the full path of the picked result.
+     * @param switchCallback The callback function to switch views.
+     */
+    FinderView::FinderView(NcursesManager& manager, const std::string& root, core::EventNotifier* notifier,
+                           std::function<void(const std::string&)> pickCallback, std::function<void(ViewType)> switchCallback)
+        : _manager(manager), _root(root), _index(std::make_unique<core::PathIndex>(root, notifier)), _scoredChunks(0),
+          _dirty(true), _generation(0), _selectedIndex(0), _scrollOffset(0), _pageSize(1), _pickCallback(pickCallback), _switchCallback(switchCallback)
+    {}
+
+    /**
+     * @brief Handles user input for the FinderView.
+     * Printable characters extend the pattern, Backspace shortens it, Enter jumps to the
+     * selected result and Escape goes back to the explorer.
+     * @param ch The input character.
+     */
+    void FinderView::handleInput(int ch) {
+        switch (ch) {
+            case KEY_UP:
+                _selectedIndex = std::max(0, _selectedIndex - 1);
+                break;
+            case KEY_DOWN:
+                _selectedIndex = std::min(_selectedIndex + 1, std::max(0, static_cast<int>(_results.size()) - 1));
+                break;
+            case KEY_PPAGE:
+                _selectedIndex = std::max(0, _selectedIndex - _pageSize);
+                break;
+            case KEY_NPAGE:
+                _selectedIndex = std::min(_selectedIndex + _pageSize, std::max(0, static_cast<int>(_results.size()) - 1));
+                break;
+            case '\n':
+            case KEY_ENTER:
+                pick();
+                break;
+            case 27: // Escape
+                _index.reset();
+                _switchCallback(ViewType::EXPLORER);
+                break;
+            case KEY_BACKSPACE:
+            case 127:
+            case '\b':
+                if (!_pattern.empty()) {
+                    _pattern.pop_back();
+                    _dirty = true;
+                }
+                break;
+            default:
+                if (ch >= ' ' && ch <= 0xFF && ch != 127) {
+                    _pattern.push_back(static_cast<char>(ch));
+                    _dirty = true;
+                }
+                break;
+        }
+    }
+
+    /**
+     * @brief Ranks the paths again after the pattern changed or the stored index was replaced
+     * by a fresh walk, or ranks the chunks that arrived since the last frame.
+     */
+    void FinderView::search() {
+        if (_dirty) {
+            _selectedIndex = 0;
+            _scrollOffset = 0;
+        }
+        if (_index && _index->generation() != _generation) {
+            _generation = _index->generation();
+            _dirty = true;
+        }
+        if (_dirty) {
+            _results.clear();
+            _scoredChunks = 0;
+        }
+        if (_index)
+            _chunks = _index->snapshot();
+
+        core::FuzzyMatcher matcher(_pattern);
+        matcher.search(_chunks, _scoredChunks, RESULT_LIMIT, _results);
+        _scoredChunks = _chunks.size();
+        _dirty = false;
+    }
+
+    /**
+     * @brief Stops indexing and hands the selected path over.
+     */
+    void FinderView::pick() {
+        if (_results.empty())
+            return;
+
+        std::string path = _root + "/" + std::string(pathOf(_results[_selectedIndex]));
+        _index.reset();
+        _pickCallback(path);
+    }
+
+    std::string_view FinderView::pathOf(const core::FuzzyMatch& match) const {
+        return _chunks[match.chunk]->path(match.index);
+    }
+
+    /**
+     * @brief Updates the FinderView.
+     * Describes the frame on the explorer canvas, which the finder takes over while it is open.
+     */
+    void FinderView::update() {
+        if (_dirty || (_index && (_index->chunkCount() > _scoredChunks || _index->generation() != _generation)))
+            search();
+        _selectedIndex = std::min(_selectedIndex, std::max(0, static_cast<int>(_results.size()) - 1));
+
+        WindowCanvas& canvas = _manager.getCanvas(WindowRole::EXPLORER);
+
+        int max_y, max_x;
+        getmaxyx(canvas.window(), max_y, max_x);
+
+        int rows = std::max(1, max_y - 6);
+        _pageSize = rows;
+        if (_selectedIndex < _scrollOffset)
+            _scrollOffset = _selectedIndex;
+        else if (_selectedIndex >= _scrollOffset + rows)
+            _scrollOffset = _selectedIndex - rows + 1;
+
+        canvas.begin();
+        canvas.box();
+        canvas.text(0, 2, " Rechercher ");
+
+        canvas.text(1, 2, "> " + _pattern + "_");
+        std::size_t indexed = _index ? _index->pathCount() : 0;
+        std::string progress = " chemins";
+        if (_index && !_index->finished())
+            progress += _index->stored() ? " (mise à jour...)" : " (indexation...)";
+        std::string status = std::to_string(_results.size()) + (_results.size() >= RESULT_LIMIT ? "+" : "")
+            + " / " + std::to_string(indexed) + progress;
+        canvas.text(2, 2, status, COLOR_PAIR(5));
+
+        std::size_t first = static_cast<std::size_t>(_scrollOffset);
+        std::size_t last = std::min(_results.size(), first + static_cast<std::size_t>(rows));
+        for (std::size_t i = first; i < last; ++i) {
+            const core::FuzzyMatch& match = _results[i];
+            bool directory = _chunks[match.chunk]->isDirectory(match.index);
+            bool selected = _selectedIndex == static_cast<int>(i);
+            attr_t attrs = COLOR_PAIR(directory ? 1 : 2) | (selected ? A_REVERSE : A_NORMAL);
+            canvas.text(3 + static_cast<int>(i - first), 2, (selected ? "> " : "  ") + std::string(pathOf(match)), attrs);
+        }
+
+        canvas.text(max_y - 2, 2, "[Entrée] Aller  [Échap] Retour");
+        std::string root = "Dans: " + _root;
+        canvas.text(max_y - 2, std::max(2, max_x - static_cast<int>(root.length()) - 2), root);
+    }
+
+} // namespace ui
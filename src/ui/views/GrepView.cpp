@@ -0,0 +1,181 @@
+/**
+ * @file GrepView.cpp
+ * @brief Implementation of the ui::GrepView class
+ * @date 2025-06-25
+ */
+
+#include "ui/views/GrepView.hpp"
+#include <algorithm>
+#include <ncurses.h>
+
+namespace ui {
+
+    /**
+     * @brief Constructor for the GrepView class.
+     * @param manager The NcursesManager instance to manage the UI.
+     * @param root The directory to search under.
+     * @param notifier Signalled by the search whenever new matches are found.
+     * @param pickCallback Called with the full path of the picked match's file.
+     * @param switchCallback The callback function to switch views.
+     */
+    GrepView::GrepView(NcursesManager& manager, const std::string& root, core::EventNotifier* notifier,
+                       std::function<void(const std::string&)> pickCallback, std::function<void(ViewType)> switchCallback)
+        : _manager(manager), _root(root), _notifier(notifier), _regex(false), _modified(true), _selectedIndex(0),
+          _scrollOffset(0), _pageSize(1), _pickCallback(pickCallback), _switchCallback(switchCallback)
+    {}
+
+    /**
+     * @brief Handles user input for the GrepView.
+     * Printable characters edit the pattern and Tab toggles regular expressions. Enter starts the
+     * search if the pattern changed, and opens the selected match otherwise. Escape stops a running
+     * search, or goes back to the explorer.
+     * @param ch The input character.
+     */
+    void GrepView::handleInput(int ch) {
+        int last = std::max(0, static_cast<int>(_matches.size()) - 1);
+
+        switch (ch) {
+            case KEY_UP:
+                _selectedIndex = std::max(0, _selectedIndex - 1);
+                break;
+            case KEY_DOWN:
+                _selectedIndex = std::min(_selectedIndex + 1, last);
+                break;
+            case KEY_PPAGE:
+                _selectedIndex = std::max(0, _selectedIndex - _pageSize);
+                break;
+            case KEY_NPAGE:
+                _selectedIndex = std::min(_selectedIndex + _pageSize, last);
+                break;
+            case '\n':
+            case KEY_ENTER:
+                if (_modified)
+                    start();
+                else
+                    pick();
+                break;
+            case '\t':
+                _regex = !_regex;
+                _modified = true;
+                break;
+            case 27: // Escape
+                if (_search && !_search->finished()) {
+                    _search->cancel();
+                } else {
+                    _search.reset();
+                    _switchCallback(ViewType::EXPLORER);
+                }
+                break;
+            case KEY_BACKSPACE:
+            case 127:
+            case '\b':
+                if (!_pattern.empty()) {
+                    _pattern.pop_back();
+                    _modified = true;
+                }
+                break;
+            default:
+                if (ch >= ' ' && ch <= 0xFF && ch != 127) {
+                    _pattern.push_back(static_cast<char>(ch));
+                    _modified = true;
+                }
+                break;
+        }
+    }
+
+    /**
+     * @brief Drops the current search, waiting for it to stop, and starts one for the pattern.
+     */
+    void GrepView::start() {
+        _search.reset();
+        _matches.clear();
+        _error.clear();
+        _selectedIndex = 0;
+        _scrollOffset = 0;
+        _modified = false;
+        if (_pattern.empty())
+            return;
+
+        try {
+            _search = std::make_unique<core::ContentSearch>(_root, _pattern, _regex, _notifier);
+        } catch (const std::regex_error& e) {
+            _error = "Expression invalide";
+        }
+    }
+
+    /**
+     * @brief Stops the search and hands the selected match's file over.
+     */
+    void GrepView::pick() {
+        if (_matches.empty())
+            return;
+
+        std::string path = _root + "/" + _matches[_selectedIndex].path;
+        _search.reset();
+        _pickCallback(path);
+    }
+
+    std::string GrepView::status() const {
+        if (!_error.empty())
+            return _error;
+        if (_modified)
+            return "[Entrée] pour chercher";
+        if (!_search)
+            return "";
+
+        std::size_t count = _search->matchCount();
+        std::string text = std::to_string(count) + " lignes dans " + std::to_string(_search->filesSearched())
+            + " fichiers (" + std::to_string(_search->bytesSearched() / (1024 * 1024)) + " Mo)";
+        if (count > _matches.size())
+            text += ", " + std::to_string(_matches.size()) + " affichées";
+        if (!_search->finished())
+            text += _search->cancelled() ? " (arrêt...)" : " (recherche...)";
+        else if (_search->cancelled())
+            text += " (arrêtée)";
+        return text;
+    }
+
+    /**
+     * @brief Updates the GrepView.
+     * Takes the matches found since the last frame and describes the frame on the explorer
+     * canvas, which the view takes over while it is open.
+     */
+    void GrepView::update() {
+        if (_search) {
+            std::vector<core::ContentMatch> found = _search->matchesSince(_matches.size());
+            _matches.insert(_matches.end(), std::make_move_iterator(found.begin()), std::make_move_iterator(found.end()));
+        }
+
+        WindowCanvas& canvas = _manager.getCanvas(WindowRole::EXPLORER);
+
+        int max_y, max_x;
+        getmaxyx(canvas.window(), max_y, max_x);
+
+        int rows = std::max(1, max_y - 6);
+        _pageSize = rows;
+        if (_selectedIndex < _scrollOffset)
+            _scrollOffset = _selectedIndex;
+        else if (_selectedIndex >= _scrollOffset + rows)
+            _scrollOffset = _selectedIndex - rows + 1;
+
+        canvas.begin();
+        canvas.box();
+        canvas.text(0, 2, " Rechercher dans les fichiers ");
+
+        canvas.text(1, 2, std::string(_regex ? "regex" : "texte") + " > " + _pattern + "_");
+        canvas.text(2, 2, status(), COLOR_PAIR(5));
+
+        std::size_t first = static_cast<std::size_t>(_scrollOffset);
+        std::size_t last = std::min(_matches.size(), first + static_cast<std::size_t>(rows));
+        for (std::size_t i = first; i < last; ++i) {
+            const core::ContentMatch& match = _matches[i];
+            bool selected = _selectedIndex == static_cast<int>(i);
+            attr_t attrs = COLOR_PAIR(2) | (selected ? A_REVERSE : A_NORMAL);
+            std::string row = (selected ? "> " : "  ") + match.path + ":" + std::to_string(match.line) + ": " + match.text;
+            canvas.text(3 + static_cast<int>(i - first), 2, row, attrs);
+        }
+
+        canvas.text(max_y - 2, 2, "[Entrée] Chercher/Aller  [Tab] Regex  [Échap] Arrêter/Retour");
+    }
+
+} // namespace ui
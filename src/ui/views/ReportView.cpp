@@ -0,0 +1,190 @@
+/**
+ * @file ReportView.cpp
+ * @brief Implementation of the ui::ReportView class
+ * @date 2025-06-28
+ */
+
+#include "ui/views/ReportView.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <ncurses.h>
+
+namespace ui {
+
+    /** @brief Formats a size in binary units, one decimal past the kilobyte.
+     * @param size The size in bytes.
+     * @return The size, such as "12.3 Mo".
+     */
+    static std::string formatSize(std::uint64_t size) {
+        static const char* const units[] = { "Ko", "Mo", "Go", "To", "Po" };
+        char text[32];
+
+        if (size < 1024)
+            return std::to_string(size) + " o";
+        double value = static_cast<double>(size) / 1024;
+        std::size_t unit = 0;
+        for (; value >= 1024 && unit + 1 < std::size(units); ++unit)
+            value /= 1024;
+        std::snprintf(text, sizeof(text), "%.1f %s", value, units[unit]);
+        return text;
+    }
+
+    /**
+     * @brief Constructor for the ReportView class. The report of the largest files starts right away.
+     * @param manager The NcursesManager instance to manage the UI.
+     * @param root The directory to report on.
+     * @param notifier Signalled by the report as it goes and when it is finished.
+     * @param pickCallback Called with the full path of the picked file.
+     * @param switchCallback The callback function to switch views.
+     */
+    ReportView::ReportView(NcursesManager& manager, const std::string& root, core::EventNotifier* notifier,
+                           std::function<void(const std::string&)> pickCallback,
+                           std::function<void(ViewType)> switchCallback)
+        : _manager(manager), _root(root), _notifier(notifier), _ranking(core::Ranking::LARGEST), _selectedIndex(0),
+          _scrollOffset(0), _pageSize(1), _pickCallback(pickCallback), _switchCallback(switchCallback)
+    {
+        start();
+    }
+
+    /**
+     * @brief Handles user input for the ReportView.
+     * Tab switches between the largest and the latest files, Enter opens the selected file's
+     * directory. Escape stops a running report, or goes back to the explorer.
+     * @param ch The input character.
+     */
+    void ReportView::handleInput(int ch) {
+        int count = _report->finished() ? static_cast<int>(_report->results().size()) : 0;
+        int last = std::max(0, count - 1);
+
+        switch (ch) {
+            case KEY_UP:
+                _selectedIndex = std::max(0, _selectedIndex - 1);
+                break;
+            case KEY_DOWN:
+                _selectedIndex = std::min(_selectedIndex + 1, last);
+                break;
+            case KEY_PPAGE:
+                _selectedIndex = std::max(0, _selectedIndex - _pageSize);
+                break;
+            case KEY_NPAGE:
+                _selectedIndex = std::min(_selectedIndex + _pageSize, last);
+                break;
+            case KEY_HOME:
+                _selectedIndex = 0;
+                break;
+            case KEY_END:
+                _selectedIndex = last;
+                break;
+            case '\n':
+            case KEY_ENTER:
+                pick();
+                break;
+            case '\t':
+                _ranking = _ranking == core::Ranking::LARGEST ? core::Ranking::RECENT : core::Ranking::LARGEST;
+                start();
+                break;
+            case 27: // Escape
+                if (!_report->finished()) {
+                    _report->cancel();
+                } else {
+                    _report.reset();
+                    _switchCallback(ViewType::EXPLORER);
+                }
+                break;
+            case 'q':
+                _report.reset();
+                _switchCallback(ViewType::EXPLORER);
+                break;
+        }
+    }
+
+    /**
+     * @brief Drops the current report, waiting for it to stop, and starts one for the ranking.
+     */
+    void ReportView::start() {
+        std::time_t since = _ranking == core::Ranking::RECENT ? std::time(nullptr) - RECENT_WINDOW : 0;
+
+        _report.reset();
+        _selectedIndex = 0;
+        _scrollOffset = 0;
+        _report = std::make_unique<core::FileReport>(_root, _ranking, core::FileReport::DEFAULT_LIMIT, since,
+                                                     _notifier);
+    }
+
+    /**
+     * @brief Hands the selected file over.
+     */
+    void ReportView::pick() {
+        if (!_report->finished() || _report->results().empty())
+            return;
+
+        std::string path = _root + "/" + _report->results()[_selectedIndex].path;
+        _report.reset();
+        _pickCallback(path);
+    }
+
+    std::string ReportView::status() const {
+        std::string text = std::to_string(_report->filesSeen()) + " fichiers examinés";
+
+        if (!_report->finished())
+            return text + (_report->cancelled() ? " (arrêt...)" : " (analyse...)");
+        if (_report->cancelled())
+            text += " (arrêté)";
+        if (_report->results().empty())
+            text += _ranking == core::Ranking::RECENT ? ", aucun modifié dans l'heure" : ", aucun fichier";
+        return text;
+    }
+
+    /**
+     * @brief Updates the ReportView.
+     * Describes the frame on the explorer canvas, which the view takes over while it is open.
+     * The list shows once the report is finished.
+     */
+    void ReportView::update() {
+        WindowCanvas& canvas = _manager.getCanvas(WindowRole::EXPLORER);
+
+        int max_y, max_x;
+        getmaxyx(canvas.window(), max_y, max_x);
+
+        int rows = std::max(1, max_y - 6);
+        _pageSize = rows;
+        if (_selectedIndex < _scrollOffset)
+            _scrollOffset = _selectedIndex;
+        else if (_selectedIndex >= _scrollOffset + rows)
+            _scrollOffset = _selectedIndex - rows + 1;
+
+        canvas.begin();
+        canvas.box();
+        canvas.text(0, 2, " Rapport ");
+
+        std::string title = _ranking == core::Ranking::LARGEST
+            ? "Les " + std::to_string(core::FileReport::DEFAULT_LIMIT) + " plus gros fichiers"
+            : "Modifiés dans la dernière heure";
+        canvas.text(1, 2, title + " sous " + _root);
+        canvas.text(2, 2, status(), COLOR_PAIR(5));
+
+        if (_report->finished()) {
+            const std::vector<core::RankedFile>& results = _report->results();
+            std::size_t first = static_cast<std::size_t>(_scrollOffset);
+            std::size_t last = std::min(results.size(), first + static_cast<std::size_t>(rows));
+            for (std::size_t i = first; i < last; ++i) {
+                const core::RankedFile& file = results[i];
+                bool selected = _selectedIndex == static_cast<int>(i);
+                attr_t attrs = COLOR_PAIR(2) | (selected ? A_REVERSE : A_NORMAL);
+
+                char when[32] = "";
+                std::time_t modified = file.modified;
+                if (std::tm* tm = std::localtime(&modified))
+                    std::strftime(when, sizeof(when), "%Y-%m-%d %H:%M", tm);
+                char prefix[64];
+                std::snprintf(prefix, sizeof(prefix), "%10s  %s  ", formatSize(file.size).c_str(), when);
+                canvas.text(3 + static_cast<int>(i - first), 2, (selected ? "> " : "  ") + std::string(prefix) + file.path,
+                            attrs);
+            }
+        }
+
+        canvas.text(max_y - 2, 2, "[Entrée] Aller  [Tab] Plus gros/Récents  [Échap] Arrêter/Retour");
+    }
+
+} // namespace ui
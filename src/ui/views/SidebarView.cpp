@@ -13,9 +13,7 @@ namespace ui {
         : _manager(manager), _onSwitch(std::move(onSwitch)) {}
 
     void SidebarView::update() {
-        _manager.clearWindow(static_cast<int>(WindowRole::SIDEBAR));
         drawMenu();
-        _manager.refreshAll();
     }
 
     void SidebarView::handleInput(int ch) {
@@ -37,17 +35,13 @@ namespace ui {
     }
 
     void SidebarView::drawMenu() {
-        WINDOW* win = _manager.getWindow(WindowRole::SIDEBAR);
-        box(win, 0, 0);
-        mvwprintw(win, 0, 2, " Menu ");
-
-        for (size_t i = 0; i < _options.size(); ++i) {
-            if (i == _selectedIndex)
-                wattron(win, A_REVERSE);
-            mvwprintw(win, 2 + i, 2, "%s", _options[i].c_str());
-            if (i == _selectedIndex)
-                wattroff(win, A_REVERSE);
-        }
+        WindowCanvas& canvas = _manager.getCanvas(WindowRole::SIDEBAR);
+        canvas.begin();
+        canvas.box();
+        canvas.text(0, 2, " Menu ");
+
+        for (size_t i = 0; i < _options.size(); ++i)
+            canvas.text(2 + i, 2, _options[i], i == _selectedIndex ? A_REVERSE : A_NORMAL);
     }
 
 } // namespace ui
@@ -0,0 +1,138 @@
+/**
+ * @file StatusBarView.cpp
+ * @brief Implementation of the ui::StatusBarView class
+ * @date 2025-06-29
+ */
+
+#include "ui/views/StatusBarView.hpp"
+#include <cstdio>
+#include <ncurses.h>
+
+namespace ui {
+
+    /** @brief Formats a size in binary units, one decimal past the kilobyte.
+     * @param size The size in bytes.
+     * @return The size, such as "12.3 Mo".
+     */
+    static std::string formatSize(std::uint64_t size) {
+        static const char* const units[] = { "Ko", "Mo", "Go", "To", "Po" };
+        char text[32];
+
+        if (size < 1024)
+            return std::to_string(size) + " o";
+        double value = static_cast<double>(size) / 1024;
+        std::size_t unit = 0;
+        for (; value >= 1024 && unit + 1 < std::size(units); ++unit)
+            value /= 1024;
+        std::snprintf(text, sizeof(text), "%.1f %s", value, units[unit]);
+        return text;
+    }
+
+    /** @brief Formats a duration as minutes and seconds, with the hours when there are any.
+     * @param seconds The duration in seconds.
+     * @return The duration, such as "1:05" or "2:00:30".
+     */
+    static std::string formatDuration(long long seconds) {
+        char text[32];
+
+        if (seconds >= 3600)
+            std::snprintf(text, sizeof(text), "%lld:%02lld:%02lld", seconds / 3600, seconds / 60 % 60, seconds % 60);
+        else
+            std::snprintf(text, sizeof(text), "%lld:%02lld", seconds / 60, seconds % 60);
+        return text;
+    }
+
+    /**
+     * @brief Constructor for the StatusBarView class.
+     * @param manager The NcursesManager instance to manage the UI.
+     * @param jobs The queue whose jobs are shown.
+     */
+    StatusBarView::StatusBarView(NcursesManager& manager, core::JobQueue& jobs)
+        : _manager(manager), _jobs(jobs) {}
+
+    void StatusBarView::handleInput(int /*ch*/) {}
+
+    /**
+     * @brief Describes how far a running job is, such as "45%  1.2 Go/2.7 Go  80.0 Mo/s  reste 0:12".
+     */
+    std::string StatusBarView::describeRunning(const core::Job& job) const {
+        if (job.state() == core::Job::State::QUEUED)
+            return "en attente";
+
+        core::JobProgress progress = job.progress();
+        std::string text;
+        long long elapsed = std::chrono::duration_cast<std::chrono::seconds>(progress.elapsed).count();
+
+        if (progress.bytesTotal == 0 && progress.filesTotal == 0) {
+            // Nothing to measure against: the job is being sized, or cannot tell
+            text = formatDuration(elapsed);
+        } else {
+            text = std::to_string(static_cast<int>(progress.fraction() * 100)) + "%  ";
+            if (progress.bytesTotal > 0)
+                text += formatSize(progress.bytesDone) + "/" + formatSize(progress.bytesTotal) + "  "
+                      + formatSize(static_cast<std::uint64_t>(progress.throughput())) + "/s";
+            else
+                text += std::to_string(progress.filesDone) + "/" + std::to_string(progress.filesTotal) + " éléments";
+            if (progress.remaining().count() > 0)
+                text += "  reste " + formatDuration(progress.remaining().count());
+        }
+        if (job.paused())
+            text += "  en pause";
+        else if (job.cancelled())
+            text += "  arrêt...";
+        return text;
+    }
+
+    /**
+     * @brief Describes how a job ended, with what it has to say about it.
+     */
+    std::string StatusBarView::describeFinished(const core::Job& job) const {
+        std::string text = job.description();
+
+        switch (job.state()) {
+            case core::Job::State::FAILED:
+                return text + ": échec, " + job.error();
+            case core::Job::State::CANCELLED:
+                return text + ": annulé";
+            default:
+                break;
+        }
+        text += ": terminé";
+        std::string summary = job.summary();
+        if (!summary.empty())
+            text += ", " + summary;
+        return text;
+    }
+
+    /**
+     * @brief Updates the StatusBarView.
+     * Describes the frame on the status canvas, whatever view is current.
+     */
+    void StatusBarView::update() {
+        WindowCanvas& canvas = _manager.getCanvas(WindowRole::STATUS);
+
+        canvas.begin();
+        canvas.box();
+
+        // The running job names the window, so that its progress has the row to itself
+        if (std::shared_ptr<core::Job> job = _jobs.current()) {
+            std::string title = " " + job->description();
+            std::size_t waiting = _jobs.queued();
+            // The first queued job is the one shown when none runs yet
+            if (job->state() == core::Job::State::QUEUED && waiting > 0)
+                --waiting;
+            if (waiting > 0)
+                title += " (+" + std::to_string(waiting) + " en attente)";
+            canvas.text(0, 2, title + " ");
+            canvas.text(1, 2, describeRunning(*job), COLOR_PAIR(5));
+        } else if (std::shared_ptr<core::Job> last = _jobs.lastFinished()) {
+            canvas.text(0, 2, " Tâches ");
+            canvas.text(1, 2, describeFinished(*last),
+                        last->state() == core::Job::State::DONE ? COLOR_PAIR(3) : COLOR_PAIR(7));
+        } else {
+            canvas.text(0, 2, " Tâches ");
+            canvas.text(1, 2, "Aucune tâche");
+        }
+    }
+
+} // namespace ui
@@ -0,0 +1,367 @@
+/**
+ * @file UsageView.cpp
+ * @brief Implementation of the ui::UsageView class
+ * @date 2025-06-27
+ */
+
+#include "ui/views/UsageView.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <ncurses.h>
+
+namespace ui {
+
+    /** @brief Formats a size in binary units, one decimal past the kilobyte.
+     * @param size The size in bytes.
+     * @return The size, such as "12.3 Mo".
+     */
+    static std::string formatSize(std::uint64_t size) {
+        static const char* const units[] = { "Ko", "Mo", "Go", "To", "Po" };
+        char text[32];
+
+        if (size < 1024)
+            return std::to_string(size) + " o";
+        double value = static_cast<double>(size) / 1024;
+        std::size_t unit = 0;
+        for (; value >= 1024 && unit + 1 < std::size(units); ++unit)
+            value /= 1024;
+        std::snprintf(text, sizeof(text), "%.1f %s", value, units[unit]);
+        return text;
+    }
+
+    /**
+     * @brief Constructor for the UsageView class. The walk of root starts right away.
+     * @param manager The NcursesManager instance to manage the UI.
+     * @param root The directory to size.
+     * @param usageCache The totals of the directories sized before, filled in by the walks of this view.
+     * @param notifier Signalled by the walk as its totals grow.
+     * @param switchCallback The callback function to switch views.
+     */
+    UsageView::UsageView(NcursesManager& manager, const std::string& root, core::UsageCache& usageCache,
+                         core::EventNotifier* notifier, std::function<void(ViewType)> switchCallback)
+        : _manager(manager), _root(root), _usageCache(usageCache), _notifier(notifier),
+          _scanTarget(core::UsageTree::npos), _readOnly(false), _current(core::UsageTree::ROOT), _confirming(false),
+          _selectedIndex(0), _scrollOffset(0), _pageSize(1), _switchCallback(switchCallback)
+    {
+        startScan(core::UsageTree::npos);
+    }
+
+    /**
+     * @brief Handles user input for the UsageView.
+     * Enter or Right opens the selected directory, Left or Backspace goes back up. x deletes the
+     * selected entry once confirmed, r walks the shown directory again, e saves the tree and l
+     * loads a saved one. Escape stops a running walk, or goes back to the explorer.
+     * @param ch The input character.
+     */
+    void UsageView::handleInput(int ch) {
+        int last = std::max(0, static_cast<int>(_listing.size()) - 1);
+
+        if (_confirming) {
+            _confirming = false;
+            _message.clear();
+            if (ch == 'o' || ch == 'O' || ch == 'y' || ch == 'Y')
+                deleteSelected();
+            return;
+        }
+
+        switch (ch) {
+            case KEY_UP:
+                _selectedIndex = std::max(0, _selectedIndex - 1);
+                break;
+            case KEY_DOWN:
+                _selectedIndex = std::min(_selectedIndex + 1, last);
+                break;
+            case KEY_PPAGE:
+                _selectedIndex = std::max(0, _selectedIndex - _pageSize);
+                break;
+            case KEY_NPAGE:
+                _selectedIndex = std::min(_selectedIndex + _pageSize, last);
+                break;
+            case KEY_HOME:
+                _selectedIndex = 0;
+                break;
+            case KEY_END:
+                _selectedIndex = last;
+                break;
+            case '\n':
+            case KEY_ENTER:
+            case KEY_RIGHT:
+                enterSelected();
+                break;
+            case KEY_LEFT:
+            case KEY_BACKSPACE:
+            case 127:
+            case '\b':
+                goUp();
+                break;
+            case 'x':
+                if (!_tree || _listing.empty() || _scan)
+                    break;
+                if (_readOnly) {
+                    _message = "Analyse chargée: lecture seule";
+                    break;
+                }
+                _confirming = true;
+                _message = "Supprimer " + std::string(_tree->name(_listing[_selectedIndex])) + " ? [o/n]";
+                break;
+            case 'r':
+                if (_tree && !_readOnly && !_scan)
+                    startScan(_current);
+                break;
+            case 'e':
+                exportTree();
+                break;
+            case 'l':
+                loadTree();
+                break;
+            case 27: // Escape
+                if (_scan) {
+                    _scan.reset();
+                    _message = "Analyse arrêtée";
+                } else {
+                    _switchCallback(ViewType::EXPLORER);
+                }
+                break;
+            case 'q':
+                _scan.reset();
+                _switchCallback(ViewType::EXPLORER);
+                break;
+        }
+    }
+
+    /**
+     * @brief Starts walking a directory of the tree, or the whole root.
+     * @param directory The directory to walk again, or npos to size the root from scratch.
+     */
+    void UsageView::startScan(Index directory) {
+        std::string path = directory == core::UsageTree::npos ? _root : _tree->path(directory);
+
+        _scanTarget = directory;
+        _message.clear();
+        _scan = std::make_unique<core::DiskUsage>(path, &_usageCache, _notifier, true);
+    }
+
+    /**
+     * @brief Takes the result of a finished walk: a new tree, or a new subtree for the
+     * directory walked again.
+     */
+    void UsageView::finishScan() {
+        if (_scan->cancelled()) {
+            _scan.reset();
+            return;
+        }
+
+        if (_scanTarget == core::UsageTree::npos) {
+            _tree = std::make_unique<core::UsageTree>(*_scan);
+            _readOnly = false;
+            _scan.reset();
+            open(core::UsageTree::ROOT);
+        } else {
+            // The subtree is replaced, entries with it: the cursor follows the selected name
+            std::string selected = _listing.empty() ? "" : std::string(_tree->name(_listing[_selectedIndex]));
+            _tree->graft(_scanTarget, core::UsageTree(*_scan));
+            _scan.reset();
+            open(_current);
+            for (std::size_t i = 0; i < _listing.size(); ++i)
+                if (_tree->name(_listing[i]) == selected)
+                    _selectedIndex = static_cast<int>(i);
+        }
+    }
+
+    /**
+     * @brief Lists a directory of the tree.
+     * @param directory The directory to show.
+     * @param select The entry to put the cursor on, if it is still listed.
+     */
+    void UsageView::open(Index directory, Index select) {
+        _current = directory;
+        _listing = _tree->children(directory);
+        _selectedIndex = 0;
+        _scrollOffset = 0;
+
+        auto found = std::find(_listing.begin(), _listing.end(), select);
+        if (found != _listing.end())
+            _selectedIndex = static_cast<int>(found - _listing.begin());
+    }
+
+    void UsageView::enterSelected() {
+        if (!_tree || _listing.empty() || _scan)
+            return;
+
+        Index selected = _listing[_selectedIndex];
+        if (_tree->isDirectory(selected))
+            open(selected);
+    }
+
+    void UsageView::goUp() {
+        if (!_tree || _scan || _current == core::UsageTree::ROOT)
+            return;
+        open(_tree->entry(_current).parent, _current);
+    }
+
+    /**
+     * @brief Deletes the selected entry from the disk and takes it out of the tree, with no
+     * new walk.
+     */
+    void UsageView::deleteSelected() {
+        if (!_tree || _listing.empty())
+            return;
+
+        Index selected = _listing[_selectedIndex];
+        std::error_code error;
+        std::filesystem::remove_all(_tree->path(selected), error);
+        if (error) {
+            _message = "Erreur: suppression échouée";
+            return;
+        }
+
+        _tree->remove(selected);
+        int position = _selectedIndex;
+        open(_current);
+        _selectedIndex = std::min(position, std::max(0, static_cast<int>(_listing.size()) - 1));
+    }
+
+    /**
+     * @brief Saves the tree to a file named at the prompt.
+     */
+    void UsageView::exportTree() {
+        if (!_tree || _scan)
+            return;
+
+        std::string path = prompt("Enregistrer sous (" + std::string(DEFAULT_FILE) + "): ");
+        if (path.empty())
+            path = DEFAULT_FILE;
+        _message = _tree->save(path) ? "Analyse enregistrée dans " + path : "Erreur: enregistrement échoué";
+    }
+
+    /**
+     * @brief Replaces the tree with one saved to a file named at the prompt.
+     */
+    void UsageView::loadTree() {
+        if (_scan)
+            return;
+
+        std::string path = prompt("Charger (" + std::string(DEFAULT_FILE) + "): ");
+        if (path.empty())
+            path = DEFAULT_FILE;
+
+        std::unique_ptr<core::UsageTree> tree = core::UsageTree::load(path);
+        if (!tree) {
+            _message = "Erreur: " + path + " n'est pas une analyse valide";
+            return;
+        }
+        _tree = std::move(tree);
+        _readOnly = true;
+        _message = "Analyse chargée depuis " + path;
+        open(core::UsageTree::ROOT);
+    }
+
+    /**
+     * @brief Asks for a line of text at the bottom of the screen.
+     * @param label The question.
+     * @return The text typed.
+     */
+    std::string UsageView::prompt(const std::string& label) {
+        NcursesWrapper& wrapper = _manager.getWrapper();
+        int max_y, max_x;
+        getmaxyx(stdscr, max_y, max_x);
+        WINDOW* inputWin = wrapper.createWindow(3, std::min(max_x, 80), max_y - 3, 0);
+        box(inputWin, 0, 0);
+        wrapper.drawTextInWindow(inputWin, 1, 2, label);
+        wrapper.refreshWindow(inputWin);
+
+        char text[256];
+        echo(); wgetnstr(inputWin, text, 255); noecho();
+        wrapper.destroyWindow(inputWin);
+        _manager.touchAll();
+        return text;
+    }
+
+    std::string UsageView::status() const {
+        if (!_message.empty())
+            return _message;
+        if (!_scan)
+            return _readOnly ? "Analyse chargée (lecture seule)" : "";
+
+        core::UsageTotals totals = _scan->progress();
+        std::string text = "Analyse: " + std::to_string(totals.files) + " fichiers, "
+            + std::to_string(totals.directories) + " dossiers, " + formatSize(totals.bytes);
+        if (std::size_t errors = _scan->errors(); errors > 0)
+            text += ", " + std::to_string(errors) + " illisibles";
+        return text + "...";
+    }
+
+    /**
+     * @brief One row of the listing: size, share of the shown directory, and name.
+     */
+    std::string UsageView::describe(Index index) const {
+        const core::UsageTree::Entry& entry = _tree->entry(index);
+        std::uint64_t total = _tree->entry(_current).bytes;
+        double share = total > 0 ? static_cast<double>(entry.bytes) / static_cast<double>(total) : 0.0;
+        int filled = std::clamp(static_cast<int>(share * BAR_WIDTH + 0.5), 0, BAR_WIDTH);
+
+        char prefix[64];
+        std::snprintf(prefix, sizeof(prefix), "%10s [%-*s] %5.1f%% ", formatSize(entry.bytes).c_str(),
+                      BAR_WIDTH, std::string(static_cast<std::size_t>(filled), '#').c_str(), share * 100);
+
+        std::string row = prefix;
+        if (entry.flags & core::UsageTree::UNREADABLE)
+            row += "! ";
+        else if (entry.flags & core::UsageTree::DUPLICATE)
+            row += "H ";
+        row += _tree->name(index);
+        if (entry.flags & core::UsageTree::DIRECTORY)
+            row += "/";
+        return row;
+    }
+
+    /**
+     * @brief Updates the UsageView.
+     * Takes the result of a walk that just finished and describes the frame on the explorer
+     * canvas, which the view takes over while it is open.
+     */
+    void UsageView::update() {
+        if (_scan && _scan->finished())
+            finishScan();
+
+        WindowCanvas& canvas = _manager.getCanvas(WindowRole::EXPLORER);
+
+        int max_y, max_x;
+        getmaxyx(canvas.window(), max_y, max_x);
+
+        int rows = std::max(1, max_y - 6);
+        _pageSize = rows;
+        if (_selectedIndex < _scrollOffset)
+            _scrollOffset = _selectedIndex;
+        else if (_selectedIndex >= _scrollOffset + rows)
+            _scrollOffset = _selectedIndex - rows + 1;
+
+        canvas.begin();
+        canvas.box();
+        canvas.text(0, 2, " Espace disque ");
+
+        if (_tree) {
+            const core::UsageTree::Entry& current = _tree->entry(_current);
+            canvas.text(1, 2, _tree->path(_current) + "  " + formatSize(current.bytes) + " ("
+                + formatSize(current.allocated) + " sur disque, " + std::to_string(current.items) + " éléments)");
+        } else {
+            canvas.text(1, 2, _root);
+        }
+        canvas.text(2, 2, status(), COLOR_PAIR(5));
+
+        std::size_t first = static_cast<std::size_t>(_scrollOffset);
+        std::size_t last = std::min(_listing.size(), first + static_cast<std::size_t>(rows));
+        for (std::size_t i = first; _tree && i < last; ++i) {
+            Index index = _listing[i];
+            bool selected = _selectedIndex == static_cast<int>(i);
+            int color = _tree->isDirectory(index) ? COLOR_PAIR(1) : COLOR_PAIR(2);
+            attr_t attrs = color | (selected ? A_REVERSE : A_NORMAL);
+            canvas.text(3 + static_cast<int>(i - first), 2, (selected ? "> " : "  ") + describe(index), attrs);
+        }
+
+        canvas.text(max_y - 3, 2, "[Entrée/←] Naviguer  [x] Supprimer  [r] Réanalyser");
+        canvas.text(max_y - 2, 2, "[e] Enregistrer  [l] Charger  [q] Retour");
+    }
+
+} // namespace ui